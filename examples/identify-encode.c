@@ -1,413 +1,144 @@
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "cbor.h"
 #include "debug.h"
+#include "struct.h"
 
 #include "identify.h"
 
 uint8_t buf[512] = {0};
 
-custom_encoder_result_t encode_device_info(slice_t target, void* arg) {
-
-    device_info_t* device = (device_info_t*)arg;
-
-    cbor_value_t value = {
-        .type = CBOR_ENCODE_TYPE_PAIRS,
-        .value.pairs = PAIRS((
-            (cbor_pair_t[]){
-                {
-                    {
-                        .type = CBOR_TYPE_TEXT_STRING,
-                        .value.bytes = STR2SLICE("f"),
-                    },
-                    {
-                        .type = CBOR_TYPE_TEXT_STRING,
-                        .value.bytes = device->f,
-                    },
-                },
-                {
-                    {
-                        .type = CBOR_TYPE_TEXT_STRING,
-                        .value.bytes = STR2SLICE("sn"),
-                    },
-                    {
-                        .type = CBOR_TYPE_TEXT_STRING,
-                        .value.bytes = device->sn,
-                    },
-                },
-            }
-        ))
-    };
-
-    cbor_encode_result_t encoded = cbor_encode(value, target);
-
-    if (encoded.is_error) {
-        return ERR(custom_encoder_result_t, encoded.err);
-    }
-
-    return OK(custom_encoder_result_t, encoded.ok);
-}
-
-custom_encoder_result_t encode_communication_interfaces(slice_t target, void* arg) {
-    (void)arg; // Suppress unused parameter warning
-    // Stub: encode empty array
-    cbor_value_t value = {
-        .type = CBOR_ENCODE_TYPE_VALUES,
-        .value.values = {.len = 0, .ptr = NULL}
-    };
-
-    cbor_encode_result_t encoded = cbor_encode(value, target);
-
-    if (encoded.is_error) {
-        return ERR(custom_encoder_result_t, encoded.err);
-    }
-
-    return OK(custom_encoder_result_t, encoded.ok);
-}
-
-custom_encoder_result_t encode_serial_ports(slice_t target, void* arg) {
-    (void)arg; // Suppress unused parameter warning
-    // Stub: encode empty array
-    cbor_value_t value = {
-        .type = CBOR_ENCODE_TYPE_VALUES,
-        .value.values = {.len = 0, .ptr = NULL}
-    };
+// Values reported for the identify parameters, one member per IDENTIFY_PARAMETERS entry
+typedef struct {
+    bool rg;
+    slice_t b;
+    slice_t m;
+    int32_t t;
+    slice_t pv;
+    slice_t md;
+    slice_t fw;
+    int32_t sg;
+    int32_t hbp;
+    int64_t dd;
+    int32_t rp;
+    int32_t rds;
+    int32_t rti;
+    int32_t rtc;
+    int32_t mps;
+    slice_t cif;
+    slice_t sps;
+    slice_t ioi;
+    slice_t mes;
+} identify_response_t;
+
+#define IDENTIFY_KIND_REGISTERED              CBOR_FIELD_BOOL
+#define IDENTIFY_KIND_BRAND                   CBOR_FIELD_TEXT
+#define IDENTIFY_KIND_MODEL                   CBOR_FIELD_TEXT
+#define IDENTIFY_KIND_TYPE                    CBOR_FIELD_INT
+#define IDENTIFY_KIND_PROTOCOLVERSION         CBOR_FIELD_TEXT
+#define IDENTIFY_KIND_MANUFACTUREDATE         CBOR_FIELD_TEXT
+#define IDENTIFY_KIND_FIRMWARE                CBOR_FIELD_TEXT
+#define IDENTIFY_KIND_SIGNAL                  CBOR_FIELD_INT
+#define IDENTIFY_KIND_HEARTBEATPERIOD         CBOR_FIELD_INT
+#define IDENTIFY_KIND_DEVICEDATE              CBOR_FIELD_INT
+#define IDENTIFY_KIND_RESTARTPERIOD           CBOR_FIELD_INT
+#define IDENTIFY_KIND_READDATALIFESPAN        CBOR_FIELD_INT
+#define IDENTIFY_KIND_RETRYINTERVAL           CBOR_FIELD_INT
+#define IDENTIFY_KIND_RETRYCOUNT              CBOR_FIELD_INT
+#define IDENTIFY_KIND_MAXPACKAGESIZE          CBOR_FIELD_INT
+#define IDENTIFY_KIND_COMMUNICATIONINTERFACES CBOR_FIELD_ITEM
+#define IDENTIFY_KIND_SERIALPORTS             CBOR_FIELD_ITEM
+#define IDENTIFY_KIND_IOINTERFACES            CBOR_FIELD_ITEM
+#define IDENTIFY_KIND_METERS                  CBOR_FIELD_ITEM
+
+// Field i is IDENTIFY_SHIFT_i, so a request bitmap is also the field mask
+static const cbor_field_t identify_response_fields[] = {
+    #define X(name, key) CBOR_FIELD(identify_response_t, name, IDENTIFY_KIND_ ## key, 0),
+    IDENTIFY_PARAMETERS
+    #undef X
+};
+static const cbor_struct_schema_t identify_response_schema = CBOR_STRUCT_SCHEMA(identify_response_fields);
+_Static_assert(sizeof(identify_response_fields) / sizeof(identify_response_fields[0]) == IDENTIFY_PARAMETERS_COUNT,
+    "identify_response_t out of sync with IDENTIFY_PARAMETERS");
+
+// Stub: interfaces, ports and meters are reported as empty arrays
+static uint8_t empty_array[] = {0x80};
+
+// STR2SLICE without the compound literal, for static initializers
+#define TEXT(str) {.len = sizeof(str) - 1, .ptr = (uint8_t*)(str)}
+
+static const identify_response_t identify_response = {
+    .rg = true,
+    .b = TEXT("ExampleBrand"),
+    .m = TEXT("ExampleModel"),
+    .t = 0,
+    .pv = TEXT("1.0.0"),
+    .md = TEXT("2023-05-23"),
+    .fw = TEXT("1.01"),
+    .sg = 13,
+    .hbp = 10,
+    .dd = 1672531200, // Unix timestamp example
+    .rp = 8,
+    .rds = 24,
+    .rti = 10,
+    .rtc = 3,
+    .mps = 65536,
+    .cif = {.len = sizeof(empty_array), .ptr = empty_array},
+    .sps = {.len = sizeof(empty_array), .ptr = empty_array},
+    .ioi = {.len = sizeof(empty_array), .ptr = empty_array},
+    .mes = {.len = sizeof(empty_array), .ptr = empty_array},
+};
+
+static const cbor_field_t device_info_fields[] = {
+    CBOR_FIELD(device_info_t, f, CBOR_FIELD_TEXT, 0),
+    CBOR_FIELD(device_info_t, sn, CBOR_FIELD_TEXT, 0),
+};
+static const cbor_struct_schema_t device_info_schema = CBOR_STRUCT_SCHEMA(device_info_fields);
+
+static const cbor_field_t identification_request_fields[] = {
+    CBOR_FIELD_MAP("d", identification_request_t, d, device_info_schema, 0),
+    CBOR_FIELD(identification_request_t, fn, CBOR_FIELD_INT, 0),
+    CBOR_FIELD(identification_request_t, rid, CBOR_FIELD_INT, 0),
+};
+static const cbor_struct_schema_t identification_request_schema = CBOR_STRUCT_SCHEMA(identification_request_fields);
 
-    cbor_encode_result_t encoded = cbor_encode(value, target);
+custom_encoder_result_t encode_identification_request(slice_t target, void* arg) {
+    identification_request_t* req = (identification_request_t*)arg;
+    slice_t current = target;
 
-    if (encoded.is_error) {
-        return ERR(custom_encoder_result_t, encoded.err);
+    // d, fn and rid from the table, then "r" with the requested parameters
+    if (current.len < 1) {
+        return ERR(custom_encoder_result_t, CBOR_ENCODER_ERROR_BUFFER_OVERFLOW);
     }
+    uint8_t header_size = cbor_write_len_header(4, CBOR_MAJOR_TYPE_MAP, current);
+    current.ptr += header_size;
+    current.len -= header_size;
 
-    return OK(custom_encoder_result_t, encoded.ok);
-}
-
-custom_encoder_result_t encode_io_interfaces(slice_t target, void* arg) {
-    (void)arg; // Suppress unused parameter warning
-    // Stub: encode empty array
-    cbor_value_t value = {
-        .type = CBOR_ENCODE_TYPE_VALUES,
-        .value.values = {.len = 0, .ptr = NULL}
-    };
-
-    cbor_encode_result_t encoded = cbor_encode(value, target);
-
+    cbor_encode_result_t encoded = cbor_encode_struct_pairs(&identification_request_schema, req, CBOR_STRUCT_ALL_FIELDS, current);
     if (encoded.is_error) {
         return ERR(custom_encoder_result_t, encoded.err);
     }
+    current.ptr += encoded.ok.len;
+    current.len -= encoded.ok.len;
 
-    return OK(custom_encoder_result_t, encoded.ok);
-}
-
-custom_encoder_result_t encode_meters(slice_t target, void* arg) {
-    (void)arg; // Suppress unused parameter warning
-    // Stub: encode empty array
-    cbor_value_t value = {
-        .type = CBOR_ENCODE_TYPE_VALUES,
-        .value.values = {.len = 0, .ptr = NULL}
-    };
-
-    cbor_encode_result_t encoded = cbor_encode(value, target);
-
+    encoded = cbor_encode_string(STR2SLICE("r"), CBOR_TYPE_TEXT_STRING, current);
     if (encoded.is_error) {
         return ERR(custom_encoder_result_t, encoded.err);
     }
+    current.ptr += encoded.ok.len;
+    current.len -= encoded.ok.len;
 
-    return OK(custom_encoder_result_t, encoded.ok);
-}
-
-custom_encoder_result_t encode_identify_bitmap(slice_t target, void* arg) {
-    identify_bitmap_t* bitmap = (identify_bitmap_t*)arg;
-    slice_t current = target;
-
-    // Count number of set bits
-    size_t count = 0;
-    #define X(name, key) if (*bitmap & (IDENTIFY_MASK_ ## key)) count++;
-    IDENTIFY_PARAMETERS
-    #undef X
-
-    uint8_t header_size = cbor_write_len_header(count, CBOR_MAJOR_TYPE_MAP, target);
-    size_t full_length = header_size;
-    current.ptr += header_size;
-    current.len -= header_size;
-
-    cbor_encode_result_t encoded;
-    size_t encoded_count = 0; // Track how many pairs we've actually encoded
-    for (enum identify_response_shifts i = 0; i < IDENTIFY_PARAMETERS_COUNT; i++) {
-        if (*bitmap & 1) {
-            switch (i)
-            {
-                case IDENTIFY_SHIFT_REGISTERED:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_REGISTERED),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_SIMPLE,
-                            .value.simple = CBOR_SIMPLE_TRUE,
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_BRAND:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_BRAND),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE("ExampleBrand"),
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_MODEL:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_MODEL),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE("ExampleModel"),
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_TYPE:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_TYPE),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_INTEGER,
-                            .value.integer = 0,
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_PROTOCOLVERSION:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_PROTOCOLVERSION),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE("1.0.0"),
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_MANUFACTUREDATE:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_MANUFACTUREDATE),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE("2023-05-23"),
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_FIRMWARE:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_FIRMWARE),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE("1.01"),
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_SIGNAL:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_SIGNAL),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_INTEGER,
-                            .value.integer = 13,
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_HEARTBEATPERIOD:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_HEARTBEATPERIOD),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_INTEGER,
-                            .value.integer = 10,
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_DEVICEDATE:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_DEVICEDATE),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_INTEGER,
-                            .value.integer = 1672531200, // Unix timestamp example
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_RESTARTPERIOD:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_RESTARTPERIOD),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_INTEGER,
-                            .value.integer = 8,
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_READDATALIFESPAN:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_READDATALIFESPAN),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_INTEGER,
-                            .value.integer = 24,
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_RETRYINTERVAL:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_RETRYINTERVAL),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_INTEGER,
-                            .value.integer = 10,
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_RETRYCOUNT:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_RETRYCOUNT),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_INTEGER,
-                            .value.integer = 3,
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_MAXPACKAGESIZE:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_MAXPACKAGESIZE),
-                        }, (cbor_value_t){
-                            .type = CBOR_TYPE_INTEGER,
-                            .value.integer = 65536,
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_COMMUNICATIONINTERFACES:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_COMMUNICATIONINTERFACES),
-                        }, (cbor_value_t){
-                            .type = CBOR_ENCODE_TYPE_CUSTOM_ENCODER,
-                            .value.custom_encoder = {
-                                .encoder = encode_communication_interfaces,
-                                .argument = NULL
-                            }
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_SERIALPORTS:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_SERIALPORTS),
-                        }, (cbor_value_t){
-                            .type = CBOR_ENCODE_TYPE_CUSTOM_ENCODER,
-                            .value.custom_encoder = {
-                                .encoder = encode_serial_ports,
-                                .argument = NULL
-                            }
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_IOINTERFACES:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_IOINTERFACES),
-                        }, (cbor_value_t){
-                            .type = CBOR_ENCODE_TYPE_CUSTOM_ENCODER,
-                            .value.custom_encoder = {
-                                .encoder = encode_io_interfaces,
-                                .argument = NULL
-                            }
-                        }, current);
-                    break;
-                case IDENTIFY_SHIFT_METERS:
-                    encoded = cbor_encode_pair((cbor_value_t){
-                            .type = CBOR_TYPE_TEXT_STRING,
-                            .value.bytes = STR2SLICE(CBOR_KEY_METERS),
-                        }, (cbor_value_t){
-                            .type = CBOR_ENCODE_TYPE_CUSTOM_ENCODER,
-                            .value.custom_encoder = {
-                                .encoder = encode_meters,
-                                .argument = NULL
-                            }
-                        }, current);
-                    break;
-                default:
-                    return ERR(custom_encoder_result_t, CBOR_ENCODER_TODO);
-            }
-            if (encoded.is_error) {
-                return ERR(custom_encoder_result_t, encoded.err);
-            }
-            current.ptr += encoded.ok.len;
-            current.len -= encoded.ok.len;
-            full_length += encoded.ok.len;
-            encoded_count++;
-            
-            // Early exit optimization: if we've encoded all expected pairs, we're done
-            if (encoded_count == count) {
-                break;
-            }
-        }
-        *bitmap >>= 1;
-    }
-
-    return OK(custom_encoder_result_t, ((slice_t){ .len = full_length, .ptr = target.ptr }));
-}
-
-custom_encoder_result_t encode_identification_request(slice_t target, void* arg) {
-    identification_request_t* req = (identification_request_t*)arg;
-    cbor_value_t  value = (cbor_value_t){
-        .type = CBOR_ENCODE_TYPE_PAIRS,
-        .value.pairs = PAIRS((
-            (cbor_pair_t[]){
-                {
-                    {
-                        .type = CBOR_TYPE_TEXT_STRING,
-                        .value.bytes = STR2SLICE("d"),
-                    },
-                    {
-                        .type = CBOR_ENCODE_TYPE_CUSTOM_ENCODER,
-                        .value.custom_encoder = {
-                            .encoder = encode_device_info,
-                            .argument = &req->d
-                        }
-                    }
-                },
-                {
-                    {
-                        .type = CBOR_TYPE_TEXT_STRING,
-                        .value.bytes = STR2SLICE("fn"),
-                    },
-                    {
-                        .type = CBOR_TYPE_INTEGER,
-                        .value.integer = req->fn,
-                    },
-                },
-                {
-                    {
-                        .type = CBOR_TYPE_TEXT_STRING,
-                        .value.bytes = STR2SLICE("rid"),
-                    },
-                    {
-                        .type = CBOR_TYPE_INTEGER,
-                        .value.integer = req->rid,
-                    },
-                },
-                {
-                    {
-                        .type = CBOR_TYPE_TEXT_STRING,
-                        .value.bytes = STR2SLICE("r"),
-                    },
-                    {
-                        .type = CBOR_ENCODE_TYPE_CUSTOM_ENCODER,
-                        .value.custom_encoder = {
-                            .encoder = encode_identify_bitmap,
-                            .argument = &req->request_bitmap
-                        }
-                    }
-                }
-            }
-        ))
-    };
-
-    cbor_encode_result_t encoded = cbor_encode(value, target);
-
+    encoded = cbor_encode_struct(&identify_response_schema, &identify_response, req->request_bitmap, current);
     if (encoded.is_error) {
         return ERR(custom_encoder_result_t, encoded.err);
     }
+    current.ptr += encoded.ok.len;
 
-    return OK(custom_encoder_result_t, encoded.ok);
+    return OK(custom_encoder_result_t, ((slice_t){ .len = (size_t)(current.ptr - target.ptr), .ptr = target.ptr }));
 }
 
 
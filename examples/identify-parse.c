@@ -6,6 +6,8 @@
 #include "cbor.h"
 #include "debug.h"
 
+#include "struct.h"
+
 #include "identify.h"
 
 uint8_t buf[] = {
@@ -34,101 +36,35 @@ uint8_t buf[] = {
     //         0x61, 'm'
 };
 
-cbor_custom_processor_result_t process_device_info(const cbor_value_t *key, const cbor_value_t *value, void *arg) {
-    device_info_t* device = arg;
-
-    if (key->type != CBOR_TYPE_TEXT_STRING) {
-        printf("Warning: Skipping non string key!\n");
-        return CBOR_CUSTOM_PROCESSOR_OK();
-    }
-    char keystr[key->value.bytes.len + 1];
-    memcpy(keystr, key->value.bytes.ptr, key->value.bytes.len);
-    keystr[key->value.bytes.len] = 0;
-
-    if (!strcmp(keystr, "f")) {
-        device->f = value->value.bytes;
-    }
-    if (!strcmp(keystr, "sn")) {
-        device->sn = value->value.bytes;
-    }
-    return CBOR_CUSTOM_PROCESSOR_OK();
-}
-
-
-cbor_custom_processor_result_t process_identify_parameters(const cbor_value_t *element, void *process_arg) {
-    identify_bitmap_t* bitmap = process_arg;
-
-    if (element->type != CBOR_TYPE_TEXT_STRING) {
-        printf("Warning: Skipping non string parameter!\n");
-        return CBOR_CUSTOM_PROCESSOR_OK();
-    }
-    char keystr[element->value.bytes.len + 1];
-    memcpy(keystr, element->value.bytes.ptr, element->value.bytes.len);
-    keystr[element->value.bytes.len] = 0;
-
-    if (0);
-    #define X(name, key) else if (!strcmp(keystr, CBOR_KEY_ ## key)) { \
-    printf("%s\n", keystr); *bitmap |= IDENTIFY_MASK_ ## key; }
-    IDENTIFY_PARAMETERS
-    #undef X
-    else {
-        printf("Unknown key: \"%s\"\n", keystr);
-    }
-    return CBOR_CUSTOM_PROCESSOR_OK();
-}
+// Field tables for the request, decoded by cbor_decode_struct
+#define DEVICE_INFO_FIELDS          \
+  X(f, CBOR_FIELD_TEXT)             \
+  X(sn, CBOR_FIELD_TEXT)
 
-cbor_custom_processor_result_t process_identify_parameters_container(const cbor_value_t *key, const cbor_value_t *value, void *arg) {
-    identify_bitmap_t* bitmap = arg;
-
-    if (key->type != CBOR_TYPE_TEXT_STRING) {
-        printf("Warning: Skipping non string key!\n");
-        return CBOR_CUSTOM_PROCESSOR_OK();
-    }
-    char keystr[key->value.bytes.len + 1];
-    memcpy(keystr, key->value.bytes.ptr, key->value.bytes.len);
-    keystr[key->value.bytes.len] = 0;
-
-    if (!strcmp(keystr, "parameters")) {
-        memset(bitmap, 0, sizeof(identify_bitmap_t));
-        cbor_process_result_t result = cbor_process_array(value->value.array, process_identify_parameters, bitmap);
-        if (result.is_error) {
-            printf("Error processing parameters array: %d\n", result.err);
-        }
-    }
-    return CBOR_CUSTOM_PROCESSOR_OK();
-}
-
-cbor_custom_processor_result_t process_identification_request(const cbor_value_t *key, const cbor_value_t *value, void *arg) {
-    identification_request_t* request = arg;
+static const cbor_field_t device_info_fields[] = {
+  #define X(name, kind) CBOR_FIELD(device_info_t, name, kind, CBOR_FIELD_REQUIRED),
+  DEVICE_INFO_FIELDS
+  #undef X
+};
+static const cbor_struct_schema_t device_info_schema = CBOR_STRUCT_SCHEMA(device_info_fields);
 
-    if (key->type != CBOR_TYPE_TEXT_STRING) {
-        printf("Warning: Skipping non string key!\n");
-        return CBOR_CUSTOM_PROCESSOR_OK();
-    }
-    char keystr[key->value.bytes.len + 1];
-    memcpy(keystr, key->value.bytes.ptr, key->value.bytes.len);
-    keystr[key->value.bytes.len] = 0;
-
-    if (!strcmp(keystr, "d")) {
-        cbor_process_result_t result = cbor_process_map(value->value.map, process_device_info, &request->d);
-        if (result.is_error) {
-            printf("Error processing device info: %d\n", result.err);
-        }
-    }
-    if (!strcmp(keystr, "fn")) {
-        request->fn = value->value.integer;
-    }
-    if (!strcmp(keystr, "rid")) {
-        request->rid = value->value.integer;
-    }
-    if (!strcmp(keystr, "r")) {
-        cbor_process_result_t result = cbor_process_map(value->value.map, process_identify_parameters_container, &request->request_bitmap);
-        if (result.is_error) {
-            printf("Error processing request bitmap: %d\n", result.err);
-        }
-    }
-    return CBOR_CUSTOM_PROCESSOR_OK();
-}
+static const cbor_field_t identify_parameters_fields[] = {
+  CBOR_FIELD_KEY_BITMAP("parameters", identification_request_t, request_bitmap, identify_parameter_id, identify_parameter_name, 0),
+};
+static const cbor_struct_schema_t identify_parameters_schema = CBOR_STRUCT_SCHEMA(identify_parameters_fields);
+
+#define IDENTIFICATION_REQUEST_FIELDS \
+  X(fn, CBOR_FIELD_INT)               \
+  X(rid, CBOR_FIELD_INT)
+
+static const cbor_field_t identification_request_fields[] = {
+  CBOR_FIELD_MAP("d", identification_request_t, d, device_info_schema, CBOR_FIELD_REQUIRED),
+  #define X(name, kind) CBOR_FIELD(identification_request_t, name, kind, CBOR_FIELD_REQUIRED),
+  IDENTIFICATION_REQUEST_FIELDS
+  #undef X
+  CBOR_FIELD_INLINE_MAP("r", identify_parameters_schema, 0),
+};
+static const cbor_struct_schema_t identification_request_schema = CBOR_STRUCT_SCHEMA(identification_request_fields);
 
 int main() {
     slice_t cbor = {
@@ -145,11 +81,15 @@ int main() {
 
     identification_request_t request = {0}; // Initialize to zero
 
-    cbor_process_result_t process_result = cbor_process_map(res.ok.value.map, process_identification_request, &request);
+    uint64_t missing = 0;
+    cbor_process_result_t process_result = cbor_decode_struct(res.ok.value.map, &identification_request_schema, &request, &missing);
     if (process_result.is_error) {
-        printf("Processing Error: %d (Buffer overflow detected and handled safely)\n", process_result.err);
+        printf("Processing Error: %d (Truncated input detected and handled safely)\n", process_result.err);
         // Don't exit here, let's see what we got so far
     }
+    else if (missing != 0) {
+        printf("Missing required fields: 0x%llX\n", (unsigned long long)missing);
+    }
 
     printf("\nIdentification Request:\n");
 
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include "cbor.h"
+#include "keys.h"
 
 // X macro for iterating over the identify parameters
 #define IDENTIFY_PARAMETERS           \
@@ -54,6 +55,16 @@ enum identify_response_bits {
   IDENTIFY_MASK_ALL = (1 << IDENTIFY_PARAMETERS_COUNT) - 1
 };
 
+// Maps a parameter name to its IDENTIFY_SHIFT_ value, -1 if unknown
+#define X(name, key) CBOR_KEY_ID(name, IDENTIFY_SHIFT_ ## key)
+CBOR_KEY_LOOKUP_FUNCTION(identify_parameter_id, IDENTIFY_PARAMETERS)
+#undef X
+
+// And back, for encoding a request bitmap
+#define X(name, key) CBOR_KEY_NAME(name, IDENTIFY_SHIFT_ ## key)
+CBOR_KEY_NAME_FUNCTION(identify_parameter_name, IDENTIFY_PARAMETERS)
+#undef X
+
 typedef uint32_t identify_bitmap_t;
 _Static_assert(IDENTIFY_PARAMETERS_COUNT <= (sizeof(identify_bitmap_t) * 8), "Too many identify parameters for bitmap");
 
@@ -0,0 +1,164 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "cbor.h"
+#include "compat/float.h"
+#include "test.h"
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+static uint32_t float_bits(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+// Reference decoding straight from the IEEE 754 definition
+static uint32_t reference_half_bits(uint16_t h) {
+    int exp = (h >> 10) & 0x1F;
+    int mant = h & 0x03FF;
+    uint32_t sign = ((uint32_t)h & 0x8000) << 16;
+
+    if (exp == 0x1F) {
+        return sign | 0x7F800000 | (mant ? 0x00400000 | ((uint32_t)mant << 13) : 0);
+    }
+
+    float magnitude = exp == 0 ? ldexpf((float)mant, -24) : ldexpf((float)(0x400 | mant), exp - 25);
+    return sign | float_bits(magnitude);
+}
+
+// Test 1: Every half value against the reference
+void test_half_exhaustive() {
+    printf("\n=== Testing All f16 Values ===\n");
+
+    uint32_t soft_mismatches = 0;
+    uint32_t fast_mismatches = 0;
+    uint32_t roundtrip_mismatches = 0;
+    for (uint32_t h = 0; h <= 0xFFFF; h++) {
+        uint32_t expected = reference_half_bits((uint16_t)h);
+        if (float_bits(half_to_float_soft((uint16_t)h)) != expected) {
+            soft_mismatches++;
+        }
+        if (float_bits(half_to_float((uint16_t)h)) != expected) {
+            fast_mismatches++;
+        }
+        // Every non-NaN half is exact in f32 and must encode back unchanged
+        if ((h & 0x7FFF) <= 0x7C00 && float_to_half(half_to_float((uint16_t)h)) != h) {
+            roundtrip_mismatches++;
+        }
+    }
+
+    TEST_ASSERT(soft_mismatches == 0, "Soft conversion matches reference for all 65536 values");
+    TEST_ASSERT(fast_mismatches == 0, "half_to_float matches reference for all 65536 values");
+    TEST_ASSERT(roundtrip_mismatches == 0, "Non-NaN halves survive f16 -> f32 -> f16");
+}
+
+// Test 2: f32 to f16 rounding
+void test_half_encode() {
+    printf("\n=== Testing f32 -> f16 Rounding ===\n");
+
+    TEST_ASSERT(float_to_half_soft(1.0f + ldexpf(1.0f, -11)) == 0x3C00, "Tie rounds down to even");
+    TEST_ASSERT(float_to_half_soft(1.0f + ldexpf(3.0f, -11)) == 0x3C02, "Tie rounds up to even");
+    TEST_ASSERT(float_to_half_soft(ldexpf(1.0f, -25)) == 0x0000, "Half the smallest subnormal rounds to zero");
+    TEST_ASSERT(float_to_half_soft(ldexpf(3.0f, -25)) == 0x0002, "Subnormal tie rounds up to even");
+    TEST_ASSERT(float_to_half_soft(65519.0f) == 0x7BFF && float_to_half_soft(65520.0f) == 0x7C00, "Overflow at 65520");
+    TEST_ASSERT(float_to_half_soft(-INFINITY) == 0xFC00, "-Infinity");
+
+#ifdef __FLT16_MANT_DIG__
+    // Every 7th f32 bit pattern against the compiler's _Float16 conversion
+    uint32_t mismatches = 0;
+    for (uint64_t bits = 0; bits <= 0xFFFFFFFF; bits += 7) {
+        uint32_t x = (uint32_t)bits;
+        float f;
+        memcpy(&f, &x, sizeof(f));
+        __extension__ _Float16 cast = (_Float16)f;
+        uint16_t expected;
+        memcpy(&expected, &cast, sizeof(expected));
+        if (float_to_half_soft(f) != expected) {
+            mismatches++;
+        }
+    }
+    TEST_ASSERT(mismatches == 0, "Soft encoder matches the _Float16 cast");
+#endif
+}
+
+// Test 3: Spot checks of the encoding classes
+void test_half_classes() {
+    printf("\n=== Testing f16 Classes ===\n");
+
+    TEST_ASSERT(float_bits(half_to_float(0x0000)) == 0x00000000, "+0.0");
+    TEST_ASSERT(float_bits(half_to_float(0x8000)) == 0x80000000, "-0.0");
+    TEST_ASSERT(half_to_float(0x3C00) == 1.0f, "1.0");
+    TEST_ASSERT(half_to_float(0xC000) == -2.0f, "-2.0");
+    TEST_ASSERT(half_to_float(0x7BFF) == 65504.0f, "Largest normal");
+    TEST_ASSERT(half_to_float(0x0001) == ldexpf(1.0f, -24), "Smallest subnormal");
+    TEST_ASSERT(half_to_float(0x03FF) == ldexpf(1023.0f, -24), "Largest subnormal");
+    TEST_ASSERT(isinf(half_to_float(0x7C00)) && half_to_float(0x7C00) > 0.0f, "+Infinity");
+    TEST_ASSERT(isinf(half_to_float(0xFC00)) && half_to_float(0xFC00) < 0.0f, "-Infinity");
+    TEST_ASSERT(float_bits(half_to_float(0x7E00)) == 0x7FC00000, "Quiet NaN");
+    TEST_ASSERT(float_bits(half_to_float(0x7C01)) == 0x7FC02000, "Signalling NaN is quieted, payload kept");
+}
+
+// Test 4: Bulk converters agree with the scalar one
+void test_half_bulk() {
+    printf("\n=== Testing Bulk f16 Conversion ===\n");
+
+    static uint16_t halves[1027];
+    static uint8_t be[2 * 1027];
+    static float out[1027];
+    static float out_be[1027];
+
+    uint32_t mismatches = 0;
+    uint32_t be_mismatches = 0;
+    for (uint32_t base = 0; base <= 0xFFFF; base += 1027) {
+        // Odd count exercises the scalar tail after any vector loop
+        size_t count = 0;
+        for (uint32_t h = base; h <= 0xFFFF && count < 1027; h++, count++) {
+            halves[count] = (uint16_t)h;
+            be[2 * count] = (uint8_t)(h >> 8);
+            be[2 * count + 1] = (uint8_t)h;
+        }
+
+        half_to_float_n(out, halves, count);
+        half_be_to_float_n(out_be, be, count);
+        for (size_t i = 0; i < count; i++) {
+            uint32_t expected = float_bits(half_to_float(halves[i]));
+            mismatches += float_bits(out[i]) != expected;
+            be_mismatches += float_bits(out_be[i]) != expected;
+        }
+    }
+
+    TEST_ASSERT(mismatches == 0, "half_to_float_n matches half_to_float");
+    TEST_ASSERT(be_mismatches == 0, "half_be_to_float_n matches half_to_float");
+
+    out[0] = 42.0f;
+    half_to_float_n(out, halves, 0);
+    TEST_ASSERT(out[0] == 42.0f, "Empty input writes nothing");
+}
+
+int main() {
+    printf("Testing f16 Conversion\n");
+    printf("======================\n");
+
+    test_half_exhaustive();
+    test_half_encode();
+    test_half_classes();
+    test_half_bulk();
+
+    printf("\n=== Test Results ===\n");
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    if (tests_failed == 0) {
+        printf("🎉 All tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed!\n");
+        return 1;
+    }
+}
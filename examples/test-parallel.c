@@ -0,0 +1,242 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cbor.h"
+#include "parallel.h"
+#include "test.h"
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#ifndef TARGET_EMBEDDED
+
+#include <stdatomic.h>
+
+// Items are [index, "payload..."], 16 bytes each
+#define ITEM_SIZE 16
+#define ITEM_COUNT 40000
+
+static uint8_t* build_sequence(size_t count) {
+    uint8_t* buf = malloc(count * ITEM_SIZE);
+    for (size_t i = 0; i < count; i++) {
+        uint8_t* item = buf + i * ITEM_SIZE;
+        item[0] = 0x82;
+        item[1] = 0x1A;
+        item[2] = (uint8_t)(i >> 24);
+        item[3] = (uint8_t)(i >> 16);
+        item[4] = (uint8_t)(i >> 8);
+        item[5] = (uint8_t)i;
+        item[6] = 0x69;
+        memcpy(item + 7, "payload..", 9);
+    }
+    return buf;
+}
+
+typedef struct {
+    atomic_uchar* seen;
+    atomic_size_t calls;
+    atomic_int mismatches;
+    int ordered;
+    size_t last;            // Only tracked when ordered
+    int out_of_order;
+    size_t fail_at;
+    size_t stop_at;
+} check_t;
+
+static cbor_custom_processor_result_t check_item(slice_t item, size_t index, void* arg) {
+    check_t* check = arg;
+    cbor_parse_result_t array = cbor_parse(item);
+    cbor_parse_result_t first = array.is_error ? array : cbor_parse((slice_t){.len = item.len - 1, .ptr = item.ptr + 1});
+    if (first.is_error || item.len != ITEM_SIZE || (size_t)first.ok.value.integer != index) {
+        atomic_fetch_add(&check->mismatches, 1);
+    }
+    atomic_fetch_add(&check->seen[index], 1);
+    atomic_fetch_add(&check->calls, 1);
+    if (check->ordered) {
+        if (index != 0 && index != check->last + 1) {
+            check->out_of_order = 1;
+        }
+        check->last = index;
+    }
+    if (index == check->fail_at) {
+        return CUSTOM_PROCESSOR_ERR(CBOR_CUSTOM_PROCESSOR_ERROR_PARSER);
+    }
+    if (index == check->stop_at) {
+        return CBOR_CUSTOM_PROCESSOR_STOP();
+    }
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+static void check_init(check_t* check, atomic_uchar* seen) {
+    for (size_t i = 0; i < ITEM_COUNT; i++) {
+        atomic_init(&seen[i], 0);
+    }
+    check->seen = seen;
+    atomic_init(&check->calls, 0);
+    atomic_init(&check->mismatches, 0);
+    check->ordered = 0;
+    check->last = 0;
+    check->out_of_order = 0;
+    check->fail_at = SIZE_MAX;
+    check->stop_at = SIZE_MAX;
+}
+
+static int all_seen_once(const check_t* check, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (atomic_load(&check->seen[i]) != 1) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static atomic_uchar seen[ITEM_COUNT];
+
+// Test 1: Every item processed exactly once
+void test_parallel_all_items() {
+    printf("\n=== Testing Parallel Processing ===\n");
+
+    uint8_t* buf = build_sequence(ITEM_COUNT);
+    slice_t sequence = {.len = ITEM_COUNT * ITEM_SIZE, .ptr = buf};
+
+    const size_t thread_counts[] = {1, 4, 0};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        check_t check;
+        check_init(&check, seen);
+        cbor_process_sequence_parallel_result_t result = cbor_process_sequence_parallel(sequence, thread_counts[t], 0, check_item, &check);
+        TEST_ASSERT(!result.is_error && result.ok == ITEM_COUNT, "All items counted");
+        TEST_ASSERT(atomic_load(&check.calls) == ITEM_COUNT && all_seen_once(&check, ITEM_COUNT), "Every item processed once");
+        TEST_ASSERT(atomic_load(&check.mismatches) == 0, "Items match their indices");
+    }
+
+    check_t check;
+    check_init(&check, seen);
+    check.ordered = 1;
+    cbor_process_sequence_parallel_result_t result = cbor_process_sequence_parallel(sequence, 8, CBOR_PARALLEL_ORDERED, check_item, &check);
+    TEST_ASSERT(!result.is_error && result.ok == ITEM_COUNT && all_seen_once(&check, ITEM_COUNT), "Ordered run processes all items");
+    TEST_ASSERT(!check.out_of_order && check.last == ITEM_COUNT - 1, "Ordered run calls in sequence order");
+
+    result = cbor_process_sequence_parallel((slice_t){.len = 0, .ptr = buf}, 4, 0, check_item, &check);
+    TEST_ASSERT(!result.is_error && result.ok == 0, "Empty sequence has no items");
+
+    free(buf);
+}
+
+// Test 2: Malformed items and processor errors
+void test_parallel_errors() {
+    printf("\n=== Testing Parallel Errors ===\n");
+
+    uint8_t* buf = build_sequence(ITEM_COUNT);
+    slice_t sequence = {.len = ITEM_COUNT * ITEM_SIZE, .ptr = buf};
+
+    const size_t broken = ITEM_COUNT / 2 + 123;
+    buf[broken * ITEM_SIZE] = 0xFF;
+    check_t check;
+    check_init(&check, seen);
+    cbor_process_sequence_parallel_result_t result = cbor_process_sequence_parallel(sequence, 4, 0, check_item, &check);
+    TEST_ASSERT(result.is_error && result.err == MALFORMED_INPUT_ERROR, "Malformed item reported");
+    TEST_ASSERT(all_seen_once(&check, broken) && atomic_load(&check.calls) == broken, "Items before it processed, none after");
+    buf[broken * ITEM_SIZE] = 0x82;
+
+    check_init(&check, seen);
+    check.ordered = 1;
+    result = cbor_process_sequence_parallel((slice_t){.len = sequence.len - 1, .ptr = buf}, 4, CBOR_PARALLEL_ORDERED, check_item, &check);
+    TEST_ASSERT(result.is_error && result.err == BUFFER_OVERFLOW_ERROR, "Truncated last item reported");
+    TEST_ASSERT(!check.out_of_order && atomic_load(&check.calls) == ITEM_COUNT - 1, "Ordered run stops before it");
+
+    check_init(&check, seen);
+    check.ordered = 1;
+    check.fail_at = 1000;
+    result = cbor_process_sequence_parallel(sequence, 4, CBOR_PARALLEL_ORDERED, check_item, &check);
+    TEST_ASSERT(result.is_error && result.err == PROCESSOR_ERROR, "Processor error reported");
+    TEST_ASSERT(atomic_load(&check.calls) == 1001 && check.last == 1000, "Ordered run stops at the failing item");
+
+    check_init(&check, seen);
+    check.fail_at = 1000;
+    result = cbor_process_sequence_parallel(sequence, 4, 0, check_item, &check);
+    TEST_ASSERT(result.is_error && result.err == PROCESSOR_ERROR, "Processor error stops unordered run");
+    TEST_ASSERT(atomic_load(&check.calls) < ITEM_COUNT, "Not every item processed after the error");
+
+    // The claim finds the damage before the processor runs, the earlier item's error still wins
+    buf[500 * ITEM_SIZE] = 0x1C;
+    check_init(&check, seen);
+    check.fail_at = 0;
+    result = cbor_process_sequence_parallel(sequence, 4, 0, check_item, &check);
+    TEST_ASSERT(result.is_error && result.err == PROCESSOR_ERROR, "Processor error before a malformed item reported");
+
+    check_init(&check, seen);
+    check.ordered = 1;
+    check.fail_at = 0;
+    result = cbor_process_sequence_parallel(sequence, 4, CBOR_PARALLEL_ORDERED, check_item, &check);
+    TEST_ASSERT(result.is_error && result.err == PROCESSOR_ERROR, "Ordered processor error before a malformed item reported");
+    buf[500 * ITEM_SIZE] = 0x82;
+
+    free(buf);
+}
+
+// Test 3: Processor asking to stop
+void test_parallel_stop() {
+    printf("\n=== Testing Parallel Stop ===\n");
+
+    uint8_t* buf = build_sequence(ITEM_COUNT);
+    slice_t sequence = {.len = ITEM_COUNT * ITEM_SIZE, .ptr = buf};
+
+    check_t check;
+    check_init(&check, seen);
+    check.ordered = 1;
+    check.stop_at = 1000;
+    cbor_process_sequence_parallel_result_t result = cbor_process_sequence_parallel(sequence, 4, CBOR_PARALLEL_ORDERED, check_item, &check);
+    TEST_ASSERT(!result.is_error && result.ok == 1001, "Ordered stop returns the stopping index plus one");
+    TEST_ASSERT(atomic_load(&check.calls) == 1001 && check.last == 1000, "Ordered run stops at the stopping item");
+
+    check_init(&check, seen);
+    check.stop_at = 1000;
+    result = cbor_process_sequence_parallel(sequence, 4, 0, check_item, &check);
+    TEST_ASSERT(!result.is_error && result.ok == 1001, "Unordered stop returns the stopping index plus one");
+    TEST_ASSERT(atomic_load(&check.calls) < ITEM_COUNT, "Not every item processed after the stop");
+
+    check_init(&check, seen);
+    check.stop_at = 1000;
+    check.fail_at = 2000;
+    check.ordered = 1;
+    result = cbor_process_sequence_parallel(sequence, 4, CBOR_PARALLEL_ORDERED, check_item, &check);
+    TEST_ASSERT(!result.is_error && result.ok == 1001, "Stop before an error is not an error");
+
+    free(buf);
+}
+
+int main() {
+    printf("Testing Parallel Sequence Processing\n");
+    printf("====================================\n");
+
+    test_parallel_all_items();
+    test_parallel_errors();
+    test_parallel_stop();
+
+    printf("\n=== Test Results ===\n");
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    if (tests_failed == 0) {
+        printf("🎉 All tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed!\n");
+        return 1;
+    }
+}
+
+#else
+
+int main() {
+    // No threads on the embedded target
+    (void)tests_passed;
+    (void)tests_failed;
+    printf("Parallel processing is native only, skipped\n");
+    return 0;
+}
+
+#endif /* TARGET_EMBEDDED */
@@ -7,6 +7,7 @@
 #include "cbor.h"
 #include "debug.h"
 #include "test.h"
+#include "keys.h"
 
 // Test result tracking
 static int tests_passed = 0;
@@ -29,6 +30,124 @@ static inline cbor_custom_processor_result_t count_pairs(const cbor_value_t* key
     return CBOR_CUSTOM_PROCESSOR_OK();
 }
 
+// Descends into nested maps itself and reports where they end
+static cbor_custom_processor_result_t count_pairs_nested(const cbor_value_t* key, const cbor_value_t* value, void* arg) {
+    (void)key; (void)arg;
+    pair_count++;
+    if (value->type == CBOR_TYPE_MAP) {
+        cbor_process_result_t result = cbor_process_map(value->value.map, count_pairs_nested, arg);
+        if (!result.is_error) {
+            return CBOR_CUSTOM_PROCESSOR_CONSUMED(result.ok);
+        }
+    }
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+// Sums integers of nested arrays through the compact item processors
+static cbor_custom_processor_result_t sum_items(slice_t doc, const cbor_item_t* item, void* arg) {
+    int64_t* sum = arg;
+    element_count++;
+    if (item->type == CBOR_TYPE_INTEGER) {
+        *sum += item->value.integer;
+    }
+    else if (item->type == CBOR_TYPE_ARRAY) {
+        cbor_process_result_t result = cbor_process_array_items(doc, item, sum_items, arg);
+        if (!result.is_error) {
+            return CBOR_CUSTOM_PROCESSOR_CONSUMED(result.ok);
+        }
+    }
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+// Records the value of the "b" key
+static cbor_custom_processor_result_t find_b(slice_t doc, const cbor_item_t* key, const cbor_item_t* value, void* arg) {
+    pair_count++;
+    slice_t name = cbor_item_bytes(doc, key);
+    if (key->type == CBOR_TYPE_TEXT_STRING && name.len == 1 && name.ptr[0] == 'b') {
+        *(cbor_item_t*)arg = *value;
+    }
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+// Stops at the text key passed as arg
+static cbor_custom_processor_result_t stop_at_key(const cbor_value_t* key, const cbor_value_t* value, void* arg) {
+    (void)value;
+    pair_count++;
+    const char* wanted = arg;
+    if (key->type == CBOR_TYPE_TEXT_STRING && key->value.bytes.len == strlen(wanted) &&
+        memcmp(key->value.bytes.ptr, wanted, key->value.bytes.len) == 0) {
+        return CBOR_CUSTOM_PROCESSOR_STOP();
+    }
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+// Rejects negative integers, stops at the first string
+static cbor_custom_processor_result_t check_element(const cbor_value_t* value, void* arg) {
+    (void)arg;
+    element_count++;
+    if (value->type == CBOR_TYPE_INTEGER && value->value.integer < 0) {
+        return CUSTOM_PROCESSOR_ERR(CBOR_CUSTOM_PROCESSOR_ERROR_PARSER);
+    }
+    if (value->type == CBOR_TYPE_TEXT_STRING || value->type == CBOR_TYPE_BYTE_STRING) {
+        return CBOR_CUSTOM_PROCESSOR_STOP();
+    }
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+// Stops at the first array item, rejects maps
+static cbor_custom_processor_result_t check_item(slice_t doc, const cbor_item_t* item, void* arg) {
+    (void)doc; (void)arg;
+    element_count++;
+    if (item->type == CBOR_TYPE_MAP) {
+        return CUSTOM_PROCESSOR_ERR(CBOR_CUSTOM_PROCESSOR_ERROR_PARSER);
+    }
+    return item->type == CBOR_TYPE_ARRAY ? CBOR_CUSTOM_PROCESSOR_STOP() : CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+// Sums integers of nested arrays, every walk stops after a 2
+static cbor_custom_processor_result_t sum_until_two(const cbor_value_t* value, void* arg) {
+    int64_t* sum = arg;
+    element_count++;
+    if (value->type == CBOR_TYPE_ARRAY) {
+        cbor_process_result_t result = cbor_process_array(value->value.array, sum_until_two, arg);
+        if (!result.is_error && !result.stopped) {
+            return CBOR_CUSTOM_PROCESSOR_CONSUMED(result.ok);
+        }
+        return CBOR_CUSTOM_PROCESSOR_OK();
+    }
+    if (value->type == CBOR_TYPE_INTEGER) {
+        *sum += value->value.integer;
+        if (value->value.integer == 2) {
+            return CBOR_CUSTOM_PROCESSOR_STOP();
+        }
+    }
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+#ifdef CBOR_ERROR_CONTEXT
+// Rejects negative integers at any depth of nested maps
+static cbor_custom_processor_result_t reject_negative(const cbor_value_t* key, const cbor_value_t* value, void* arg) {
+    (void)key;
+    if (value->type == CBOR_TYPE_MAP) {
+        cbor_process_result_t result = cbor_process_map(value->value.map, reject_negative, arg);
+        return result.is_error ? CUSTOM_PROCESSOR_ERR(CBOR_CUSTOM_PROCESSOR_ERROR_PARSER) : CBOR_CUSTOM_PROCESSOR_CONSUMED(result.ok);
+    }
+    if (value->type == CBOR_TYPE_INTEGER && value->value.integer < 0) {
+        return CUSTOM_PROCESSOR_ERR(CBOR_CUSTOM_PROCESSOR_ERROR_PARSER);
+    }
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+// Ignores failures of nested arrays, otherwise checks like check_element
+static cbor_custom_processor_result_t ignore_nested(const cbor_value_t* value, void* arg) {
+    if (value->type == CBOR_TYPE_ARRAY) {
+        cbor_process_array(value->value.array, check_element, arg);
+        return CBOR_CUSTOM_PROCESSOR_OK();
+    }
+    return check_element(value, arg);
+}
+#endif
+
 // Test 1: Basic integer parsing
 void test_integer_parsing() {
     printf("\n=== Testing Integer Parsing ===\n");
@@ -189,6 +308,577 @@ void test_map_parsing() {
     TEST_ASSERT(pair_count == 1, "Should process 1 pair");
 }
 
+// Test 6: Initial byte table
+void test_initial_byte_table() {
+    printf("\n=== Testing Initial Byte Table ===\n");
+
+    int major_ok = 1;
+    int argument_ok = 1;
+    int flags_ok = 1;
+
+    for (int byte = 0; byte < 256; byte++) {
+        const cbor_initial_byte_t ib = cbor_initial_byte_table[byte];
+        uint8_t info = byte & 0x1F;
+        uint8_t data[9] = {(uint8_t)byte, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+        slice_t buf = {.len = sizeof(data), .ptr = data};
+
+        if (ib.major != (byte >> 5)) {
+            major_ok = 0;
+        }
+
+        argument_t arg = cbor_get_argument_safe(buf, 0);
+        uint64_t expected = 0;
+        enum argument_t_tag expected_tag = ARGUMENT_MALFORMED;
+        if (info < 24) { expected_tag = ARGUMENT_1BYTE; expected = info; }
+        else if (info == 24) { expected_tag = ARGUMENT_1BYTE; expected = 0x01; }
+        else if (info == 25) { expected_tag = ARGUMENT_2BYTE; expected = 0x0102; }
+        else if (info == 26) { expected_tag = ARGUMENT_4BYTE; expected = 0x01020304; }
+        else if (info == 27) { expected_tag = ARGUMENT_8BYTE; expected = 0x0102030405060708ULL; }
+        else if (info == 31) { expected_tag = ARGUMENT_NONE; }
+
+        if (arg.tag != expected_tag || cbor_argument_to_fixed(arg) != expected) {
+            argument_ok = 0;
+        }
+
+        int indefinite = info == 31 && (byte >> 5) >= CBOR_MAJOR_TYPE_BYTE_STRING && (byte >> 5) <= CBOR_MAJOR_TYPE_MAP;
+        if (!!(ib.flags & CBOR_IB_INDEFINITE) != indefinite || !!(ib.flags & CBOR_IB_BREAK) != (byte == 0xFF)) {
+            flags_ok = 0;
+        }
+    }
+
+    TEST_ASSERT(major_ok, "Table major type should match the top three bits");
+    TEST_ASSERT(argument_ok, "Table driven argument decoding should match the specification");
+    TEST_ASSERT(flags_ok, "Indefinite and break flags should be set exactly where expected");
+
+    // Truncated arguments are still rejected
+    uint8_t truncated[] = {0x19, 0x01}; // 2-byte argument with one byte present
+    slice_t buf = {.len = sizeof(truncated), .ptr = truncated};
+    TEST_ASSERT(cbor_get_argument_safe(buf, 0).tag == ARGUMENT_MALFORMED, "Truncated argument should be malformed");
+
+    cbor_parse_result_t result = cbor_parse(buf);
+    TEST_ASSERT(result.is_error && result.err == MALFORMED_INPUT_ERROR, "Truncated header should fail to parse");
+
+    // Additional info 31 on integers and tags is rejected by every entry point
+    uint8_t reserved[] = {0x1F, 0x3F, 0xDF};
+    int reserved_ok = 1;
+    for (size_t i = 0; i < sizeof(reserved); i++) {
+        slice_t one = {.len = 1, .ptr = reserved + i};
+        reserved_ok &= cbor_parse(one).err == MALFORMED_INPUT_ERROR && cbor_parse(one).is_error;
+        reserved_ok &= cbor_parse_item(one, 0).is_error && cbor_parse_item(one, 0).err == MALFORMED_INPUT_ERROR;
+        reserved_ok &= cbor_skip(one).is_error && cbor_skip(one).err == MALFORMED_INPUT_ERROR;
+    }
+    TEST_ASSERT(reserved_ok, "Reserved initial bytes rejected by parse, parse_item and skip");
+}
+
+// Test 7: Skipping items without processing them
+void test_skip() {
+    printf("\n=== Testing Skip ===\n");
+
+    // {"a": [1, 2, 3], "b": {"x": 42}, "c": (_ "he", "llo")} followed by a trailing 0x07
+    uint8_t nested[] = {
+        0xA3,
+        0x61, 'a', 0x83, 0x01, 0x02, 0x03,
+        0x61, 'b', 0xA1, 0x61, 'x', 0x18, 0x2A,
+        0x61, 'c', 0x7F, 0x62, 'h', 'e', 0x63, 'l', 'l', 'o', 0xFF,
+        0x07
+    };
+    slice_t buf = {.len = sizeof(nested), .ptr = nested};
+
+    cbor_process_result_t result = cbor_skip(buf);
+    TEST_ASSERT(!result.is_error, "Nested map should skip without error");
+    TEST_ASSERT(!result.is_error && result.ok == nested + sizeof(nested) - 1, "Skip should stop right after the map");
+
+    // [_ [_ ], {_ }, 1]
+    uint8_t indefinite[] = {0x9F, 0x9F, 0xFF, 0xBF, 0xFF, 0x01, 0xFF};
+    buf = (slice_t){.len = sizeof(indefinite), .ptr = indefinite};
+    result = cbor_skip(buf);
+    TEST_ASSERT(!result.is_error && result.ok == indefinite + sizeof(indefinite), "Indefinite containers should skip to their break");
+
+    // Scalars end right after their header and payload
+    uint8_t scalar[] = {0x19, 0x01, 0x00, 0x05};
+    buf = (slice_t){.len = sizeof(scalar), .ptr = scalar};
+    result = cbor_skip(buf);
+    TEST_ASSERT(!result.is_error && result.ok == scalar + 3, "Integer should skip its 2-byte argument");
+
+    // Every truncation of the nested map must be rejected
+    int truncations_rejected = 1;
+    for (size_t len = 1; len < sizeof(nested) - 1; len++) {
+        buf = (slice_t){.len = len, .ptr = nested};
+        if (!cbor_skip(buf).is_error) {
+            truncations_rejected = 0;
+        }
+    }
+    TEST_ASSERT(truncations_rejected, "Truncated containers should fail to skip");
+
+    // Mixed chunk types inside an indefinite text string
+    uint8_t mixed[] = {0x7F, 0x41, 0x00, 0xFF};
+    buf = (slice_t){.len = sizeof(mixed), .ptr = mixed};
+    result = cbor_skip(buf);
+    TEST_ASSERT(result.is_error && result.err == MALFORMED_INPUT_ERROR, "Byte chunk in text string should be malformed");
+
+    // Break code inside a definite length array
+    uint8_t stray_break[] = {0x82, 0x01, 0xFF};
+    buf = (slice_t){.len = sizeof(stray_break), .ptr = stray_break};
+    result = cbor_skip(buf);
+    TEST_ASSERT(result.is_error && result.err == MALFORMED_INPUT_ERROR, "Stray break should be malformed");
+
+    // Indefinite length nesting beyond CBOR_MAX_DEPTH
+    uint8_t deep[2 * CBOR_MAX_DEPTH + 3];
+    memset(deep, 0x9F, CBOR_MAX_DEPTH + 1);
+    deep[CBOR_MAX_DEPTH + 1] = 0x00;
+    memset(deep + CBOR_MAX_DEPTH + 2, 0xFF, CBOR_MAX_DEPTH + 1);
+    buf = (slice_t){.len = sizeof(deep), .ptr = deep};
+    result = cbor_skip(buf);
+    TEST_ASSERT(result.is_error && result.err == DEPTH_LIMIT_ERROR, "Too deep nesting should hit the depth limit");
+
+    buf = (slice_t){.len = sizeof(deep) - 2, .ptr = deep + 1};
+    result = cbor_skip(buf);
+    TEST_ASSERT(!result.is_error && result.ok == deep + sizeof(deep) - 1, "Nesting at the depth limit should skip");
+
+    // Definite length nesting takes no stack, however deep
+    const size_t hostile_depth = 100000;
+    uint8_t* hostile = malloc(hostile_depth + 1);
+    memset(hostile, 0x81, hostile_depth);
+    hostile[hostile_depth] = 0x00;
+    buf = (slice_t){.len = hostile_depth + 1, .ptr = hostile};
+    result = cbor_skip(buf);
+    TEST_ASSERT(!result.is_error && result.ok == hostile + hostile_depth + 1, "Deep definite nesting should skip");
+    for (size_t i = 0; i < hostile_depth; i += 2) {
+        hostile[i] = 0xA1;
+        hostile[i + 1] = 0x01;
+    }
+    result = cbor_skip(buf);
+    TEST_ASSERT(!result.is_error && result.ok == hostile + hostile_depth + 1, "Deep map values should skip");
+    result = cbor_skip((slice_t){.len = hostile_depth, .ptr = hostile});
+    TEST_ASSERT(result.is_error && result.err == BUFFER_OVERFLOW_ERROR, "Truncated deep nesting should overflow");
+    cbor_parse_result_t outer = cbor_parse((slice_t){.len = hostile_depth + 1, .ptr = hostile});
+    result = cbor_process_map(outer.ok.value.map, NULL, NULL);
+    TEST_ASSERT(!result.is_error && result.ok == hostile + hostile_depth + 1, "Deep map values should be processed");
+    free(hostile);
+
+    // Tags and maps count their items, a break cannot end them early
+    uint8_t tag_break[] = {0x9F, 0xC1, 0xFF};
+    result = cbor_skip((slice_t){.len = sizeof(tag_break), .ptr = tag_break});
+    TEST_ASSERT(result.is_error && result.err == MALFORMED_INPUT_ERROR, "Break after a tag should be malformed");
+    uint8_t map_break[] = {0x9F, 0xA1, 0x01, 0xFF};
+    result = cbor_skip((slice_t){.len = sizeof(map_break), .ptr = map_break});
+    TEST_ASSERT(result.is_error && result.err == MALFORMED_INPUT_ERROR, "Break inside a definite map should be malformed");
+    uint8_t odd_map[] = {0xBF, 0x01, 0x82, 0x01, 0x02, 0x03, 0xFF};
+    result = cbor_skip((slice_t){.len = sizeof(odd_map), .ptr = odd_map});
+    TEST_ASSERT(result.is_error && result.err == MALFORMED_INPUT_ERROR, "Odd indefinite map after nested items should be malformed");
+    uint8_t nested_mix[] = {0x82, 0xBF, 0x01, 0x81, 0x9F, 0xFF, 0xFF, 0xC1, 0x7F, 0x61, 'a', 0xFF, 0x00};
+    result = cbor_skip((slice_t){.len = sizeof(nested_mix), .ptr = nested_mix});
+    TEST_ASSERT(!result.is_error && result.ok == nested_mix + sizeof(nested_mix) - 1, "Mixed nesting should skip");
+
+    // The process loops still end elements nested deeper than cbor_skip follows
+    uint8_t deeper[3 * CBOR_MAX_DEPTH + 4];
+    memset(deeper, 0x81, sizeof(deeper));
+    deeper[0] = 0x82;
+    deeper[sizeof(deeper) - 2] = 0x00;
+    deeper[sizeof(deeper) - 1] = 0x07;
+    outer = cbor_parse((slice_t){.len = sizeof(deeper), .ptr = deeper});
+    result = cbor_process_array(outer.ok.value.array, NULL, NULL);
+    TEST_ASSERT(!result.is_error && result.ok == deeper + sizeof(deeper), "Array nested past CBOR_MAX_DEPTH should be processed");
+
+    // {1: [[...[0]...]]} with the value 17 arrays deep
+    uint8_t deep_value[CBOR_MAX_DEPTH + 4];
+    memset(deep_value, 0x81, sizeof(deep_value));
+    deep_value[0] = 0xA1;
+    deep_value[1] = 0x01;
+    deep_value[sizeof(deep_value) - 1] = 0x00;
+    outer = cbor_parse((slice_t){.len = sizeof(deep_value), .ptr = deep_value});
+    result = cbor_process_map(outer.ok.value.map, NULL, NULL);
+    TEST_ASSERT(!result.is_error && result.ok == deep_value + sizeof(deep_value), "Map value 17 arrays deep should be processed");
+}
+
+// Test 8: Processors that descend into nested containers
+void test_nested_processing() {
+    printf("\n=== Testing Nested Processing ===\n");
+
+    // {"a": {"b": {"c": 1}}, "d": 2}
+    uint8_t nested[] = {
+        0xA2,
+        0x61, 'a', 0xA1, 0x61, 'b', 0xA1, 0x61, 'c', 0x01,
+        0x61, 'd', 0x02
+    };
+    slice_t buf = {.len = sizeof(nested), .ptr = nested};
+
+    cbor_parse_result_t result = cbor_parse(buf);
+    TEST_ASSERT(!result.is_error, "Nested map should parse without error");
+
+    pair_count = 0;
+    cbor_process_result_t map_result = cbor_process_map(result.ok.value.map, count_pairs_nested, NULL);
+    TEST_ASSERT(!map_result.is_error, "Nested map processing should succeed");
+    TEST_ASSERT(pair_count == 4, "Should visit every pair at every depth once");
+    TEST_ASSERT(!map_result.is_error && map_result.ok == nested + sizeof(nested), "Should end right after the outer map");
+}
+
+// Test 9: Compact items
+void test_compact_items() {
+    printf("\n=== Testing Compact Items ===\n");
+
+    TEST_ASSERT(sizeof(cbor_item_t) == 16, "Compact item is 16 bytes");
+
+    // [1, -2, [3, 4], 1.5, true, "xy", [_ 5]]
+    uint8_t array[] = {0x87, 0x01, 0x21, 0x82, 0x03, 0x04, 0xF9, 0x3E, 0x00, 0xF5, 0x62, 'x', 'y', 0x9F, 0x05, 0xFF};
+    slice_t doc = {.len = sizeof(array), .ptr = array};
+
+    cbor_parse_item_result_t root = cbor_parse_item(doc, 0);
+    TEST_ASSERT(!root.is_error && root.ok.type == CBOR_TYPE_ARRAY && root.ok.value.length == 7, "Array item parsed");
+
+    cbor_parse_item_result_t item = cbor_parse_item(doc, 2);
+    TEST_ASSERT(!item.is_error && item.ok.value.integer == -2 && item.ok.header == 1, "Negative integer item");
+    item = cbor_parse_item(doc, 6);
+    TEST_ASSERT(!item.is_error && item.ok.type == CBOR_TYPE_FLOAT && item.ok.value.floating == 1.5f, "Half float item");
+    item = cbor_parse_item(doc, 9);
+    TEST_ASSERT(!item.is_error && item.ok.type == CBOR_TYPE_SIMPLE && item.ok.value.simple == CBOR_SIMPLE_TRUE, "Simple item");
+    item = cbor_parse_item(doc, 10);
+    slice_t text = cbor_item_bytes(doc, &item.ok);
+    TEST_ASSERT(!item.is_error && text.len == 2 && memcmp(text.ptr, "xy", 2) == 0, "Text item points into the document");
+    item = cbor_parse_item(doc, 13);
+    TEST_ASSERT(!item.is_error && (item.ok.flags & CBOR_ITEM_INDEFINITE), "Indefinite array item flagged");
+
+    int64_t sum = 0;
+    element_count = 0;
+    cbor_process_result_t result = cbor_process_array_items(doc, &root.ok, sum_items, &sum);
+    TEST_ASSERT(!result.is_error && result.ok == array + sizeof(array), "Item array processing ends after the array");
+    TEST_ASSERT(sum == 11 && element_count == 10, "Every nested item visited once");
+
+    // {"a": [1, 2], "b": 7}
+    uint8_t map[] = {0xA2, 0x61, 'a', 0x82, 0x01, 0x02, 0x61, 'b', 0x07};
+    doc = (slice_t){.len = sizeof(map), .ptr = map};
+    root = cbor_parse_item(doc, 0);
+    cbor_item_t b = {0};
+    pair_count = 0;
+    result = cbor_process_map_items(doc, &root.ok, find_b, &b);
+    TEST_ASSERT(!result.is_error && result.ok == map + sizeof(map) && pair_count == 2, "Item map processing visits both pairs");
+    TEST_ASSERT(b.type == CBOR_TYPE_INTEGER && b.value.integer == 7 && b.offset == 8, "Map value item found");
+
+    TEST_ASSERT(cbor_process_array_items(doc, &root.ok, sum_items, &sum).is_error, "Map is not processed as an array");
+    TEST_ASSERT(cbor_parse_item(doc, sizeof(map)).is_error, "Offset past the end rejected");
+
+    uint8_t truncated[] = {0x83, 0x01, 0x02};
+    doc = (slice_t){.len = sizeof(truncated), .ptr = truncated};
+    root = cbor_parse_item(doc, 0);
+    result = cbor_process_array_items(doc, &root.ok, NULL, NULL);
+    TEST_ASSERT(result.is_error && result.err == BUFFER_OVERFLOW_ERROR, "Truncated item array rejected");
+
+    // [[...[0]...], {1: [[...[0]...]]}] with both values 20 arrays deep
+    uint8_t deep[2 * 20 + 7];
+    deep[0] = 0x82;
+    memset(deep + 1, 0x81, 20);
+    deep[21] = 0x00;
+    deep[22] = 0xA1;
+    deep[23] = 0x01;
+    memset(deep + 24, 0x81, 20);
+    deep[44] = 0x00;
+    doc = (slice_t){.len = 45, .ptr = deep};
+    root = cbor_parse_item(doc, 0);
+    result = cbor_process_array_items(doc, &root.ok, NULL, NULL);
+    TEST_ASSERT(!result.is_error && result.ok == deep + 45, "Item array nested past CBOR_MAX_DEPTH processed");
+    cbor_parse_item_result_t inner = cbor_parse_item(doc, 22);
+    result = cbor_process_map_items(doc, &inner.ok, NULL, NULL);
+    TEST_ASSERT(!result.is_error && result.ok == deep + 45, "Item map value nested past CBOR_MAX_DEPTH processed");
+
+    // Indefinite nesting past CBOR_MAX_DEPTH is rejected by both APIs alike
+    memset(deep, 0x9F, 20);
+    deep[20] = 0x00;
+    memset(deep + 21, 0xFF, 20);
+    doc = (slice_t){.len = 41, .ptr = deep};
+    root = cbor_parse_item(doc, 0);
+    result = cbor_process_array_items(doc, &root.ok, NULL, NULL);
+    TEST_ASSERT(result.is_error && result.err == DEPTH_LIMIT_ERROR, "Item array with indefinite nesting past CBOR_MAX_DEPTH rejected");
+    cbor_parse_result_t parsed = cbor_parse(doc);
+    result = cbor_process_array(parsed.ok.value.array, NULL, NULL);
+    TEST_ASSERT(result.is_error && result.err == DEPTH_LIMIT_ERROR, "Process array agrees on the indefinite depth limit");
+}
+
+// Test 10: Key lookup by encoded bytes
+void test_map_find() {
+    printf("\n=== Testing Map Find ===\n");
+
+    // {"fn": 3, "d": {"sn": "12"}, 1: h'AA', "rid": 9}
+    uint8_t map[] = {
+        0xA4,
+        0x62, 'f', 'n', 0x03,
+        0x61, 'd', 0xA1, 0x62, 's', 'n', 0x62, '1', '2',
+        0x01, 0x41, 0xAA,
+        0x63, 'r', 'i', 'd', 0x09
+    };
+    cbor_parse_result_t parsed = cbor_parse((slice_t){.len = sizeof(map), .ptr = map});
+    TEST_ASSERT(!parsed.is_error, "Map should parse");
+
+    cbor_map_find_result_t fn = cbor_map_find(parsed.ok.value.map, CBOR_TEXT_KEY("fn"));
+    TEST_ASSERT(!fn.is_error && fn.ok.ptr == map + 4 && fn.ok.len == 1, "First key found");
+
+    cbor_map_find_result_t d = cbor_map_find(parsed.ok.value.map, CBOR_TEXT_KEY("d"));
+    TEST_ASSERT(!d.is_error && d.ok.ptr == map + 7 && d.ok.len == 7, "Nested map value spans its contents");
+
+    cbor_parse_result_t device = cbor_parse(d.ok);
+    cbor_map_find_result_t sn = cbor_map_find(device.ok.value.map, CBOR_TEXT_KEY("sn"));
+    cbor_parse_result_t sn_value = cbor_parse(sn.ok);
+    TEST_ASSERT(!sn.is_error && !sn_value.is_error && memcmp(sn_value.ok.value.bytes.ptr, "12", 2) == 0, "Nested lookup");
+
+    uint8_t integer_key[] = {0x01};
+    cbor_map_find_result_t one = cbor_map_find(parsed.ok.value.map, (slice_t){.len = 1, .ptr = integer_key});
+    TEST_ASSERT(!one.is_error && one.ok.ptr == map + 15 && one.ok.len == 2, "Integer key found");
+
+    cbor_map_find_result_t missing = cbor_map_find(parsed.ok.value.map, CBOR_TEXT_KEY("r"));
+    TEST_ASSERT(missing.is_error && missing.err == KEY_NOT_FOUND_ERROR, "Prefix of a key is not a match");
+
+    slice_t keys[] = {CBOR_TEXT_KEY("rid"), CBOR_TEXT_KEY("fn"), CBOR_TEXT_KEY("x")};
+    slice_t values[3];
+    cbor_map_find_many_result_t many = cbor_map_find_many(parsed.ok.value.map, keys, values, 3);
+    TEST_ASSERT(!many.is_error && many.ok == 2, "Two of three keys found");
+    TEST_ASSERT(values[0].ptr == map + sizeof(map) - 1 && values[1].ptr == map + 4 && values[2].ptr == NULL, "Values in key order");
+
+    // Stops at the last wanted key, so what follows it is never read
+    uint8_t stop_early[] = {0xA2, 0x61, 'a', 0x01, 0x61, 'b', 0x1C};
+    parsed = cbor_parse((slice_t){.len = sizeof(stop_early), .ptr = stop_early});
+    cbor_map_find_result_t a = cbor_map_find(parsed.ok.value.map, CBOR_TEXT_KEY("a"));
+    TEST_ASSERT(!a.is_error && a.ok.len == 1, "Lookup stops at the first match");
+    cbor_map_find_result_t b = cbor_map_find(parsed.ok.value.map, CBOR_TEXT_KEY("b"));
+    TEST_ASSERT(b.is_error && b.err == MALFORMED_INPUT_ERROR, "Malformed value reported");
+
+    // {_ "a": 1}
+    uint8_t indefinite[] = {0xBF, 0x61, 'a', 0x01, 0xFF};
+    parsed = cbor_parse((slice_t){.len = sizeof(indefinite), .ptr = indefinite});
+    a = cbor_map_find(parsed.ok.value.map, CBOR_TEXT_KEY("a"));
+    missing = cbor_map_find(parsed.ok.value.map, CBOR_TEXT_KEY("z"));
+    TEST_ASSERT(!a.is_error && missing.is_error && missing.err == KEY_NOT_FOUND_ERROR, "Indefinite map lookup");
+}
+
+// Test 11: Key dispatch
+#define TEST_KEYS \
+    X(a, A) \
+    X(ab, AB) \
+    X(ba, BA) \
+    X(abcdefgh, EIGHT) \
+    X(parameters, PARAMETERS) \
+    X(parameterz, PARAMETERZ) \
+    X(serial_number_of_board, SERIAL) \
+    X(abcdefgh_x_abcdefgh, MIDDLE_X) \
+    X(abcdefgh_y_abcdefgh, MIDDLE_Y)
+
+enum test_key_ids {
+    #define X(name, key) TEST_KEY_ ## key,
+    TEST_KEYS
+    #undef X
+};
+
+#define X(name, key) CBOR_KEY_ID(name, TEST_KEY_ ## key)
+CBOR_KEY_LOOKUP_FUNCTION(test_key_id, TEST_KEYS)
+#undef X
+
+void test_key_dispatch() {
+    printf("\n=== Testing Key Dispatch ===\n");
+
+    #define KEY(str) ((slice_t){.len = sizeof(str) - 1, .ptr = (uint8_t*)(str)})
+    TEST_ASSERT(test_key_id(KEY("a")) == TEST_KEY_A, "Single byte key");
+    TEST_ASSERT(test_key_id(KEY("ab")) == TEST_KEY_AB && test_key_id(KEY("ba")) == TEST_KEY_BA, "Byte order matters");
+    TEST_ASSERT(test_key_id(KEY("abcdefgh")) == TEST_KEY_EIGHT, "Eight byte key");
+    TEST_ASSERT(test_key_id(KEY("parameters")) == TEST_KEY_PARAMETERS, "Long key");
+    TEST_ASSERT(test_key_id(KEY("parameterz")) == TEST_KEY_PARAMETERZ, "Long keys differing after 8 bytes");
+    TEST_ASSERT(test_key_id(KEY("parameter")) == -1, "Prefix of a long key is unknown");
+    TEST_ASSERT(test_key_id(KEY("serial_number_of_board")) == TEST_KEY_SERIAL, "Key longer than 16 bytes");
+    TEST_ASSERT(test_key_id(KEY("serial_number_of_boarx")) == -1, "Unknown key longer than 16 bytes");
+    // Same length and first 8 bytes, told apart by the bytes after them
+    TEST_ASSERT(test_key_id(KEY("abcdefgh_x_abcdefgh")) == TEST_KEY_MIDDLE_X &&
+        test_key_id(KEY("abcdefgh_y_abcdefgh")) == TEST_KEY_MIDDLE_Y, "Keys with equal first words");
+    TEST_ASSERT(test_key_id(KEY("abcdefgh_z_abcdefgh")) == -1, "Unknown key with an equal first word");
+    TEST_ASSERT(test_key_id(KEY("abc")) == -1 && test_key_id(KEY("")) == -1, "Unknown keys");
+    TEST_ASSERT(test_key_id((slice_t){.len = 2, .ptr = (uint8_t*)"a\0"}) == -1, "Length is part of the key");
+    #undef KEY
+
+    // [_ "ab", 7, "zz", "parameters", ["a"]]
+    uint8_t set[] = {
+        0x9F, 0x62, 'a', 'b', 0x07, 0x62, 'z', 'z',
+        0x6A, 'p', 'a', 'r', 'a', 'm', 'e', 't', 'e', 'r', 's',
+        0x81, 0x61, 'a', 0xFF
+    };
+    cbor_parse_result_t parsed = cbor_parse((slice_t){.len = sizeof(set), .ptr = set});
+    uint64_t bitmap = 0;
+    cbor_process_result_t result = cbor_decode_key_bitmap(parsed.ok.value.array, test_key_id, &bitmap);
+    TEST_ASSERT(!result.is_error && result.ok == set + sizeof(set), "String set decoded to the end");
+    TEST_ASSERT(bitmap == ((1u << TEST_KEY_AB) | (1u << TEST_KEY_PARAMETERS)), "Known strings set their bits");
+}
+
+// Test 12: Float widths
+void test_float_precision() {
+    printf("\n=== Testing Float Precision ===\n");
+
+    // 1.1 as f64, not representable as float
+    uint8_t f64[] = {0xFB, 0x3F, 0xF1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9A};
+    cbor_parse_result_t result = cbor_parse((slice_t){.len = sizeof(f64), .ptr = f64});
+    TEST_ASSERT(!result.is_error && result.ok.type == CBOR_TYPE_FLOAT, "f64 parsed");
+    TEST_ASSERT(cbor_value_float_precision(&result.ok) == CBOR_FLOAT_PRECISION_DOUBLE, "f64 keeps its width");
+    TEST_ASSERT(cbor_value_double(&result.ok) == 1.1 && result.ok.value.float64 == 1.1, "f64 value exact");
+    TEST_ASSERT(cbor_value_float(&result.ok) == 1.1f, "f64 rounded to float on request");
+    TEST_ASSERT(result.ok.next == f64 + sizeof(f64), "f64 next");
+
+    uint8_t f32[] = {0xFA, 0x3F, 0x8C, 0xCC, 0xCD};
+    result = cbor_parse((slice_t){.len = sizeof(f32), .ptr = f32});
+    TEST_ASSERT(!result.is_error && cbor_value_float_precision(&result.ok) == CBOR_FLOAT_PRECISION_SINGLE, "f32 keeps its width");
+    TEST_ASSERT(result.ok.value.floating == 1.1f && cbor_value_double(&result.ok) == (double)1.1f, "f32 value");
+
+    uint8_t f16[] = {0xF9, 0xC4, 0x00};
+    result = cbor_parse((slice_t){.len = sizeof(f16), .ptr = f16});
+    TEST_ASSERT(!result.is_error && cbor_value_float_precision(&result.ok) == CBOR_FLOAT_PRECISION_HALF, "f16 keeps its width");
+    TEST_ASSERT(result.ok.value.floating == -4.0f && cbor_value_double(&result.ok) == -4.0, "f16 value");
+
+    cbor_parse_item_result_t item = cbor_parse_item((slice_t){.len = sizeof(f64), .ptr = f64}, 0);
+    TEST_ASSERT(!item.is_error && item.ok.header == 9 && cbor_item_double(&item.ok) == 1.1, "f64 item exact");
+    item = cbor_parse_item((slice_t){.len = sizeof(f16), .ptr = f16}, 0);
+    TEST_ASSERT(!item.is_error && cbor_item_double(&item.ok) == -4.0, "f16 item");
+
+    // Parsed floats encode back to the same bytes
+    uint8_t buf[16];
+    uint8_t* inputs[] = {f64, f32, f16};
+    size_t lens[] = {sizeof(f64), sizeof(f32), sizeof(f16)};
+    int round_trips = 1;
+    for (size_t i = 0; i < 3; i++) {
+        cbor_parse_result_t parsed = cbor_parse((slice_t){.len = lens[i], .ptr = inputs[i]});
+        cbor_encode_result_t encoded = cbor_encode(parsed.ok, (slice_t){.len = sizeof(buf), .ptr = buf});
+        round_trips &= !encoded.is_error && encoded.ok.len == lens[i] && memcmp(buf, inputs[i], lens[i]) == 0;
+    }
+    TEST_ASSERT(round_trips, "f16, f32 and f64 round trip");
+
+    cbor_encode_result_t encoded = cbor_encode(CBOR_DOUBLE_VALUE(1.1), (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!encoded.is_error && encoded.ok.len == 9 && memcmp(buf, f64, sizeof(f64)) == 0, "CBOR_DOUBLE_VALUE encodes f64");
+    encoded = cbor_encode(CBOR_HALF_VALUE(-4.0f), (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!encoded.is_error && encoded.ok.len == 3 && memcmp(buf, f16, sizeof(f16)) == 0, "CBOR_HALF_VALUE encodes f16");
+    encoded = cbor_encode_float(-4.0f, CBOR_FLOAT_PRECISION_DOUBLE, (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!encoded.is_error && encoded.ok.len == 9 && buf[0] == 0xFB && buf[1] == 0xC0 && buf[2] == 0x10, "Float widened to f64");
+    encoded = cbor_encode_double(1.1, (slice_t){.len = 8, .ptr = buf});
+    TEST_ASSERT(encoded.is_error && encoded.err == CBOR_ENCODER_ERROR_BUFFER_OVERFLOW, "f64 needs nine bytes");
+    encoded = cbor_encode_float(1.0f, CBOR_FLOAT_PRECISION_HALF, (slice_t){.len = 2, .ptr = buf});
+    TEST_ASSERT(encoded.is_error && encoded.err == CBOR_ENCODER_ERROR_BUFFER_OVERFLOW, "f16 needs three bytes");
+}
+
+// Test 13: Stopping and failing from processors
+void test_processor_control() {
+    printf("\n=== Testing Processor Stop and Errors ===\n");
+
+    // {"a": [1, 2], "b": 7, "c": 8}
+    uint8_t map[] = {0xA3, 0x61, 'a', 0x82, 0x01, 0x02, 0x61, 'b', 0x07, 0x61, 'c', 0x08};
+    cbor_parse_result_t result = cbor_parse((slice_t){.len = sizeof(map), .ptr = map});
+    pair_count = 0;
+    cbor_process_result_t processed = cbor_process_map(result.ok.value.map, stop_at_key, "a");
+    TEST_ASSERT(processed.stopped && !processed.is_error && processed.ok == map + 6 && pair_count == 1, "Map walk stops after a container value");
+    pair_count = 0;
+    processed = cbor_process_map(result.ok.value.map, stop_at_key, "b");
+    TEST_ASSERT(processed.stopped && !processed.is_error && processed.ok == map + 9 && pair_count == 2, "Map walk stops after the found pair");
+    pair_count = 0;
+    processed = cbor_process_map(result.ok.value.map, stop_at_key, "x");
+    TEST_ASSERT(!processed.stopped && !processed.is_error && processed.ok == map + sizeof(map) && pair_count == 3, "Map walk completes without a stop");
+
+    // {_ "a": 1, "b": 2}
+    uint8_t indefinite_map[] = {0xBF, 0x61, 'a', 0x01, 0x61, 'b', 0x02, 0xFF};
+    result = cbor_parse((slice_t){.len = sizeof(indefinite_map), .ptr = indefinite_map});
+    pair_count = 0;
+    processed = cbor_process_map(result.ok.value.map, stop_at_key, "a");
+    TEST_ASSERT(!processed.is_error && processed.ok == indefinite_map + 4 && pair_count == 1, "Indefinite map walk stops");
+
+    // [1, "x", -1] and [1, -1, "x"]
+    uint8_t stops[] = {0x83, 0x01, 0x61, 'x', 0x20};
+    result = cbor_parse((slice_t){.len = sizeof(stops), .ptr = stops});
+    element_count = 0;
+    processed = cbor_process_array(result.ok.value.array, check_element, NULL);
+    TEST_ASSERT(!processed.is_error && processed.ok == stops + 4 && element_count == 2, "Array walk stops before the bad element");
+    uint8_t fails[] = {0x83, 0x01, 0x20, 0x61, 'x'};
+    result = cbor_parse((slice_t){.len = sizeof(fails), .ptr = fails});
+    element_count = 0;
+    processed = cbor_process_array(result.ok.value.array, check_element, NULL);
+    TEST_ASSERT(processed.is_error && processed.err == PROCESSOR_ERROR && element_count == 2, "Array processor error aborts");
+
+    // [_ -1, 2]
+    uint8_t indefinite_array[] = {0x9F, 0x20, 0x02, 0xFF};
+    result = cbor_parse((slice_t){.len = sizeof(indefinite_array), .ptr = indefinite_array});
+    processed = cbor_process_array(result.ok.value.array, check_element, NULL);
+    TEST_ASSERT(processed.is_error && processed.err == PROCESSOR_ERROR, "Indefinite array processor error aborts");
+
+    // (_ h'01', h'02')
+    uint8_t chunks[] = {0x5F, 0x41, 0x01, 0x41, 0x02, 0xFF};
+    result = cbor_parse((slice_t){.len = sizeof(chunks), .ptr = chunks});
+    element_count = 0;
+    processed = cbor_process_indefinite_string(result.ok.value.array, CBOR_TYPE_BYTE_STRING, check_element, NULL);
+    TEST_ASSERT(!processed.is_error && processed.ok == chunks + 3 && element_count == 1, "String chunk walk stops");
+
+    // [1, [2], {}, 3] through the compact item processors
+    uint8_t items[] = {0x84, 0x01, 0x81, 0x02, 0xA0, 0x03};
+    slice_t doc = {.len = sizeof(items), .ptr = items};
+    cbor_parse_item_result_t root = cbor_parse_item(doc, 0);
+    element_count = 0;
+    processed = cbor_process_array_items(doc, &root.ok, check_item, NULL);
+    TEST_ASSERT(processed.stopped && !processed.is_error && processed.ok == items + 4 && element_count == 2, "Item walk stops after the nested array");
+
+    // [1, {}]
+    uint8_t item_maps[] = {0x82, 0x01, 0xA0};
+    doc = (slice_t){.len = sizeof(item_maps), .ptr = item_maps};
+    element_count = 0;
+    root = cbor_parse_item(doc, 0);
+    processed = cbor_process_array_items(doc, &root.ok, check_item, NULL);
+    TEST_ASSERT(processed.is_error && processed.err == PROCESSOR_ERROR && element_count == 2, "Item processor error aborts");
+
+    // [[1, 2, 3], 4], the nested walk stops after 2 and the outer one goes on
+    uint8_t nested_stop[] = {0x82, 0x83, 0x01, 0x02, 0x03, 0x04};
+    result = cbor_parse((slice_t){.len = sizeof(nested_stop), .ptr = nested_stop});
+    int64_t sum = 0;
+    element_count = 0;
+    processed = cbor_process_array(result.ok.value.array, sum_until_two, &sum);
+    TEST_ASSERT(!processed.is_error && !processed.stopped && processed.ok == nested_stop + sizeof(nested_stop),
+        "Outer walk skips the rest of a stopped nested walk");
+    TEST_ASSERT(sum == 7 && element_count == 4, "Elements after the nested stop not processed");
+}
+
+// Test 14: Error context
+void test_error_context() {
+    printf("\n=== Testing Error Context ===\n");
+#ifdef CBOR_ERROR_CONTEXT
+    // [1, 2, 0x19 0x01], the last element is cut off
+    uint8_t truncated[] = {0x83, 0x01, 0x02, 0x19, 0x01};
+    cbor_parse_result_t result = cbor_parse((slice_t){.len = sizeof(truncated), .ptr = truncated});
+    cbor_process_result_t processed = cbor_process_array(result.ok.value.array, NULL, NULL);
+    const cbor_error_context_t* context = cbor_last_error();
+    TEST_ASSERT(processed.is_error && context->set && context->error == processed.err, "Error recorded");
+    TEST_ASSERT(context->offset == 2 && context->depth == 0 && context->major_type == CBOR_MAJOR_TYPE_UNSIGNED_INTEGER,
+        "Offset, depth and major type of the truncated element");
+
+    // {"a": {"b": -1}}, the processor rejects -1 one level down
+    uint8_t nested[] = {0xA1, 0x61, 'a', 0xA1, 0x61, 'b', 0x20};
+    result = cbor_parse((slice_t){.len = sizeof(nested), .ptr = nested});
+    processed = cbor_process_map(result.ok.value.map, reject_negative, NULL);
+    TEST_ASSERT(processed.is_error && processed.err == PROCESSOR_ERROR, "Nested processor error propagates");
+    TEST_ASSERT(context->set && context->error == PROCESSOR_ERROR && context->offset == 5 && context->depth == 1 &&
+        context->major_type == CBOR_MAJOR_TYPE_NEGATIVE_INTEGER, "Innermost failure kept");
+
+    nested[6] = 0x01;
+    processed = cbor_process_map(result.ok.value.map, reject_negative, NULL);
+    TEST_ASSERT(!processed.is_error && !context->set, "Success clears the context");
+
+    // [[-1], 0x1C], the processor ignores the failed nested walk before the outer one fails
+    uint8_t recovered[] = {0x82, 0x81, 0x20, 0x1C};
+    result = cbor_parse((slice_t){.len = sizeof(recovered), .ptr = recovered});
+    processed = cbor_process_array(result.ok.value.array, ignore_nested, NULL);
+    TEST_ASSERT(processed.is_error && processed.err == MALFORMED_INPUT_ERROR, "Outer failure after a recovered nested one");
+    TEST_ASSERT(context->error == MALFORMED_INPUT_ERROR && context->offset == 2 && context->depth == 0,
+        "Recovered nested failure replaced by the outer one");
+
+    // [[-1], -1], the processor itself rejects a later element
+    recovered[3] = 0x20;
+    processed = cbor_process_array(result.ok.value.array, ignore_nested, NULL);
+    TEST_ASSERT(processed.is_error && context->error == PROCESSOR_ERROR && context->offset == 2 && context->depth == 0,
+        "Later processor error replaces a recovered nested one");
+
+    // [1, {}] through the item walker, offsets count from the document
+    uint8_t items[] = {0x82, 0x01, 0xA0};
+    slice_t doc = {.len = sizeof(items), .ptr = items};
+    cbor_parse_item_result_t root = cbor_parse_item(doc, 0);
+    processed = cbor_process_array_items(doc, &root.ok, check_item, NULL);
+    TEST_ASSERT(processed.is_error && context->offset == 2 && context->major_type == CBOR_MAJOR_TYPE_MAP, "Item walker error context");
+#endif
+}
+
 int main() {
     printf("CBOR Library - Parsing Test Suite\n");
     printf("==================================\n");
@@ -198,6 +888,15 @@ int main() {
     test_simple_values();
     test_array_parsing();
     test_map_parsing();
+    test_initial_byte_table();
+    test_skip();
+    test_nested_processing();
+    test_compact_items();
+    test_map_find();
+    test_key_dispatch();
+    test_float_precision();
+    test_processor_control();
+    test_error_context();
     
     printf("\n=== Test Summary ===\n");
     printf("Tests passed: %d\n", tests_passed);
@@ -0,0 +1,197 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cbor.h"
+#include "path.h"
+#include "test.h"
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// {"d": {"f": "fw", "sn": "123"}, "fn": 3, "r": {"parameters": [1, 2]}}
+uint8_t request[] = {
+    0xA3,
+    0x61, 0x64,
+    0xA2, 0x61, 0x66, 0x62, 0x66, 0x77, 0x62, 0x73, 0x6E, 0x63, 0x31, 0x32, 0x33,
+    0x62, 0x66, 0x6E,
+    0x03,
+    0x61, 0x72,
+    0xA1, 0x6A, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x73, 0x82, 0x01, 0x02
+};
+
+static cbor_path_find_result_t find(const char* text, slice_t buf) {
+    cbor_path_t path;
+    cbor_path_compile_result_t compiled = cbor_path_compile(text, &path);
+    if (compiled.is_error) {
+        return ERR(cbor_path_find_result_t, compiled.err);
+    }
+    return cbor_path_find(&path, buf);
+}
+
+// Test 1: Compiling paths into steps
+void test_path_compile() {
+    printf("\n=== Testing Path Compile ===\n");
+
+    cbor_path_t path;
+    cbor_path_compile_result_t compiled = cbor_path_compile("r.parameters[1]", &path);
+    TEST_ASSERT(!compiled.is_error && compiled.ok == 3, "Three steps compiled");
+    TEST_ASSERT(!cbor_path_step_is_index(&path, 0) && !cbor_path_step_is_index(&path, 1), "Keys compiled as key steps");
+    TEST_ASSERT(cbor_path_step_is_index(&path, 2) && path.steps[2].index == 1, "Index compiled as index step");
+
+    slice_t key = cbor_path_step_key(&path, 1);
+    uint8_t expected[] = {0x6A, 'p', 'a', 'r', 'a', 'm', 'e', 't', 'e', 'r', 's'};
+    TEST_ASSERT(key.len == sizeof(expected) && memcmp(key.ptr, expected, sizeof(expected)) == 0, "Key stored encoded");
+
+    compiled = cbor_path_compile("[0][12]", &path);
+    TEST_ASSERT(!compiled.is_error && compiled.ok == 2 && path.steps[1].index == 12, "Index only path compiled");
+
+    compiled = cbor_path_compile("", &path);
+    TEST_ASSERT(!compiled.is_error && compiled.ok == 0, "Empty path selects the root");
+
+    compiled = cbor_path_compile("abcdefghijklmnopqrstuvwxyz", &path);
+    TEST_ASSERT(!compiled.is_error && path.steps[0].len == 28, "Long key uses a two byte header");
+
+    const char* malformed[] = {"a..b", ".a", "a.", "a[", "a[]", "a[1", "a[x]", "a[1]b"};
+    for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++) {
+        compiled = cbor_path_compile(malformed[i], &path);
+        TEST_ASSERT(compiled.is_error && compiled.err == MALFORMED_INPUT_ERROR, malformed[i]);
+    }
+
+    compiled = cbor_path_compile("a.b.c.d.e.f.g.h.i", &path);
+    TEST_ASSERT(compiled.is_error && compiled.err == CAPACITY_ERROR, "Too many steps rejected");
+    compiled = cbor_path_compile("[4294967296]", &path);
+    TEST_ASSERT(compiled.is_error && compiled.err == CAPACITY_ERROR, "Index above 32 bits rejected");
+}
+
+// Test 2: Finding nested items
+void test_path_find() {
+    printf("\n=== Testing Path Find ===\n");
+
+    slice_t buf = {.len = sizeof(request), .ptr = request};
+
+    cbor_path_find_result_t found = find("d.sn", buf);
+    TEST_ASSERT(!found.is_error && found.ok.ptr == request + 12 && found.ok.len == 4, "d.sn found");
+
+    found = find("fn", buf);
+    TEST_ASSERT(!found.is_error && found.ok.len == 1 && found.ok.ptr[0] == 0x03, "fn found");
+
+    found = find("r.parameters[1]", buf);
+    TEST_ASSERT(!found.is_error && found.ok.len == 1 && found.ok.ptr[0] == 0x02, "r.parameters[1] found");
+
+    found = find("r.parameters", buf);
+    TEST_ASSERT(!found.is_error && found.ok.len == 3 && found.ok.ptr[0] == 0x82, "Container returned whole");
+
+    found = find("", buf);
+    TEST_ASSERT(!found.is_error && found.ok.ptr == request && found.ok.len == sizeof(request), "Empty path returns the root");
+
+    const char* missing[] = {"x", "d.x", "r.parameters[2]", "fn.x", "d[0]", "r.parameters.x"};
+    for (size_t i = 0; i < sizeof(missing) / sizeof(missing[0]); i++) {
+        found = find(missing[i], buf);
+        TEST_ASSERT(found.is_error && found.err == KEY_NOT_FOUND_ERROR, missing[i]);
+    }
+
+    // [_ {"a": 1}, [_ 5, 6]]
+    uint8_t indefinite[] = {0x9F, 0xA1, 0x61, 0x61, 0x01, 0x9F, 0x05, 0x06, 0xFF, 0xFF};
+    slice_t indefinite_buf = {.len = sizeof(indefinite), .ptr = indefinite};
+    found = find("[1][1]", indefinite_buf);
+    TEST_ASSERT(!found.is_error && found.ok.ptr[0] == 0x06, "Indefinite arrays indexed");
+    found = find("[0].a", indefinite_buf);
+    TEST_ASSERT(!found.is_error && found.ok.ptr[0] == 0x01, "Map inside indefinite array found");
+    found = find("[2]", indefinite_buf);
+    TEST_ASSERT(found.is_error && found.err == KEY_NOT_FOUND_ERROR, "Index past the break is missing");
+
+    // {"a": 1, "b": <reserved>}, the broken sibling comes after the target
+    uint8_t broken_sibling[] = {0xA2, 0x61, 0x61, 0x01, 0x61, 0x62, 0x1C};
+    found = find("a", (slice_t){.len = sizeof(broken_sibling), .ptr = broken_sibling});
+    TEST_ASSERT(!found.is_error && found.ok.ptr == broken_sibling + 3 && found.ok.len == 1, "Malformed sibling after the target not read");
+
+    uint8_t truncated[] = {0xA1, 0x61, 0x61, 0x82, 0x01};
+    found = find("a[0]", (slice_t){.len = sizeof(truncated), .ptr = truncated});
+    TEST_ASSERT(found.is_error && found.err == BUFFER_OVERFLOW_ERROR, "Truncated document rejected");
+}
+
+// Test 3: Projecting several paths in one pass
+void test_project() {
+    printf("\n=== Testing Projection ===\n");
+
+    slice_t buf = {.len = sizeof(request), .ptr = request};
+    const char* texts[] = {"r.parameters[1]", "d.sn", "x", "d", "r.parameters[0]", "d.f", "fn", "r.parameters[5]"};
+    const size_t count = sizeof(texts) / sizeof(texts[0]);
+    cbor_path_t paths[sizeof(texts) / sizeof(texts[0])];
+    for (size_t i = 0; i < count; i++) {
+        cbor_path_compile(texts[i], &paths[i]);
+    }
+
+    slice_t values[sizeof(texts) / sizeof(texts[0])];
+    cbor_project_result_t projected = cbor_project(buf, paths, count, values);
+    TEST_ASSERT(!projected.is_error && projected.ok == 6, "Six of eight paths found");
+
+    // Every value matches a separate lookup
+    for (size_t i = 0; i < count; i++) {
+        cbor_path_find_result_t single = cbor_path_find(&paths[i], buf);
+        if (single.is_error) {
+            TEST_ASSERT(values[i].ptr == NULL && values[i].len == 0, texts[i]);
+        }
+        else {
+            TEST_ASSERT(values[i].ptr == single.ok.ptr && values[i].len == single.ok.len, texts[i]);
+        }
+    }
+
+    // Stops early: nothing after "d" is read, so garbage there goes unnoticed
+    uint8_t early[sizeof(request)];
+    memcpy(early, request, sizeof(request));
+    early[16] = 0xFC;
+    projected = cbor_project((slice_t){.len = sizeof(early), .ptr = early}, &paths[1], 1, values);
+    TEST_ASSERT(!projected.is_error && projected.ok == 1, "Walk stops once every path is found");
+    projected = cbor_project((slice_t){.len = sizeof(early), .ptr = early}, &paths[6], 1, values);
+    TEST_ASSERT(projected.is_error && projected.err == MALFORMED_INPUT_ERROR, "Paths past the garbage hit it");
+
+    // Duplicate keys keep the first value, like cbor_map_find
+    uint8_t duplicate[] = {0xBF, 0x61, 0x61, 0x01, 0x61, 0x62, 0x9F, 0x07, 0xFF, 0x61, 0x61, 0x02, 0xFF};
+    cbor_path_t dup_paths[3];
+    cbor_path_compile("a", &dup_paths[0]);
+    cbor_path_compile("b[0]", &dup_paths[1]);
+    cbor_path_compile("c", &dup_paths[2]);
+    projected = cbor_project((slice_t){.len = sizeof(duplicate), .ptr = duplicate}, dup_paths, 3, values);
+    TEST_ASSERT(!projected.is_error && projected.ok == 2, "Indefinite containers projected");
+    TEST_ASSERT(values[0].ptr == duplicate + 3 && values[1].ptr == duplicate + 7, "First duplicate wins");
+
+    // Missing paths make the walk read the whole document
+    projected = cbor_project((slice_t){.len = sizeof(duplicate) - 1, .ptr = duplicate}, &paths[2], 1, values);
+    TEST_ASSERT(projected.is_error && projected.err == BUFFER_OVERFLOW_ERROR, "Truncated document rejected");
+
+    cbor_path_t many[CBOR_PROJECT_MAX_PATHS + 1];
+    slice_t many_values[CBOR_PROJECT_MAX_PATHS + 1];
+    for (size_t i = 0; i < CBOR_PROJECT_MAX_PATHS + 1; i++) {
+        many[i] = paths[i % count];
+    }
+    projected = cbor_project(buf, many, CBOR_PROJECT_MAX_PATHS, many_values);
+    TEST_ASSERT(!projected.is_error && projected.ok == CBOR_PROJECT_MAX_PATHS / count * 6, "Repeated paths all filled");
+    TEST_ASSERT(many_values[62].ptr == request + 19 && many_values[63].ptr == NULL, "All 64 paths resolved");
+    projected = cbor_project(buf, many, CBOR_PROJECT_MAX_PATHS + 1, many_values);
+    TEST_ASSERT(projected.is_error && projected.err == CAPACITY_ERROR, "Too many paths rejected");
+}
+
+int main() {
+    printf("Testing CBOR Paths\n");
+    printf("==================\n");
+
+    test_path_compile();
+    test_path_find();
+    test_project();
+
+    printf("\n=== Test Results ===\n");
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    if (tests_failed == 0) {
+        printf("🎉 All tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed!\n");
+        return 1;
+    }
+}
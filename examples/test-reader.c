@@ -0,0 +1,211 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cbor.h"
+#include "reader.h"
+#include "test.h"
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// {"d": {"f": "fw", "sn": "123"}, "fn": 3, "r": {"parameters": [1, 2]}}
+uint8_t request[] = {
+    0xA3,
+    0x61, 0x64,
+    0xA2, 0x61, 0x66, 0x62, 0x66, 0x77, 0x62, 0x73, 0x6E, 0x63, 0x31, 0x32, 0x33,
+    0x62, 0x66, 0x6E,
+    0x03,
+    0x61, 0x72,
+    0xA1, 0x6A, 0x70, 0x61, 0x72, 0x61, 0x6D, 0x65, 0x74, 0x65, 0x72, 0x73, 0x82, 0x01, 0x02
+};
+
+static int key_is(cbor_parse_result_t key, const char* text) {
+    return !key.is_error && key.ok.type == CBOR_TYPE_TEXT_STRING
+        && key.ok.value.bytes.len == strlen(text)
+        && memcmp(key.ok.value.bytes.ptr, text, key.ok.value.bytes.len) == 0;
+}
+
+// Test 1: Walking a nested map without callbacks
+void test_reader_walk() {
+    printf("\n=== Testing Reader Walk ===\n");
+
+    cbor_reader_t reader;
+    cbor_reader_init(&reader, (slice_t){.len = sizeof(request), .ptr = request});
+
+    TEST_ASSERT(!cbor_reader_enter(&reader).is_error && reader.depth == 1, "Entered the request map");
+
+    slice_t sn = {0};
+    int64_t fn = 0, parameter_sum = 0;
+    while (!cbor_reader_at_end(&reader)) {
+        cbor_parse_result_t key = cbor_reader_next(&reader);
+        if (key.is_error) {
+            break;
+        }
+        if (key_is(key, "d")) {
+            cbor_reader_enter(&reader);
+            while (!cbor_reader_at_end(&reader)) {
+                cbor_parse_result_t device_key = cbor_reader_next(&reader);
+                cbor_parse_result_t device_value = cbor_reader_next(&reader);
+                if (key_is(device_key, "sn") && !device_value.is_error) {
+                    sn = device_value.ok.value.bytes;
+                }
+            }
+            cbor_reader_leave(&reader);
+        }
+        else if (key_is(key, "r")) {
+            cbor_reader_enter(&reader);
+            cbor_parse_result_t parameters_key = cbor_reader_next(&reader);
+            if (key_is(parameters_key, "parameters")) {
+                cbor_reader_enter(&reader);
+                while (!cbor_reader_at_end(&reader)) {
+                    parameter_sum += cbor_reader_next(&reader).ok.value.integer;
+                }
+                cbor_reader_leave(&reader);
+            }
+            cbor_reader_leave(&reader);
+        }
+        else {
+            cbor_parse_result_t value = cbor_reader_next(&reader);
+            if (key_is(key, "fn") && !value.is_error) {
+                fn = value.ok.value.integer;
+            }
+        }
+    }
+    cbor_process_result_t end = cbor_reader_leave(&reader);
+
+    TEST_ASSERT(sn.len == 3 && memcmp(sn.ptr, "123", 3) == 0, "d.sn read");
+    TEST_ASSERT(fn == 3, "fn read");
+    TEST_ASSERT(parameter_sum == 3, "r.parameters read");
+    TEST_ASSERT(!end.is_error && end.ok == request + sizeof(request), "Leaving the root ends after the document");
+    TEST_ASSERT(reader.depth == 0 && cbor_reader_at_end(&reader), "Reader is at the end of the buffer");
+}
+
+// Test 2: Skipping over containers
+void test_reader_skip() {
+    printf("\n=== Testing Reader Skip ===\n");
+
+    cbor_reader_t reader;
+    cbor_reader_init(&reader, (slice_t){.len = sizeof(request), .ptr = request});
+    cbor_reader_enter(&reader);
+
+    cbor_reader_next(&reader);  // "d"
+    cbor_parse_result_t device = cbor_reader_next(&reader);
+    TEST_ASSERT(!device.is_error && device.ok.type == CBOR_TYPE_MAP, "Next returns the nested map");
+    TEST_ASSERT(device.ok.next == request + 16, "Skipped map has its next pointer set");
+
+    cbor_parse_result_t peeked = cbor_reader_peek(&reader);
+    cbor_parse_result_t key = cbor_reader_next(&reader);
+    TEST_ASSERT(key_is(peeked, "fn") && key_is(key, "fn"), "Peek returns the item next will return");
+
+    // Leave without reading the remaining pair
+    cbor_process_result_t end = cbor_reader_leave(&reader);
+    TEST_ASSERT(!end.is_error && end.ok == request + sizeof(request), "Leave skips unread items");
+}
+
+// Test 3: Indefinite containers and top level sequences
+void test_reader_indefinite() {
+    printf("\n=== Testing Reader Indefinite Length ===\n");
+
+    // [_ 1, {_ "a": [_ ]}, 2] 7
+    uint8_t data[] = {0x9F, 0x01, 0xBF, 0x61, 0x61, 0x9F, 0xFF, 0xFF, 0x02, 0xFF, 0x07};
+
+    cbor_reader_t reader;
+    cbor_reader_init(&reader, (slice_t){.len = sizeof(data), .ptr = data});
+    cbor_parse_result_t array = cbor_reader_enter(&reader);
+    TEST_ASSERT(!array.is_error && array.ok.value.array.length == CBOR_LENGTH_INDEFINITE, "Entered indefinite array");
+
+    int count = 0;
+    while (!cbor_reader_at_end(&reader)) {
+        if (cbor_reader_next(&reader).is_error) {
+            break;
+        }
+        count++;
+    }
+    TEST_ASSERT(count == 3, "Indefinite array has 3 items");
+    TEST_ASSERT(!cbor_reader_leave(&reader).is_error, "Left indefinite array");
+
+    cbor_parse_result_t trailing = cbor_reader_next(&reader);
+    TEST_ASSERT(!trailing.is_error && trailing.ok.value.integer == 7, "Top level reads the following item");
+    TEST_ASSERT(cbor_reader_at_end(&reader), "Top level ends with the buffer");
+    TEST_ASSERT(cbor_reader_next(&reader).is_error, "Reading past the end fails");
+}
+
+// Test 4: Errors
+void test_reader_errors() {
+    printf("\n=== Testing Reader Errors ===\n");
+
+    cbor_reader_t reader;
+
+    // [1, "<missing>"]
+    uint8_t truncated[] = {0x82, 0x01, 0x61};
+    cbor_reader_init(&reader, (slice_t){.len = sizeof(truncated), .ptr = truncated});
+    TEST_ASSERT(!cbor_reader_enter(&reader).is_error, "Entered truncated array");
+    cbor_reader_next(&reader);
+    TEST_ASSERT(!cbor_reader_at_end(&reader), "Truncated array is not at its end");
+    cbor_parse_result_t missing = cbor_reader_next(&reader);
+    TEST_ASSERT(missing.is_error && missing.err == BUFFER_OVERFLOW_ERROR, "Truncated element reported");
+
+    cbor_reader_init(&reader, (slice_t){.len = sizeof(truncated), .ptr = truncated});
+    cbor_reader_enter(&reader);
+    cbor_process_result_t left = cbor_reader_leave(&reader);
+    TEST_ASSERT(left.is_error && left.err == BUFFER_OVERFLOW_ERROR, "Leaving a truncated array fails");
+
+    uint8_t impossible[] = {0x9A, 0x00, 0x01, 0x00, 0x00, 0x01};
+    cbor_reader_init(&reader, (slice_t){.len = sizeof(impossible), .ptr = impossible});
+    TEST_ASSERT(cbor_reader_enter(&reader).is_error, "Impossible element count rejected");
+
+    // {_ 1}, a key without a value
+    uint8_t odd_map[] = {0xBF, 0x01, 0xFF};
+    cbor_reader_init(&reader, (slice_t){.len = sizeof(odd_map), .ptr = odd_map});
+    cbor_reader_enter(&reader);
+    cbor_reader_next(&reader);
+    left = cbor_reader_leave(&reader);
+    TEST_ASSERT(left.is_error && left.err == MALFORMED_INPUT_ERROR, "Odd indefinite map rejected");
+
+    // {_ 1: [2]}
+    uint8_t pair_map[] = {0xBF, 0x01, 0x81, 0x02, 0xFF};
+    cbor_reader_init(&reader, (slice_t){.len = sizeof(pair_map), .ptr = pair_map});
+    cbor_reader_enter(&reader);
+    left = cbor_reader_leave(&reader);
+    TEST_ASSERT(!left.is_error && left.ok == pair_map + sizeof(pair_map), "Even indefinite map accepted");
+
+    uint8_t integer[] = {0x01};
+    cbor_reader_init(&reader, (slice_t){.len = sizeof(integer), .ptr = integer});
+    TEST_ASSERT(cbor_reader_enter(&reader).is_error, "Entering an integer fails");
+    TEST_ASSERT(cbor_reader_leave(&reader).is_error, "Leaving the top level fails");
+
+    uint8_t deep[CBOR_MAX_DEPTH + 2];
+    memset(deep, 0x81, sizeof(deep) - 1);
+    deep[sizeof(deep) - 1] = 0x00;
+    cbor_reader_init(&reader, (slice_t){.len = sizeof(deep), .ptr = deep});
+    cbor_parse_result_t entered = {0};
+    for (size_t i = 0; i <= CBOR_MAX_DEPTH; i++) {
+        entered = cbor_reader_enter(&reader);
+    }
+    TEST_ASSERT(entered.is_error && entered.err == DEPTH_LIMIT_ERROR, "Nesting deeper than CBOR_MAX_DEPTH rejected");
+}
+
+int main() {
+    printf("Testing CBOR Reader\n");
+    printf("===================\n");
+
+    test_reader_walk();
+    test_reader_skip();
+    test_reader_indefinite();
+    test_reader_errors();
+
+    printf("\n=== Test Results ===\n");
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    if (tests_failed == 0) {
+        printf("🎉 All tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed!\n");
+        return 1;
+    }
+}
@@ -0,0 +1,145 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cbor.h"
+#include "seq.h"
+#include "test.h"
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// 1, [1, [2, 3]], "abc", {_ "a": 1}, h''
+uint8_t sequence[] = {
+    0x01,
+    0x82, 0x01, 0x82, 0x02, 0x03,
+    0x63, 'a', 'b', 'c',
+    0xBF, 0x61, 'a', 0x01, 0xFF,
+    0x40,
+};
+
+// Test 1: Walking a sequence
+void test_seq_iterate() {
+    printf("\n=== Testing Sequence Iteration ===\n");
+
+    const size_t starts[] = {0, 1, 6, 10, 15};
+    const size_t lens[] = {1, 5, 4, 5, 1};
+
+    cbor_seq_iter_t iter;
+    cbor_seq_init(&iter, (slice_t){.len = sizeof(sequence), .ptr = sequence}, 0);
+
+    size_t count = 0;
+    int spans_match = 1;
+    cbor_seq_next_result_t item;
+    while (!(item = cbor_seq_next(&iter)).is_error) {
+        if (count >= 5 || item.ok.ptr != sequence + starts[count] || item.ok.len != lens[count]) {
+            spans_match = 0;
+        }
+        count++;
+    }
+    TEST_ASSERT(count == 5, "Five items found");
+    TEST_ASSERT(spans_match, "Item spans match");
+    TEST_ASSERT(item.err == EMPTY_BUFFER_ERROR && cbor_seq_at_end(&iter), "Sequence ends with EMPTY_BUFFER_ERROR");
+
+    cbor_parse_result_t parsed = cbor_parse((slice_t){.len = lens[1], .ptr = sequence + starts[1]});
+    TEST_ASSERT(!parsed.is_error && parsed.ok.type == CBOR_TYPE_ARRAY, "Returned span parses");
+
+    cbor_seq_init(&iter, (slice_t){.len = 0, .ptr = sequence}, 0);
+    item = cbor_seq_next(&iter);
+    TEST_ASSERT(item.is_error && item.err == EMPTY_BUFFER_ERROR, "Empty sequence");
+}
+
+// Test 2: Truncated and corrupt items
+void test_seq_errors() {
+    printf("\n=== Testing Sequence Errors ===\n");
+
+    // Last item cut off
+    cbor_seq_iter_t iter;
+    cbor_seq_init(&iter, (slice_t){.len = 8, .ptr = sequence}, 0);
+    cbor_seq_next(&iter);
+    cbor_seq_next(&iter);
+    cbor_seq_next_result_t item = cbor_seq_next(&iter);
+    TEST_ASSERT(item.is_error && item.err == BUFFER_OVERFLOW_ERROR, "Truncated item reported");
+    slice_t rest = cbor_seq_rest(&iter);
+    TEST_ASSERT(rest.ptr == sequence + 6 && rest.len == 2, "Truncated item left in rest");
+    item = cbor_seq_next(&iter);
+    TEST_ASSERT(item.is_error && item.err == BUFFER_OVERFLOW_ERROR, "Iterator stays in front of the error");
+
+    // 1, break, reserved, [2, 3], 4
+    uint8_t corrupt[] = {0x01, 0xFF, 0x1C, 0x82, 0x02, 0x03, 0x04};
+    cbor_seq_init(&iter, (slice_t){.len = sizeof(corrupt), .ptr = corrupt}, 0);
+    cbor_seq_next(&iter);
+    item = cbor_seq_next(&iter);
+    TEST_ASSERT(item.is_error && item.err == MALFORMED_INPUT_ERROR, "Corrupt item stops the iterator");
+
+    cbor_seq_init(&iter, (slice_t){.len = sizeof(corrupt), .ptr = corrupt}, CBOR_SEQ_RESYNC);
+    item = cbor_seq_next(&iter);
+    TEST_ASSERT(!item.is_error && item.ok.ptr == corrupt, "First item before the damage");
+    item = cbor_seq_next(&iter);
+    TEST_ASSERT(!item.is_error && item.ok.ptr == corrupt + 3 && item.ok.len == 3, "Resynchronized at the array");
+    TEST_ASSERT(iter.skipped == 2, "Two bytes dropped");
+    item = cbor_seq_next(&iter);
+    TEST_ASSERT(!item.is_error && item.ok.ptr == corrupt + 6, "Items after the damage found");
+    item = cbor_seq_next(&iter);
+    TEST_ASSERT(item.is_error && item.err == EMPTY_BUFFER_ERROR, "Sequence ends after resync");
+
+    // Nothing decodes after the damage
+    uint8_t tail[] = {0x01, 0x1C, 0x1D, 0xFF};
+    cbor_seq_init(&iter, (slice_t){.len = sizeof(tail), .ptr = tail}, CBOR_SEQ_RESYNC);
+    cbor_seq_next(&iter);
+    item = cbor_seq_next(&iter);
+    TEST_ASSERT(item.is_error && item.err == EMPTY_BUFFER_ERROR && iter.skipped == 3, "Damaged tail dropped");
+
+    // A stray indefinite array header in front of a long run of items
+    size_t count = 4 * CBOR_SEQ_RESYNC_WINDOW;
+    uint8_t* stray = malloc(count + 1);
+    stray[0] = 0x9F;
+    memset(stray + 1, 0x01, count);
+    cbor_seq_init(&iter, (slice_t){.len = count + 1, .ptr = stray}, CBOR_SEQ_RESYNC);
+    size_t found = 0;
+    while (!cbor_seq_next(&iter).is_error) {
+        found++;
+    }
+    TEST_ASSERT(found == count && iter.skipped == 1, "Stray 0x9F dropped alone");
+    free(stray);
+
+    // A valid item longer than the window is still one item
+    size_t payload = CBOR_SEQ_RESYNC_WINDOW + 4464;
+    uint8_t* large = malloc(payload + 6);
+    large[0] = 0x5A;
+    large[1] = (uint8_t)(payload >> 24);
+    large[2] = (uint8_t)(payload >> 16);
+    large[3] = (uint8_t)(payload >> 8);
+    large[4] = (uint8_t)payload;
+    memset(large + 5, 0x01, payload);
+    large[payload + 5] = 0x01;
+    cbor_seq_init(&iter, (slice_t){.len = payload + 6, .ptr = large}, CBOR_SEQ_RESYNC);
+    item = cbor_seq_next(&iter);
+    TEST_ASSERT(!item.is_error && item.ok.len == payload + 5, "Item longer than the window returned whole");
+    item = cbor_seq_next(&iter);
+    TEST_ASSERT(!item.is_error && item.ok.len == 1 && iter.skipped == 0, "Item after it found");
+    TEST_ASSERT(cbor_seq_next(&iter).err == EMPTY_BUFFER_ERROR, "Sequence ends after the large item");
+    free(large);
+}
+
+int main() {
+    printf("Testing CBOR Sequences\n");
+    printf("======================\n");
+
+    test_seq_iterate();
+    test_seq_errors();
+
+    printf("\n=== Test Results ===\n");
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    if (tests_failed == 0) {
+        printf("🎉 All tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed!\n");
+        return 1;
+    }
+}
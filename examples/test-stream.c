@@ -0,0 +1,189 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cbor.h"
+#include "stream.h"
+#include "test.h"
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// {"a": [1, -300, 1.5], "s": (_ h'0102', h'03'), "t": 1(1700000000), "m": {}, "x": "hello world"} "next"
+uint8_t document[] = {
+    0xA5,
+    0x61, 0x61, 0x83, 0x01, 0x39, 0x01, 0x2B, 0xF9, 0x3E, 0x00,
+    0x61, 0x73, 0x5F, 0x42, 0x01, 0x02, 0x41, 0x03, 0xFF,
+    0x61, 0x74, 0xC1, 0x1A, 0x65, 0x53, 0xF1, 0x00,
+    0x61, 0x6D, 0xA0,
+    0x61, 0x78, 0x6B, 0x68, 0x65, 0x6C, 0x6C, 0x6F, 0x20, 0x77, 0x6F, 0x72, 0x6C, 0x64,
+    0x64, 0x6E, 0x65, 0x78, 0x74
+};
+
+// Flattens events into text so runs with different chunking can be compared.
+// Consecutive DATA events are joined, since chunk boundaries split strings differently.
+typedef struct {
+    char text[1024];
+    size_t len;
+    int items;       // Top level items completed
+    int in_data;
+} event_log_t;
+
+static void log_event(event_log_t* log, const cbor_stream_event_t* event) {
+    if (event->type != CBOR_STREAM_DATA && log->in_data) {
+        log->len += snprintf(log->text + log->len, sizeof(log->text) - log->len, "] ");
+        log->in_data = 0;
+    }
+    switch (event->type) {
+    case CBOR_STREAM_VALUE:
+        log->len += snprintf(log->text + log->len, sizeof(log->text) - log->len, "V%d:%d:%lld ",
+            event->depth, event->value.type, (long long)(event->value.type == CBOR_TYPE_FLOAT ? (long long)(cbor_value_double(&event->value) * 10) : event->value.value.integer));
+        break;
+    case CBOR_STREAM_START:
+        log->len += snprintf(log->text + log->len, sizeof(log->text) - log->len, "S%d:%d:%llu ",
+            event->depth, event->major, (unsigned long long)event->length);
+        break;
+    case CBOR_STREAM_DATA:
+        if (!log->in_data) {
+            log->len += snprintf(log->text + log->len, sizeof(log->text) - log->len, "D%d[", event->depth);
+            log->in_data = 1;
+        }
+        for (size_t i = 0; i < event->data.len; i++) {
+            log->len += snprintf(log->text + log->len, sizeof(log->text) - log->len, "%02x", event->data.ptr[i]);
+        }
+        break;
+    case CBOR_STREAM_END:
+        log->len += snprintf(log->text + log->len, sizeof(log->text) - log->len, "E%d:%d ", event->depth, event->major);
+        break;
+    case CBOR_STREAM_TAG:
+        log->len += snprintf(log->text + log->len, sizeof(log->text) - log->len, "T%d:%llu ",
+            event->depth, (unsigned long long)event->tag);
+        break;
+    default:
+        break;
+    }
+}
+
+// Feeds data in chunks of the given size, returns 0 on a parser error
+static int run_stream(const uint8_t* data, size_t len, size_t chunk_size, event_log_t* log) {
+    cbor_stream_t stream;
+    cbor_stream_init(&stream);
+    memset(log, 0, sizeof(*log));
+
+    for (size_t offset = 0; offset < len; offset += chunk_size) {
+        slice_t chunk = {
+            .len = len - offset < chunk_size ? len - offset : chunk_size,
+            .ptr = (uint8_t*)data + offset,
+        };
+        for (;;) {
+            cbor_stream_result_t result = cbor_stream_next(&stream, &chunk);
+            if (result.is_error) {
+                return 0;
+            }
+            if (result.ok.type == CBOR_STREAM_NEED_MORE) {
+                break;
+            }
+            log_event(log, &result.ok);
+            if (cbor_stream_idle(&stream)) {
+                log->items++;
+            }
+        }
+    }
+    log_event(log, &(cbor_stream_event_t){.type = CBOR_STREAM_NEED_MORE});
+    return cbor_stream_idle(&stream);
+}
+
+// Test 1: Events for a whole buffer
+void test_stream_events() {
+    printf("\n=== Testing Stream Events ===\n");
+
+    event_log_t log;
+    int complete = run_stream(document, sizeof(document), sizeof(document), &log);
+    printf("%s\n", log.text);
+
+    TEST_ASSERT(complete, "Whole document decoded");
+    TEST_ASSERT(log.items == 2, "Two top level items reported");
+    TEST_ASSERT(strstr(log.text, "S0:5:5 ") == log.text, "Starts with a map of 5 pairs at depth 0");
+    TEST_ASSERT(strstr(log.text, "V2:0:-300 ") != NULL, "Negative integer inside the array at depth 2");
+    TEST_ASSERT(strstr(log.text, "V2:8:15 ") != NULL, "Half float decoded");
+    TEST_ASSERT(strstr(log.text, "S1:2:18446744073709551615 D1[010203] E1:2 ") != NULL, "Indefinite byte string chunks joined");
+    TEST_ASSERT(strstr(log.text, "T1:1 V2:0:1700000000 ") != NULL, "Tag followed by its content");
+    TEST_ASSERT(strstr(log.text, "S1:5:0 E1:5 ") != NULL, "Empty map starts and ends");
+    TEST_ASSERT(strstr(log.text, "E0:5 S0:3:4 D0[6e657874] E0:3 ") != NULL, "Second item follows the first");
+}
+
+// Test 2: Every chunk size gives the same events
+void test_stream_chunking() {
+    printf("\n=== Testing Stream Chunking ===\n");
+
+    event_log_t whole, chunked;
+    run_stream(document, sizeof(document), sizeof(document), &whole);
+
+    int all_match = 1;
+    for (size_t chunk_size = 1; chunk_size < sizeof(document); chunk_size++) {
+        int complete = run_stream(document, sizeof(document), chunk_size, &chunked);
+        if (!complete || chunked.items != whole.items || strcmp(chunked.text, whole.text) != 0) {
+            printf("Chunk size %zu differs:\n%s\n", chunk_size, chunked.text);
+            all_match = 0;
+        }
+    }
+    TEST_ASSERT(all_match, "Byte by byte and chunked input give the same events");
+
+    // Multi byte headers split in the middle
+    uint8_t big[] = {0x1B, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    int complete = run_stream(big, sizeof(big), 1, &chunked);
+    TEST_ASSERT(complete && strstr(chunked.text, "V0:0:72623859790382856 ") != NULL, "8 byte argument resumed across chunks");
+}
+
+// Test 3: Partial input and errors
+void test_stream_errors() {
+    printf("\n=== Testing Stream Errors ===\n");
+
+    TEST_ASSERT(sizeof(cbor_stream_t) <= 128, "Stream state fits in 128 bytes");
+
+    event_log_t log;
+    TEST_ASSERT(!run_stream(document, sizeof(document) - 3, 7, &log), "Truncated input is not complete");
+
+    uint8_t stray_break[] = {0x82, 0x01, 0xFF};
+    TEST_ASSERT(!run_stream(stray_break, sizeof(stray_break), 1, &log), "Break in definite array rejected");
+
+    uint8_t bad_chunk[] = {0x5F, 0x61, 0x61, 0xFF};
+    TEST_ASSERT(!run_stream(bad_chunk, sizeof(bad_chunk), 1, &log), "Text chunk in byte string rejected");
+
+    uint8_t odd_map[] = {0xBF, 0x01, 0xFF};
+    TEST_ASSERT(!run_stream(odd_map, sizeof(odd_map), 1, &log), "Odd indefinite map rejected");
+
+    uint8_t tagged_value[] = {0xBF, 0x01, 0xC6, 0x02, 0xFF};
+    TEST_ASSERT(run_stream(tagged_value, sizeof(tagged_value), 2, &log), "Tagged value in indefinite map accepted");
+
+    uint8_t reserved[] = {0x1C};
+    TEST_ASSERT(!run_stream(reserved, sizeof(reserved), 1, &log), "Reserved additional info rejected");
+
+    uint8_t deep[CBOR_MAX_DEPTH + 2];
+    memset(deep, 0x81, sizeof(deep) - 1);
+    deep[sizeof(deep) - 1] = 0x00;
+    TEST_ASSERT(!run_stream(deep, sizeof(deep), 4, &log), "Nesting deeper than CBOR_MAX_DEPTH rejected");
+}
+
+int main() {
+    printf("Testing CBOR Streaming Parser\n");
+    printf("=============================\n");
+
+    test_stream_events();
+    test_stream_chunking();
+    test_stream_errors();
+
+    printf("\n=== Test Results ===\n");
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    if (tests_failed == 0) {
+        printf("🎉 All tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed!\n");
+        return 1;
+    }
+}
@@ -232,6 +232,83 @@ int test_processing_stress() {
     return 1;
 }
 
+// Test 6: Validation with limits
+int test_validate_stress() {
+    printf("\n=== Testing Validation ===\n");
+
+    // Every dataset validates and reports its exact length, every truncation is rejected
+    for (size_t dataset_idx = 0; dataset_idx < sizeof(test_datasets) / sizeof(test_datasets[0]); dataset_idx++) {
+        test_data_t* dataset = &test_datasets[dataset_idx];
+
+        cbor_validate_result_t result = cbor_validate((slice_t){.len = dataset->len, .ptr = dataset->data}, NULL);
+        TEST_ASSERT(!result.is_error && result.ok == dataset->len, "Valid data validates to its full length");
+
+        int truncations_rejected = 1;
+        for (size_t truncated_len = 1; truncated_len < dataset->len; truncated_len++) {
+            result = cbor_validate((slice_t){.len = truncated_len, .ptr = dataset->data}, NULL);
+            truncations_rejected &= result.is_error;
+        }
+        TEST_ASSERT(truncations_rejected, "Truncated data is rejected");
+    }
+
+    // Trailing bytes are not part of the item
+    uint8_t trailing[] = {0x82, 0x01, 0x02, 0x03};
+    cbor_validate_result_t result = cbor_validate((slice_t){.len = sizeof(trailing), .ptr = trailing}, NULL);
+    TEST_ASSERT(!result.is_error && result.ok == 3, "End offset excludes trailing bytes");
+
+    // Limits
+    slice_t nested = {.len = sizeof(valid_cbor_nested), .ptr = valid_cbor_nested};
+    cbor_limits_t limits = {.max_depth = 1};
+    result = cbor_validate(nested, &limits);
+    TEST_ASSERT(result.is_error && result.err == DEPTH_LIMIT_ERROR, "Depth limit enforced");
+
+    limits = (cbor_limits_t){.max_depth = 2, .max_items = 12};
+    result = cbor_validate(nested, &limits);
+    TEST_ASSERT(!result.is_error, "Item count at the limit accepted");
+    limits.max_items = 11;
+    result = cbor_validate(nested, &limits);
+    TEST_ASSERT(result.is_error && result.err == LIMIT_EXCEEDED_ERROR, "Item limit enforced");
+
+    limits = (cbor_limits_t){.max_string_length = 4};
+    result = cbor_validate(nested, &limits);
+    TEST_ASSERT(result.is_error && result.err == LIMIT_EXCEEDED_ERROR, "String length limit enforced");
+
+    // (_ "ab" "cd" "e") is 5 bytes in total
+    uint8_t chunked[] = {0x7F, 0x62, 0x61, 0x62, 0x62, 0x63, 0x64, 0x61, 0x65, 0xFF};
+    limits = (cbor_limits_t){.max_string_length = 4};
+    result = cbor_validate((slice_t){.len = sizeof(chunked), .ptr = chunked}, &limits);
+    TEST_ASSERT(result.is_error && result.err == LIMIT_EXCEEDED_ERROR, "Indefinite string chunks count together");
+
+    // Not well-formed input that a byte count alone would accept
+    uint8_t odd_map[] = {0xBF, 0x01, 0xFF};
+    uint8_t tag_before_break[] = {0x9F, 0xC1, 0xFF};
+    uint8_t short_simple[] = {0xF8, 0x10};
+    uint8_t mixed_chunks[] = {0x5F, 0x61, 0x61, 0xFF};
+    uint8_t* malformed[] = {odd_map, tag_before_break, short_simple, mixed_chunks};
+    size_t malformed_len[] = {sizeof(odd_map), sizeof(tag_before_break), sizeof(short_simple), sizeof(mixed_chunks)};
+    for (size_t i = 0; i < sizeof(malformed) / sizeof(malformed[0]); i++) {
+        result = cbor_validate((slice_t){.len = malformed_len[i], .ptr = malformed[i]}, NULL);
+        TEST_ASSERT(result.is_error && result.err == MALFORMED_INPUT_ERROR, "Malformed item rejected");
+    }
+
+    // Random data never reads out of bounds
+    uint8_t random_data[64];
+    for (size_t test_idx = 0; test_idx < 10000; test_idx++) {
+        size_t buffer_size = 1 + (rand() % sizeof(random_data));
+        for (size_t i = 0; i < buffer_size; i++) {
+            random_data[i] = (uint8_t)(rand() % 256);
+        }
+        result = cbor_validate((slice_t){.len = buffer_size, .ptr = random_data}, NULL);
+        if (!result.is_error && result.ok > buffer_size) {
+            TEST_ASSERT(0, "Validated length within the buffer");
+            break;
+        }
+    }
+    TEST_ASSERT(1, "Random data validation completed without crashes");
+
+    return 1;
+}
+
 int main() {
     printf("CBOR Library - Stress Test Suite\n");
     printf("=================================\n");
@@ -243,6 +320,7 @@ int main() {
     test_edge_case_buffers();
     test_malformed_headers();
     test_processing_stress();
+    test_validate_stress();
     
     // Print summary
     printf("\n=== Stress Test Summary ===\n");
@@ -0,0 +1,295 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cbor.h"
+#include "struct.h"
+#include "test.h"
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+typedef struct {
+    slice_t f;
+    slice_t sn;
+} device_t;
+
+typedef struct {
+    device_t d;
+    int32_t fn;
+    int8_t offset;
+    uint16_t port;
+    uint64_t counter;
+    bool enabled;
+    float ratio;
+    slice_t blob;
+    slice_t extra;
+    uint32_t parameters;
+} message_t;
+
+#define DEVICE_FIELDS      \
+    X(f, CBOR_FIELD_TEXT)  \
+    X(sn, CBOR_FIELD_TEXT)
+
+static const cbor_field_t device_fields[] = {
+    #define X(name, kind) CBOR_FIELD(device_t, name, kind, CBOR_FIELD_REQUIRED),
+    DEVICE_FIELDS
+    #undef X
+};
+static const cbor_struct_schema_t device_schema = CBOR_STRUCT_SCHEMA(device_fields);
+
+#define X(name, key) CBOR_KEY_ID(name, key)
+#define PARAMETER_KEYS X(rds, 0) X(fw, 1) X(mes, 2) X(m, 3)
+CBOR_KEY_LOOKUP_FUNCTION(parameter_id, PARAMETER_KEYS)
+#undef X
+#define X(name, key) CBOR_KEY_NAME(name, key)
+CBOR_KEY_NAME_FUNCTION(parameter_name, PARAMETER_KEYS)
+#undef X
+
+static const cbor_field_t message_fields[] = {
+    CBOR_FIELD_MAP("d", message_t, d, device_schema, CBOR_FIELD_REQUIRED),
+    CBOR_FIELD(message_t, fn, CBOR_FIELD_INT, CBOR_FIELD_REQUIRED),
+    CBOR_FIELD(message_t, offset, CBOR_FIELD_INT, 0),
+    CBOR_FIELD(message_t, port, CBOR_FIELD_UINT, 0),
+    CBOR_FIELD(message_t, counter, CBOR_FIELD_UINT, 0),
+    CBOR_FIELD(message_t, enabled, CBOR_FIELD_BOOL, 0),
+    CBOR_FIELD(message_t, ratio, CBOR_FIELD_FLOAT, 0),
+    CBOR_FIELD(message_t, blob, CBOR_FIELD_BYTES, 0),
+    CBOR_FIELD_KEY("x", message_t, extra, CBOR_FIELD_ITEM, 0),
+    CBOR_FIELD_KEY_BITMAP("p", message_t, parameters, parameter_id, parameter_name, CBOR_FIELD_REQUIRED),
+};
+static const cbor_struct_schema_t message_schema = CBOR_STRUCT_SCHEMA(message_fields);
+
+enum { FIELD_D, FIELD_FN, FIELD_P = 9 };
+
+static cbor_process_result_t decode(uint8_t* data, size_t len, message_t* message, uint64_t* missing) {
+    memset(message, 0, sizeof(*message));
+    cbor_parse_result_t map = cbor_parse((slice_t){.len = len, .ptr = data});
+    if (map.is_error) {
+        return ERR(cbor_process_result_t, map.err);
+    }
+    if (map.ok.type != CBOR_TYPE_MAP) {
+        return ERR(cbor_process_result_t, TYPE_MISMATCH_ERROR);
+    }
+    return cbor_decode_struct(map.ok.value.map, &message_schema, message, missing);
+}
+
+// Test 1: Every field kind
+void test_decode_struct() {
+    printf("\n=== Testing Struct Decode ===\n");
+
+    // {"p": ["fw", "zz", "m"], "x": [1, {}], "blob": h'0102', "ratio": 1.5,
+    //  "enabled": true, "counter": 2^40, "port": 8080, "offset": -128,
+    //  "fn": -70000, "unknown": 1, 7: 1, "d": {"sn": "A1", "f": "fw"}}
+    uint8_t data[] = {
+        0xAC,
+        0x61, 'p', 0x83, 0x62, 'f', 'w', 0x62, 'z', 'z', 0x61, 'm',
+        0x61, 'x', 0x82, 0x01, 0xA0,
+        0x64, 'b', 'l', 'o', 'b', 0x42, 0x01, 0x02,
+        0x65, 'r', 'a', 't', 'i', 'o', 0xF9, 0x3E, 0x00,
+        0x67, 'e', 'n', 'a', 'b', 'l', 'e', 'd', 0xF5,
+        0x67, 'c', 'o', 'u', 'n', 't', 'e', 'r', 0x1B, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x64, 'p', 'o', 'r', 't', 0x19, 0x1F, 0x90,
+        0x66, 'o', 'f', 'f', 's', 'e', 't', 0x38, 0x7F,
+        0x62, 'f', 'n', 0x3A, 0x00, 0x01, 0x11, 0x6F,
+        0x67, 'u', 'n', 'k', 'n', 'o', 'w', 'n', 0x01,
+        0x07, 0x01,
+        0x61, 'd', 0xA2, 0x62, 's', 'n', 0x62, 'A', '1', 0x61, 'f', 0x62, 'f', 'w',
+    };
+
+    message_t message;
+    uint64_t missing = UINT64_MAX;
+    cbor_process_result_t result = decode(data, sizeof(data), &message, &missing);
+    TEST_ASSERT(!result.is_error && result.ok == data + sizeof(data), "Whole map decoded");
+    TEST_ASSERT(missing == 0, "No required field missing");
+    TEST_ASSERT(message.parameters == ((1 << 1) | (1 << 3)), "Key bitmap decoded");
+    TEST_ASSERT(message.extra.ptr == data + 14 && message.extra.len == 3, "Raw item kept");
+    TEST_ASSERT(message.blob.len == 2 && message.blob.ptr[1] == 0x02, "Byte string decoded");
+    TEST_ASSERT(message.ratio == 1.5f, "Half float decoded");
+    TEST_ASSERT(message.enabled, "Bool decoded");
+    TEST_ASSERT(message.counter == (UINT64_C(1) << 40), "64 bit unsigned decoded");
+    TEST_ASSERT(message.port == 8080, "16 bit unsigned decoded");
+    TEST_ASSERT(message.offset == -128, "Lowest int8_t decoded");
+    TEST_ASSERT(message.fn == -70000, "Negative int32_t decoded");
+    TEST_ASSERT(message.d.sn.len == 2 && memcmp(message.d.sn.ptr, "A1", 2) == 0, "Nested text decoded");
+    TEST_ASSERT(message.d.f.len == 2 && memcmp(message.d.f.ptr, "fw", 2) == 0, "Nested fields in any order");
+}
+
+// Test 2: Missing required fields
+void test_decode_missing() {
+    printf("\n=== Testing Missing Fields ===\n");
+
+    message_t message;
+    uint64_t missing = 0;
+
+    // {"fn": 1, "port": null}
+    uint8_t partial[] = {0xA2, 0x62, 'f', 'n', 0x01, 0x64, 'p', 'o', 'r', 't', 0xF6};
+    cbor_process_result_t result = decode(partial, sizeof(partial), &message, &missing);
+    TEST_ASSERT(!result.is_error && message.fn == 1, "Partial map decoded");
+    TEST_ASSERT(missing == ((1u << FIELD_D) | (1u << FIELD_P)), "Missing d and p reported");
+
+    // {_ "d": {"f": "a"}, "fn": null, "p": []}
+    uint8_t nested[] = {0xBF, 0x61, 'd', 0xA1, 0x61, 'f', 0x61, 'a', 0x62, 'f', 'n', 0xF6, 0x61, 'p', 0x80, 0xFF};
+    result = decode(nested, sizeof(nested), &message, &missing);
+    TEST_ASSERT(!result.is_error && result.ok == nested + sizeof(nested), "Indefinite map decoded");
+    TEST_ASSERT(missing == ((1u << FIELD_D) | (1u << FIELD_FN)), "Incomplete nested map and null count as missing");
+    TEST_ASSERT(message.d.f.len == 1, "Fields of the incomplete nested map kept");
+
+    result = decode(nested, sizeof(nested), &message, NULL);
+    TEST_ASSERT(!result.is_error, "missing may be NULL");
+}
+
+// Test 3: Types and ranges
+void test_decode_errors() {
+    printf("\n=== Testing Decode Errors ===\n");
+
+    message_t message;
+    struct {
+        uint8_t data[16];
+        size_t len;
+        cbor_parser_error_t err;
+        const char* name;
+    } cases[] = {
+        {{0xA1, 0x62, 'f', 'n', 0x61, 'a'}, 6, TYPE_MISMATCH_ERROR, "Text for an integer"},
+        {{0xA1, 0x62, 'f', 'n', 0x1A, 0x80, 0x00, 0x00, 0x00}, 9, OUT_OF_RANGE_ERROR, "2^31 for int32_t"},
+        {{0xA1, 0x62, 'f', 'n', 0x3A, 0x80, 0x00, 0x00, 0x00}, 9, OUT_OF_RANGE_ERROR, "-2^31-1 for int32_t"},
+        {{0xA1, 0x66, 'o', 'f', 'f', 's', 'e', 't', 0x18, 0x80}, 10, OUT_OF_RANGE_ERROR, "128 for int8_t"},
+        {{0xA1, 0x64, 'p', 'o', 'r', 't', 0x1A, 0x00, 0x01, 0x00, 0x00}, 11, OUT_OF_RANGE_ERROR, "65536 for uint16_t"},
+        {{0xA1, 0x64, 'p', 'o', 'r', 't', 0x20}, 7, OUT_OF_RANGE_ERROR, "Negative for unsigned"},
+        {{0xA1, 0x67, 'e', 'n', 'a', 'b', 'l', 'e', 'd', 0x01}, 10, TYPE_MISMATCH_ERROR, "Integer for a bool"},
+        {{0xA1, 0x65, 'r', 'a', 't', 'i', 'o', 0x01}, 8, TYPE_MISMATCH_ERROR, "Integer for a float"},
+        {{0xA1, 0x64, 'b', 'l', 'o', 'b', 0x5F, 0x41, 0x00, 0xFF}, 10, TYPE_MISMATCH_ERROR, "Indefinite byte string"},
+        {{0xA1, 0x61, 'd', 0x80}, 4, TYPE_MISMATCH_ERROR, "Array for a nested map"},
+        {{0xA1, 0x61, 'p', 0xA0}, 4, TYPE_MISMATCH_ERROR, "Map for a key bitmap"},
+        {{0xA2, 0x62, 'f', 'n', 0x01}, 5, BUFFER_OVERFLOW_ERROR, "Truncated map"},
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        cbor_process_result_t result = decode(cases[i].data, cases[i].len, &message, NULL);
+        TEST_ASSERT(result.is_error && result.err == cases[i].err, cases[i].name);
+    }
+
+    // Schemas nesting themselves are cut off at CBOR_MAX_DEPTH
+    typedef struct { uint8_t unused; } self_t;
+    static cbor_struct_schema_t self_schema;
+    static const cbor_field_t self_fields[] = { CBOR_FIELD_INLINE_MAP("a", self_schema, 0) };
+    self_schema = (cbor_struct_schema_t) CBOR_STRUCT_SCHEMA(self_fields);
+    uint8_t deep[3 * (CBOR_MAX_DEPTH + 1) + 1];
+    for (size_t i = 0; i < CBOR_MAX_DEPTH + 1; i++) {
+        deep[3 * i] = 0xA1;
+        deep[3 * i + 1] = 0x61;
+        deep[3 * i + 2] = 'a';
+    }
+    deep[sizeof(deep) - 1] = 0xA0;
+    self_t self;
+    cbor_parse_result_t map = cbor_parse((slice_t){.len = sizeof(deep), .ptr = deep});
+    cbor_process_result_t result = cbor_decode_struct(map.ok.value.map, &self_schema, &self, NULL);
+    TEST_ASSERT(result.is_error && result.err == DEPTH_LIMIT_ERROR, "Recursive schema depth limited");
+}
+
+// Test 4: Encoding and decoding back
+void test_encode_struct() {
+    printf("\n=== Testing Struct Encode ===\n");
+
+    uint8_t item[] = {0x82, 0x01, 0xA0};
+    uint8_t blob[] = {0xDE, 0xAD};
+    message_t message = {
+        .d = {.f = STR2SLICE("fw"), .sn = STR2SLICE("A1")},
+        .fn = -70000,
+        .offset = -128,
+        .port = 8080,
+        .counter = UINT64_MAX,
+        .enabled = true,
+        .ratio = 1.5f,
+        .blob = {.len = sizeof(blob), .ptr = blob},
+        .extra = {.len = sizeof(item), .ptr = item},
+    };
+    const uint64_t all_but_bitmap = ((uint64_t)1 << FIELD_P) - 1;
+
+    uint8_t buf[128];
+    cbor_encode_result_t encoded = cbor_encode_struct(&message_schema, &message, all_but_bitmap, (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!encoded.is_error && encoded.ok.ptr == buf && buf[0] == 0xA9, "Map of nine fields encoded");
+
+    message_t decoded;
+    uint64_t missing = 0;
+    cbor_process_result_t result = decode(encoded.ok.ptr, encoded.ok.len, &decoded, &missing);
+    TEST_ASSERT(!result.is_error && result.ok == buf + encoded.ok.len, "Encoded map decodes");
+    TEST_ASSERT(missing == (1u << FIELD_P), "Only the unencoded bitmap missing");
+    TEST_ASSERT(decoded.fn == message.fn && decoded.offset == message.offset && decoded.port == message.port, "Integers round trip");
+    TEST_ASSERT(decoded.counter == UINT64_MAX, "Unsigned above INT64_MAX round trips");
+    TEST_ASSERT(decoded.enabled && decoded.ratio == 1.5f, "Bool and float round trip");
+    TEST_ASSERT(decoded.blob.len == 2 && memcmp(decoded.blob.ptr, blob, 2) == 0, "Bytes round trip");
+    TEST_ASSERT(decoded.extra.len == 3 && memcmp(decoded.extra.ptr, item, 3) == 0, "Raw item copied");
+    TEST_ASSERT(decoded.d.sn.len == 2 && memcmp(decoded.d.sn.ptr, "A1", 2) == 0, "Nested map round trips");
+
+    // {"fn": -70000} exactly
+    uint8_t expected[] = {0xA1, 0x62, 'f', 'n', 0x3A, 0x00, 0x01, 0x11, 0x6F};
+    encoded = cbor_encode_struct(&message_schema, &message, 1u << FIELD_FN, (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!encoded.is_error && encoded.ok.len == sizeof(expected) && memcmp(buf, expected, sizeof(expected)) == 0, "Single field encoding");
+
+    encoded = cbor_encode_struct_pairs(&message_schema, &message, 1u << FIELD_FN, (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!encoded.is_error && encoded.ok.len == sizeof(expected) - 1 && buf[0] == 0x62, "Pairs without header");
+
+    encoded = cbor_encode_struct(&message_schema, &message, 0, (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!encoded.is_error && encoded.ok.len == 1 && buf[0] == 0xA0, "Empty mask gives an empty map");
+
+    size_t rejected = 0;
+    for (size_t len = 0; len < sizeof(expected); len++) {
+        encoded = cbor_encode_struct(&message_schema, &message, 1u << FIELD_FN, (slice_t){.len = len, .ptr = buf});
+        rejected += encoded.is_error && encoded.err == CBOR_ENCODER_ERROR_BUFFER_OVERFLOW;
+    }
+    TEST_ASSERT(rejected == sizeof(expected), "Every short target rejected");
+
+    // {"p": ["fw", "m"]}
+    uint8_t expected_bitmap[] = {0xA1, 0x61, 'p', 0x82, 0x62, 'f', 'w', 0x61, 'm'};
+    message.parameters = (1 << 1) | (1 << 3);
+    encoded = cbor_encode_struct(&message_schema, &message, 1u << FIELD_P, (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!encoded.is_error && encoded.ok.len == sizeof(expected_bitmap) &&
+        memcmp(buf, expected_bitmap, sizeof(expected_bitmap)) == 0, "Key bitmap encoded as an array of names");
+
+    encoded = cbor_encode_struct(&message_schema, &message, CBOR_STRUCT_ALL_FIELDS, (slice_t){.len = sizeof(buf), .ptr = buf});
+    missing = 0;
+    result = decode(encoded.ok.ptr, encoded.ok.len, &decoded, &missing);
+    TEST_ASSERT(!encoded.is_error && !result.is_error && missing == 0, "All fields round trip");
+    TEST_ASSERT(decoded.parameters == message.parameters, "Key bitmap round trips");
+
+    message.parameters = 0;
+    encoded = cbor_encode_struct(&message_schema, &message, 1u << FIELD_P, (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!encoded.is_error && encoded.ok.len == 4 && buf[3] == 0x80, "Empty key bitmap encoded as an empty array");
+
+    message.parameters = 1 << 4;
+    encoded = cbor_encode_struct(&message_schema, &message, 1u << FIELD_P, (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(encoded.is_error && encoded.err == CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT, "Bit without a name rejected");
+
+    message.parameters = 1 << 1;
+    rejected = 0;
+    for (size_t len = 0; len < 7; len++) {
+        encoded = cbor_encode_struct(&message_schema, &message, 1u << FIELD_P, (slice_t){.len = len, .ptr = buf});
+        rejected += encoded.is_error && encoded.err == CBOR_ENCODER_ERROR_BUFFER_OVERFLOW;
+    }
+    TEST_ASSERT(rejected == 7, "Every short target rejected for a key bitmap");
+}
+
+int main() {
+    printf("Testing CBOR Structs\n");
+    printf("===================\n");
+
+    test_decode_struct();
+    test_decode_missing();
+    test_decode_errors();
+    test_encode_struct();
+
+    printf("\n=== Test Results ===\n");
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    if (tests_failed == 0) {
+        printf("🎉 All tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed!\n");
+        return 1;
+    }
+}
@@ -0,0 +1,424 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cbor.h"
+#include "tags.h"
+#include "test.h"
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// 1(1363896240)
+uint8_t epoch[] = {0xC1, 0x1A, 0x51, 0x4B, 0x67, 0xB0};
+
+// 55799(32("a:b")), a tag inside a tag
+uint8_t nested[] = {0xD9, 0xD9, 0xF7, 0xD8, 0x20, 0x63, 'a', ':', 'b'};
+
+// [1, 2([h'01']), 3]
+uint8_t tagged_in_array[] = {0x83, 0x01, 0xC2, 0x81, 0x41, 0x01, 0x03};
+
+// Test 1: Parsing tags
+void test_tag_parse() {
+    printf("\n=== Testing Tag Parsing ===\n");
+
+    cbor_parse_result_t tag = cbor_parse((slice_t){.len = sizeof(epoch), .ptr = epoch});
+    TEST_ASSERT(!tag.is_error && tag.ok.type == CBOR_TYPE_TAG && tag.ok.value.tag.number == CBOR_TAG_EPOCH_DATETIME, "Tag 1 parsed");
+    TEST_ASSERT(tag.ok.value.tag.content.ptr == epoch + 1 && tag.ok.value.tag.content.len == 5, "Content is a view of the tagged item");
+    TEST_ASSERT(tag.ok.next == epoch + sizeof(epoch), "Next is after the tagged item");
+
+    cbor_parse_result_t item = cbor_parse(tag.ok.value.tag.content);
+    TEST_ASSERT(!item.is_error && item.ok.value.integer == 1363896240, "Tagged item parsed");
+
+    tag = cbor_parse((slice_t){.len = sizeof(nested), .ptr = nested});
+    TEST_ASSERT(!tag.is_error && tag.ok.value.tag.number == CBOR_TAG_SELF_DESCRIBED && tag.ok.value.tag.content.len == 6,
+        "Two byte tag number");
+    item = cbor_parse(tag.ok.value.tag.content);
+    TEST_ASSERT(!item.is_error && item.ok.type == CBOR_TYPE_TAG && item.ok.value.tag.number == CBOR_TAG_URI &&
+        item.ok.value.tag.content.len == 4, "Nested tag");
+
+    // Errors
+    uint8_t truncated[] = {0xC1, 0x1A, 0x51};
+    TEST_ASSERT(cbor_parse((slice_t){.len = sizeof(truncated), .ptr = truncated}).err == BUFFER_OVERFLOW_ERROR, "Truncated tagged item");
+    TEST_ASSERT(cbor_parse((slice_t){.len = 1, .ptr = epoch}).err == BUFFER_OVERFLOW_ERROR, "Tag without an item");
+    uint8_t indefinite[] = {0xDF, 0x01};
+    TEST_ASSERT(cbor_parse((slice_t){.len = sizeof(indefinite), .ptr = indefinite}).err == MALFORMED_INPUT_ERROR, "Indefinite tag is malformed");
+}
+
+static cbor_custom_processor_result_t count_single(const cbor_value_t* value, void* arg) {
+    int* counts = arg;
+    counts[0]++;
+    counts[1] += value->type == CBOR_TYPE_TAG;
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+static cbor_custom_processor_result_t count_item(slice_t doc, const cbor_item_t* item, void* arg) {
+    (void)doc;
+    int* counts = arg;
+    counts[0]++;
+    counts[1] += item->type == CBOR_TYPE_TAG && item->value.tag == CBOR_TAG_POSITIVE_BIGNUM;
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+// Test 2: Tags inside containers
+void test_tag_in_containers() {
+    printf("\n=== Testing Tags In Containers ===\n");
+
+    slice_t doc = {.len = sizeof(tagged_in_array), .ptr = tagged_in_array};
+    cbor_parse_result_t array = cbor_parse(doc);
+    int counts[2] = {0};
+    cbor_process_result_t end = cbor_process_array(array.ok.value.array, count_single, counts);
+    TEST_ASSERT(!end.is_error && end.ok == tagged_in_array + sizeof(tagged_in_array) && counts[0] == 3 && counts[1] == 1,
+        "cbor_process_array steps over the tagged item");
+
+    cbor_array_get_result_t element = cbor_array_get(array.ok.value.array, 2);
+    TEST_ASSERT(!element.is_error && element.ok.ptr == tagged_in_array + 6, "cbor_array_get skips the tagged item");
+
+    cbor_parse_item_result_t root = cbor_parse_item(doc, 0);
+    memset(counts, 0, sizeof(counts));
+    end = cbor_process_array_items(doc, &root.ok, count_item, counts);
+    TEST_ASSERT(!end.is_error && counts[0] == 3 && counts[1] == 1, "Compact items report the tag number");
+
+    cbor_parse_item_result_t tag_item = cbor_parse_item(doc, 2);
+    TEST_ASSERT(!tag_item.is_error && tag_item.ok.header == 1 && tag_item.ok.value.tag == 2, "Tag item header");
+}
+
+// Test 3: Encoding tags
+void test_tag_encode() {
+    printf("\n=== Testing Tag Encoding ===\n");
+
+    uint8_t buf[32];
+    slice_t target = {.len = sizeof(buf), .ptr = buf};
+
+    static const struct {
+        uint64_t number;
+        size_t len;
+        uint8_t first;
+    } headers[] = {
+        {1, 1, 0xC1},
+        {32, 2, 0xD8},
+        {55799, 3, 0xD9},
+        {0x10000, 5, 0xDA},
+        {0x100000000ULL, 9, 0xDB},
+    };
+    int headers_match = 1;
+    for (size_t i = 0; i < sizeof(headers) / sizeof(headers[0]); i++) {
+        cbor_encode_result_t header = cbor_encode_tag(headers[i].number, target);
+        if (header.is_error || header.ok.len != headers[i].len || buf[0] != headers[i].first) {
+            headers_match = 0;
+        }
+        cbor_parse_item_result_t item = cbor_parse_item((slice_t){.len = header.ok.len + 1, .ptr = buf}, 0);
+        if (item.is_error || item.ok.value.tag != headers[i].number) {
+            headers_match = 0;
+        }
+    }
+    TEST_ASSERT(headers_match, "Tag headers use the shortest form");
+    TEST_ASSERT(cbor_encode_tag(55799, (slice_t){.len = 2, .ptr = buf}).err == CBOR_ENCODER_ERROR_BUFFER_OVERFLOW, "Tag header overflow");
+
+    // A value tagged through cbor_encode
+    cbor_value_t uri = {.type = CBOR_TYPE_TEXT_STRING, .value.bytes = STR2SLICE("a:b")};
+    cbor_value_t self_described_uri = CBOR_TAGGED(CBOR_TAG_URI, &uri);
+    cbor_encode_result_t encoded = cbor_encode(CBOR_TAGGED(CBOR_TAG_SELF_DESCRIBED, &self_described_uri), target);
+    TEST_ASSERT(!encoded.is_error && encoded.ok.len == sizeof(nested) && memcmp(buf, nested, sizeof(nested)) == 0, "Nested tagged value encoded");
+
+    // A parsed tag is written back unchanged
+    cbor_parse_result_t parsed = cbor_parse((slice_t){.len = sizeof(epoch), .ptr = epoch});
+    encoded = cbor_encode(parsed.ok, target);
+    TEST_ASSERT(!encoded.is_error && encoded.ok.len == sizeof(epoch) && memcmp(buf, epoch, sizeof(epoch)) == 0, "Parsed tag round trip");
+
+    encoded = cbor_encode(parsed.ok, (slice_t){.len = 4, .ptr = buf});
+    TEST_ASSERT(encoded.is_error && encoded.err == CBOR_ENCODER_ERROR_BUFFER_OVERFLOW, "Parsed tag overflow");
+}
+
+static cbor_custom_processor_result_t decode_epoch(uint64_t number, const cbor_value_t* item, void* decode_arg) {
+    (void)number;
+    if (item->type != CBOR_TYPE_INTEGER) {
+        return CUSTOM_PROCESSOR_ERR(CBOR_CUSTOM_PROCESSOR_ERROR_PARSER);
+    }
+    *(int64_t*)decode_arg = item->value.integer;
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+static custom_encoder_result_t encode_epoch(slice_t target, void* object) {
+    return cbor_encode_integer(*(int64_t*)object, target);
+}
+
+static cbor_custom_processor_result_t decode_uri(uint64_t number, const cbor_value_t* item, void* decode_arg) {
+    (void)number;
+    *(slice_t*)decode_arg = item->value.bytes;
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+static cbor_custom_processor_result_t decode_self_described(uint64_t number, const cbor_value_t* item, void* decode_arg) {
+    (void)number;
+    (void)item;
+    *(int*)decode_arg = 1;
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+
+// Test 4: Handler registry
+void test_tag_registry() {
+    printf("\n=== Testing Tag Registry ===\n");
+
+    static const cbor_tag_handler_t handlers[] = {
+        {.number = CBOR_TAG_EPOCH_DATETIME, .decode = decode_epoch, .encode = encode_epoch},
+        {.number = CBOR_TAG_URI, .decode = decode_uri},
+        {.number = CBOR_TAG_SELF_DESCRIBED, .decode = decode_self_described},
+    };
+    cbor_tag_registry_t registry;
+    cbor_tag_registry_init_result_t init = cbor_tag_registry_init(&registry, handlers, 3);
+    TEST_ASSERT(!init.is_error && init.ok == 3, "Registry built");
+    TEST_ASSERT(cbor_tag_find(&registry, CBOR_TAG_URI) == &handlers[1], "Direct lookup");
+    TEST_ASSERT(cbor_tag_find(&registry, CBOR_TAG_SELF_DESCRIBED) == &handlers[2], "Lookup above the direct table");
+    TEST_ASSERT(cbor_tag_find(&registry, CBOR_TAG_POSITIVE_BIGNUM) == NULL && cbor_tag_find(&registry, 1001) == NULL, "Unknown tags");
+
+    int64_t seconds = 0;
+    cbor_parse_result_t tag = cbor_parse((slice_t){.len = sizeof(epoch), .ptr = epoch});
+    cbor_process_result_t end = cbor_tag_decode(&registry, &tag.ok, &seconds);
+    TEST_ASSERT(!end.is_error && end.ok == epoch + sizeof(epoch) && seconds == 1363896240, "Decoder called with the tagged item");
+
+    // The outer decoder sees the inner tag, which can be dispatched again
+    int self_described = 0;
+    slice_t uri = {0};
+    tag = cbor_parse((slice_t){.len = sizeof(nested), .ptr = nested});
+    end = cbor_tag_decode(&registry, &tag.ok, &self_described);
+    cbor_parse_result_t inner = cbor_parse(tag.ok.value.tag.content);
+    cbor_process_result_t inner_end = cbor_tag_decode(&registry, &inner.ok, &uri);
+    TEST_ASSERT(!end.is_error && !inner_end.is_error && self_described && uri.len == 3 && memcmp(uri.ptr, "a:b", 3) == 0,
+        "Nested tags dispatched");
+
+    uint8_t bignum[] = {0xC2, 0x41, 0x01};
+    tag = cbor_parse((slice_t){.len = sizeof(bignum), .ptr = bignum});
+    TEST_ASSERT(cbor_tag_decode(&registry, &tag.ok, NULL).err == KEY_NOT_FOUND_ERROR, "No decoder registered");
+
+    uint8_t wrong_type[] = {0xC1, 0x61, 'x'};
+    tag = cbor_parse((slice_t){.len = sizeof(wrong_type), .ptr = wrong_type});
+    TEST_ASSERT(cbor_tag_decode(&registry, &tag.ok, &seconds).err == PROCESSOR_ERROR, "Decoder error reported");
+
+    cbor_parse_result_t not_tag = cbor_parse((slice_t){.len = 1, .ptr = bignum + 2});
+    TEST_ASSERT(cbor_tag_decode(&registry, &not_tag.ok, NULL).err == TYPE_MISMATCH_ERROR, "Untagged value");
+
+    // Encoding through the registry
+    uint8_t buf[16];
+    int64_t when = 1363896240;
+    cbor_encode_result_t encoded = cbor_tag_encode(&registry, CBOR_TAG_EPOCH_DATETIME, &when, (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!encoded.is_error && encoded.ok.len == sizeof(epoch) && memcmp(buf, epoch, sizeof(epoch)) == 0, "Encoder writes tag and item");
+    TEST_ASSERT(cbor_tag_encode(&registry, CBOR_TAG_URI, &when, (slice_t){.len = sizeof(buf), .ptr = buf}).err ==
+        CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT, "No encoder registered");
+
+    static const cbor_tag_handler_t duplicates[] = {
+        {.number = CBOR_TAG_URI, .decode = decode_uri},
+        {.number = CBOR_TAG_URI, .decode = decode_uri},
+    };
+    TEST_ASSERT(cbor_tag_registry_init(&registry, duplicates, 2).err == MALFORMED_INPUT_ERROR, "Duplicate numbers rejected");
+}
+
+// Parses a tag and returns its enclosed item
+static cbor_value_t tag_content(uint8_t* buf, size_t len) {
+    cbor_parse_result_t tag = cbor_parse((slice_t){.len = len, .ptr = buf});
+    return cbor_parse(tag.ok.value.tag.content).ok;
+}
+
+// Test 5: Epoch time
+void test_epoch_time() {
+    printf("\n=== Testing Epoch Time ===\n");
+
+    cbor_value_t item = tag_content(epoch, sizeof(epoch));
+    cbor_epoch_to_ns_result_t ns = cbor_epoch_to_ns(&item);
+    TEST_ASSERT(!ns.is_error && ns.ok == 1363896240000000000, "Integer seconds");
+
+    uint8_t f64[] = {0xC1, 0xFB, 0x41, 0xD4, 0x52, 0xD9, 0xEC, 0x20, 0x00, 0x00};
+    item = tag_content(f64, sizeof(f64));
+    ns = cbor_epoch_to_ns(&item);
+    TEST_ASSERT(!ns.is_error && ns.ok == 1363896240500000000, "f64 seconds");
+
+    uint8_t f32[] = {0xC1, 0xFA, 0x3F, 0xC0, 0x00, 0x00};
+    item = tag_content(f32, sizeof(f32));
+    ns = cbor_epoch_to_ns(&item);
+    TEST_ASSERT(!ns.is_error && ns.ok == 1500000000, "f32 seconds");
+
+    uint8_t f16[] = {0xC1, 0xF9, 0x38, 0x00};
+    item = tag_content(f16, sizeof(f16));
+    ns = cbor_epoch_to_ns(&item);
+    TEST_ASSERT(!ns.is_error && ns.ok == 500000000, "f16 seconds");
+
+    uint8_t negative[] = {0xC1, 0xFB, 0xBF, 0xF4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    item = tag_content(negative, sizeof(negative));
+    ns = cbor_epoch_to_ns(&item);
+    TEST_ASSERT(!ns.is_error && ns.ok == -1250000000, "Negative f64 seconds");
+
+    uint8_t tiny[] = {0xC1, 0xFB, 0x01, 0xA5, 0x6E, 0x1F, 0xC2, 0xF8, 0xF3, 0x59};
+    item = tag_content(tiny, sizeof(tiny));
+    ns = cbor_epoch_to_ns(&item);
+    TEST_ASSERT(!ns.is_error && ns.ok == 0, "Below a nanosecond truncates to 0");
+
+    uint8_t far[] = {0xC1, 0x1B, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00};
+    item = tag_content(far, sizeof(far));
+    TEST_ASSERT(cbor_epoch_to_ns(&item).err == OUT_OF_RANGE_ERROR, "Integer past 2262");
+
+    // 1(18446744073709551615) must not wrap to -1
+    uint8_t wrapped[] = {0xC1, 0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    item = tag_content(wrapped, sizeof(wrapped));
+    TEST_ASSERT(cbor_epoch_to_ns(&item).err == OUT_OF_RANGE_ERROR, "Integer past INT64_MAX");
+
+    uint8_t nan[] = {0xC1, 0xF9, 0x7E, 0x00};
+    item = tag_content(nan, sizeof(nan));
+    TEST_ASSERT(cbor_epoch_to_ns(&item).err == OUT_OF_RANGE_ERROR, "NaN rejected");
+
+    uint8_t text[] = {0xC1, 0x61, 'x'};
+    item = tag_content(text, sizeof(text));
+    TEST_ASSERT(cbor_epoch_to_ns(&item).err == TYPE_MISMATCH_ERROR, "Text is not an epoch");
+}
+
+// Test 6: RFC 3339 date-time strings
+void test_rfc3339_time() {
+    printf("\n=== Testing RFC 3339 Time ===\n");
+
+    cbor_rfc3339_to_ns_result_t ns = cbor_rfc3339_to_ns(STR2SLICE("2013-03-21T20:04:00Z"));
+    TEST_ASSERT(!ns.is_error && ns.ok == 1363896240000000000, "UTC time");
+
+    ns = cbor_rfc3339_to_ns(STR2SLICE("2013-03-21T22:04:00.5+02:00"));
+    TEST_ASSERT(!ns.is_error && ns.ok == 1363896240500000000, "Offset and fraction");
+
+    ns = cbor_rfc3339_to_ns(STR2SLICE("2013-03-21t15:34:00.1234567891-04:30"));
+    TEST_ASSERT(!ns.is_error && ns.ok == 1363896240123456789, "Fraction truncated to nanoseconds");
+
+    ns = cbor_rfc3339_to_ns(STR2SLICE("2000-02-29T12:00:00z"));
+    TEST_ASSERT(!ns.is_error && ns.ok == 951825600000000000, "Leap day");
+
+    ns = cbor_rfc3339_to_ns(STR2SLICE("1969-12-31T23:59:59.25Z"));
+    TEST_ASSERT(!ns.is_error && ns.ok == -750000000, "Before 1970");
+
+    TEST_ASSERT(cbor_rfc3339_to_ns(STR2SLICE("1900-02-29T00:00:00Z")).err == MALFORMED_INPUT_ERROR, "1900 is not a leap year");
+    TEST_ASSERT(cbor_rfc3339_to_ns(STR2SLICE("2013-04-31T00:00:00Z")).err == MALFORMED_INPUT_ERROR, "Day past month end");
+    TEST_ASSERT(cbor_rfc3339_to_ns(STR2SLICE("2013-03-21T24:00:00Z")).err == MALFORMED_INPUT_ERROR, "Hour 24");
+    TEST_ASSERT(cbor_rfc3339_to_ns(STR2SLICE("2013-03-21T20:04:00")).err == MALFORMED_INPUT_ERROR, "Missing offset");
+    TEST_ASSERT(cbor_rfc3339_to_ns(STR2SLICE("2013-03-21T20:04:00.Z")).err == MALFORMED_INPUT_ERROR, "Empty fraction");
+    TEST_ASSERT(cbor_rfc3339_to_ns(STR2SLICE("2013-03-21 20:04:00Z")).err == MALFORMED_INPUT_ERROR, "Space separator");
+    TEST_ASSERT(cbor_rfc3339_to_ns(STR2SLICE("2300-01-01T00:00:00Z")).err == OUT_OF_RANGE_ERROR, "Past 2262");
+}
+
+// Test 7: Decimal fractions
+void test_decimal_fraction() {
+    printf("\n=== Testing Decimal Fractions ===\n");
+
+    // 4([-2, 27315]), 273.15
+    uint8_t kelvin[] = {0xC4, 0x82, 0x21, 0x19, 0x6A, 0xB3};
+    cbor_value_t item = tag_content(kelvin, sizeof(kelvin));
+    cbor_decimal_to_fixed_result_t fixed = cbor_decimal_to_fixed(&item, 2);
+    TEST_ASSERT(!fixed.is_error && fixed.ok == 27315, "Same scale");
+    fixed = cbor_decimal_to_fixed(&item, 4);
+    TEST_ASSERT(!fixed.is_error && fixed.ok == 2731500, "Larger scale");
+    fixed = cbor_decimal_to_fixed(&item, 0);
+    TEST_ASSERT(!fixed.is_error && fixed.ok == 273, "Smaller scale truncates");
+
+    // 4([-1, -15]), -1.5
+    uint8_t negative[] = {0xC4, 0x82, 0x20, 0x2E};
+    item = tag_content(negative, sizeof(negative));
+    fixed = cbor_decimal_to_fixed(&item, 0);
+    TEST_ASSERT(!fixed.is_error && fixed.ok == -1, "Truncated toward zero");
+
+    // 4([-3, 2(h'0102')]) and 4([-3, 3(h'00FF')])
+    uint8_t bignum[] = {0xC4, 0x82, 0x22, 0xC2, 0x42, 0x01, 0x02};
+    item = tag_content(bignum, sizeof(bignum));
+    fixed = cbor_decimal_to_fixed(&item, 3);
+    TEST_ASSERT(!fixed.is_error && fixed.ok == 258, "Bignum mantissa");
+    uint8_t negative_bignum[] = {0xC4, 0x82, 0x22, 0xC3, 0x42, 0x00, 0xFF};
+    item = tag_content(negative_bignum, sizeof(negative_bignum));
+    fixed = cbor_decimal_to_fixed(&item, 3);
+    TEST_ASSERT(!fixed.is_error && fixed.ok == -256, "Negative bignum mantissa");
+
+    uint8_t wide_bignum[] = {0xC4, 0x82, 0x00, 0xC2, 0x49, 0x01, 0, 0, 0, 0, 0, 0, 0, 0};
+    item = tag_content(wide_bignum, sizeof(wide_bignum));
+    TEST_ASSERT(cbor_decimal_to_fixed(&item, 0).err == OUT_OF_RANGE_ERROR, "Bignum wider than 64 bits");
+
+    // 4([-2, 2(_ h'01', h'02')]), indefinite bignums are not read
+    uint8_t chunked_bignum[] = {0xC4, 0x82, 0x21, 0xC2, 0x5F, 0x41, 0x01, 0x41, 0x02, 0xFF};
+    item = tag_content(chunked_bignum, sizeof(chunked_bignum));
+    TEST_ASSERT(cbor_decimal_to_fixed(&item, 2).err == TYPE_MISMATCH_ERROR, "Indefinite bignum rejected");
+
+    // 4([18446744073709551615, 1]) and 4([-3, 18446744073709551615])
+    uint8_t wrapped_exponent[] = {0xC4, 0x82, 0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+    item = tag_content(wrapped_exponent, sizeof(wrapped_exponent));
+    TEST_ASSERT(cbor_decimal_to_fixed(&item, 2).err == OUT_OF_RANGE_ERROR, "Exponent past INT64_MAX");
+    uint8_t wrapped_mantissa[] = {0xC4, 0x82, 0x22, 0x1B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    item = tag_content(wrapped_mantissa, sizeof(wrapped_mantissa));
+    TEST_ASSERT(cbor_decimal_to_fixed(&item, 3).err == OUT_OF_RANGE_ERROR, "Mantissa past INT64_MAX");
+
+    uint8_t large[] = {0xC4, 0x82, 0x12, 0x0A};
+    item = tag_content(large, sizeof(large));
+    TEST_ASSERT(cbor_decimal_to_fixed(&item, 1).err == OUT_OF_RANGE_ERROR, "Overflow");
+
+    uint8_t small[] = {0xC4, 0x82, 0x38, 0x27, 0x05};
+    item = tag_content(small, sizeof(small));
+    fixed = cbor_decimal_to_fixed(&item, 6);
+    TEST_ASSERT(!fixed.is_error && fixed.ok == 0, "Far below the scale");
+
+    item = tag_content(epoch, sizeof(epoch));
+    TEST_ASSERT(cbor_decimal_to_fixed(&item, 2).err == TYPE_MISMATCH_ERROR, "Not an array");
+}
+
+// Test 8: Time and decimal decoders in a registry
+void test_builtin_decoders() {
+    printf("\n=== Testing Built-in Decoders ===\n");
+
+    static const cbor_tag_handler_t handlers[] = {
+        {.number = CBOR_TAG_DATETIME_STRING, .decode = cbor_tag_decode_time},
+        {.number = CBOR_TAG_EPOCH_DATETIME, .decode = cbor_tag_decode_time},
+        {.number = CBOR_TAG_DECIMAL_FRACTION, .decode = cbor_tag_decode_decimal},
+    };
+    cbor_tag_registry_t registry;
+    cbor_tag_registry_init(&registry, handlers, 3);
+
+    int64_t from_epoch = 0, from_text = 0;
+    cbor_parse_result_t tag = cbor_parse((slice_t){.len = sizeof(epoch), .ptr = epoch});
+    TEST_ASSERT(!cbor_tag_decode(&registry, &tag.ok, &from_epoch).is_error, "Tag 1 decoded");
+
+    uint8_t text[] = {0xC0, 0x74, '2', '0', '1', '3', '-', '0', '3', '-', '2', '1', 'T', '2', '0', ':', '0', '4', ':', '0', '0', 'Z'};
+    tag = cbor_parse((slice_t){.len = sizeof(text), .ptr = text});
+    TEST_ASSERT(!cbor_tag_decode(&registry, &tag.ok, &from_text).is_error, "Tag 0 decoded");
+    TEST_ASSERT(from_epoch == from_text && from_text == 1363896240000000000, "Both forms agree");
+
+    uint8_t kelvin[] = {0xC4, 0x82, 0x21, 0x19, 0x6A, 0xB3};
+    cbor_fixed_t fixed = {.scale = 3};
+    tag = cbor_parse((slice_t){.len = sizeof(kelvin), .ptr = kelvin});
+    TEST_ASSERT(!cbor_tag_decode(&registry, &tag.ok, &fixed).is_error && fixed.value == 273150, "Tag 4 decoded");
+
+    uint8_t bad_text[] = {0xC0, 0x61, 'x'};
+    tag = cbor_parse((slice_t){.len = sizeof(bad_text), .ptr = bad_text});
+    TEST_ASSERT(cbor_tag_decode(&registry, &tag.ok, &from_text).err == PROCESSOR_ERROR, "Malformed date reported");
+
+    // 0(_ "2013-03-21", "T20:04:00Z") has no single slice to parse
+    uint8_t chunked_text[] = {0xC0, 0x7F, 0x6A, '2', '0', '1', '3', '-', '0', '3', '-', '2', '1',
+        0x6A, 'T', '2', '0', ':', '0', '4', ':', '0', '0', 'Z', 0xFF};
+    tag = cbor_parse((slice_t){.len = sizeof(chunked_text), .ptr = chunked_text});
+    TEST_ASSERT(cbor_tag_decode(&registry, &tag.ok, &from_text).err == PROCESSOR_ERROR, "Indefinite date rejected");
+}
+
+int main() {
+    printf("Testing CBOR Tags\n");
+    printf("=================\n");
+
+    test_tag_parse();
+    test_tag_in_containers();
+    test_tag_encode();
+    test_tag_registry();
+    test_epoch_time();
+    test_rfc3339_time();
+    test_decimal_fraction();
+    test_builtin_decoders();
+
+    printf("\n=== Test Results ===\n");
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    if (tests_failed == 0) {
+        printf("🎉 All tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed!\n");
+        return 1;
+    }
+}
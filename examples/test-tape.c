@@ -0,0 +1,170 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cbor.h"
+#include "tape.h"
+#include "test.h"
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// {"a": [1, 2, 3], "b": {"x": 42}, "c": "hello"}
+uint8_t nested_map[] = {
+    0xA3,
+    0x61, 0x61,
+    0x83, 0x01, 0x02, 0x03,
+    0x61, 0x62,
+    0xA1, 0x61, 0x78, 0x18, 0x2A,
+    0x61, 0x63,
+    0x65, 0x68, 0x65, 0x6C, 0x6C, 0x6F
+};
+
+// [_ [_ 1], (_ "ab" "c"), 1(2), []]
+uint8_t indefinite_array[] = {
+    0x9F,
+    0x9F, 0x01, 0xFF,
+    0x7F, 0x62, 0x61, 0x62, 0x61, 0x63, 0xFF,
+    0xC1, 0x02,
+    0x80,
+    0xFF
+};
+
+// Test 1: Entries of a nested document
+void test_tape_layout() {
+    printf("\n=== Testing Tape Layout ===\n");
+
+    cbor_tape_entry_t storage[16];
+    cbor_tape_t tape = CBOR_TAPE(storage);
+    cbor_process_result_t result = cbor_index_build((slice_t){.len = sizeof(nested_map), .ptr = nested_map}, &tape);
+
+    TEST_ASSERT(!result.is_error, "Nested map indexed");
+    TEST_ASSERT(result.ok == nested_map + sizeof(nested_map), "Index ends after the document");
+    TEST_ASSERT(tape.count == 12, "One entry per item");
+    TEST_ASSERT(cbor_tape_major(&tape, 0) == CBOR_MAJOR_TYPE_MAP && tape.entries[0].argument == 3, "Root entry is a map of 3 pairs");
+    TEST_ASSERT(cbor_tape_next(&tape, 0) == 12, "Root entry skips the whole document");
+    TEST_ASSERT(cbor_tape_next(&tape, 2) == 6, "Array entry skips its elements");
+    TEST_ASSERT(cbor_tape_child(&tape, 2) == 3, "Array child is the next entry");
+    TEST_ASSERT(cbor_tape_child(&tape, 3) == CBOR_TAPE_NONE, "Integers have no children");
+    TEST_ASSERT(tape.entries[11].offset == 16 && tape.entries[11].argument == 5, "String entry holds offset and length");
+}
+
+// Test 2: Random access helpers
+void test_tape_lookup() {
+    printf("\n=== Testing Tape Lookup ===\n");
+
+    cbor_tape_entry_t storage[16];
+    cbor_tape_t tape = CBOR_TAPE(storage);
+    cbor_process_result_t result = cbor_index_build((slice_t){.len = sizeof(nested_map), .ptr = nested_map}, &tape);
+    TEST_ASSERT(!result.is_error, "Nested map indexed");
+
+    uint32_t a = cbor_tape_map_get(&tape, 0, (slice_t){.len = 1, .ptr = (uint8_t*)"a"});
+    uint32_t third = cbor_tape_array_get(&tape, a, 2);
+    TEST_ASSERT(third != CBOR_TAPE_NONE && tape.entries[third].argument == 3, "a[2] == 3");
+    TEST_ASSERT(cbor_tape_array_get(&tape, a, 3) == CBOR_TAPE_NONE, "a[3] is out of range");
+
+    uint32_t b = cbor_tape_map_get(&tape, 0, (slice_t){.len = 1, .ptr = (uint8_t*)"b"});
+    uint32_t x = cbor_tape_map_get(&tape, b, (slice_t){.len = 1, .ptr = (uint8_t*)"x"});
+    TEST_ASSERT(x != CBOR_TAPE_NONE && tape.entries[x].argument == 42, "b.x == 42");
+
+    uint32_t c = cbor_tape_map_get(&tape, 0, (slice_t){.len = 1, .ptr = (uint8_t*)"c"});
+    cbor_parse_result_t value = cbor_tape_value(&tape, c);
+    TEST_ASSERT(!value.is_error && value.ok.value.bytes.len == 5 && memcmp(value.ok.value.bytes.ptr, "hello", 5) == 0, "c == \"hello\"");
+
+    TEST_ASSERT(cbor_tape_map_get(&tape, 0, (slice_t){.len = 1, .ptr = (uint8_t*)"d"}) == CBOR_TAPE_NONE, "Missing key not found");
+    TEST_ASSERT(cbor_tape_map_get(&tape, a, (slice_t){.len = 1, .ptr = (uint8_t*)"a"}) == CBOR_TAPE_NONE, "Map lookup on an array fails");
+
+    // Accessors given CBOR_TAPE_NONE stay inside the tape
+    TEST_ASSERT(cbor_tape_value(&tape, CBOR_TAPE_NONE).err == KEY_NOT_FOUND_ERROR, "Value of a missing key");
+    TEST_ASSERT(cbor_tape_value(&tape, tape.count).is_error, "Value one past the tape");
+    TEST_ASSERT(cbor_tape_next(&tape, CBOR_TAPE_NONE) == CBOR_TAPE_NONE && cbor_tape_child(&tape, tape.count) == CBOR_TAPE_NONE,
+        "Next and child past the tape");
+    TEST_ASSERT(cbor_tape_major(&tape, CBOR_TAPE_NONE) == CBOR_MAJOR_TYPE_ERROR, "Major type past the tape");
+}
+
+// Test 3: Indefinite lengths, tags and empty containers
+void test_tape_indefinite() {
+    printf("\n=== Testing Tape Indefinite Items ===\n");
+
+    cbor_tape_entry_t storage[16];
+    cbor_tape_t tape = CBOR_TAPE(storage);
+    cbor_process_result_t result = cbor_index_build((slice_t){.len = sizeof(indefinite_array), .ptr = indefinite_array}, &tape);
+
+    TEST_ASSERT(!result.is_error && result.ok == indefinite_array + sizeof(indefinite_array), "Indefinite array indexed");
+    TEST_ASSERT(tape.count == 7, "Breaks and string chunks have no entries");
+    TEST_ASSERT(cbor_tape_next(&tape, 0) == 7 && cbor_tape_next(&tape, 1) == 3, "Indefinite containers skip their elements");
+    TEST_ASSERT(tape.entries[3].argument == UINT64_MAX && cbor_tape_next(&tape, 3) == 4, "Indefinite string is a single entry");
+    TEST_ASSERT(cbor_tape_major(&tape, 4) == CBOR_MAJOR_TYPE_TAG && cbor_tape_next(&tape, 4) == 6, "Tag entry covers its content");
+    TEST_ASSERT(cbor_tape_child(&tape, 6) == CBOR_TAPE_NONE, "Empty array has no children");
+    TEST_ASSERT(cbor_tape_array_get(&tape, 0, 3) == 6, "Indefinite array element lookup");
+}
+
+// Test 4: Errors
+void test_tape_errors() {
+    printf("\n=== Testing Tape Errors ===\n");
+
+    cbor_tape_entry_t storage[4];
+    cbor_tape_t tape = CBOR_TAPE(storage);
+
+    cbor_process_result_t result = cbor_index_build((slice_t){.len = sizeof(nested_map), .ptr = nested_map}, &tape);
+    TEST_ASSERT(result.is_error && result.err == CAPACITY_ERROR, "Small tape reports capacity error");
+
+    int truncations_rejected = 1;
+    for (size_t len = 1; len < sizeof(indefinite_array); len++) {
+        cbor_tape_entry_t truncated_storage[16];
+        cbor_tape_t truncated_tape = CBOR_TAPE(truncated_storage);
+        result = cbor_index_build((slice_t){.len = len, .ptr = indefinite_array}, &truncated_tape);
+        truncations_rejected &= result.is_error && result.err == BUFFER_OVERFLOW_ERROR;
+    }
+    TEST_ASSERT(truncations_rejected, "Truncated documents are rejected");
+
+    uint8_t stray_break[] = {0x82, 0x01, 0xFF};
+    result = cbor_index_build((slice_t){.len = sizeof(stray_break), .ptr = stray_break}, &tape);
+    TEST_ASSERT(result.is_error && result.err == MALFORMED_INPUT_ERROR, "Break in definite array rejected");
+
+    // {_ 1}, a key without a value
+    uint8_t odd_map[] = {0xBF, 0x01, 0xFF};
+    result = cbor_index_build((slice_t){.len = sizeof(odd_map), .ptr = odd_map}, &tape);
+    TEST_ASSERT(result.is_error && result.err == MALFORMED_INPUT_ERROR, "Odd indefinite map rejected");
+
+    // {_ 1: 6(2)}, the tagged value completes the pair
+    uint8_t tagged_value[] = {0xBF, 0x01, 0xC6, 0x02, 0xFF};
+    result = cbor_index_build((slice_t){.len = sizeof(tagged_value), .ptr = tagged_value}, &tape);
+    TEST_ASSERT(!result.is_error && result.ok == tagged_value + sizeof(tagged_value), "Tagged map value accepted");
+
+    uint8_t too_many[] = {0x9A, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+    result = cbor_index_build((slice_t){.len = sizeof(too_many), .ptr = too_many}, &tape);
+    TEST_ASSERT(result.is_error && result.err == BUFFER_OVERFLOW_ERROR, "Impossible element count rejected");
+
+    uint8_t deep[CBOR_MAX_DEPTH + 2];
+    memset(deep, 0x81, sizeof(deep) - 1);
+    deep[sizeof(deep) - 1] = 0x00;
+    cbor_tape_entry_t deep_storage[CBOR_MAX_DEPTH + 2];
+    cbor_tape_t deep_tape = CBOR_TAPE(deep_storage);
+    result = cbor_index_build((slice_t){.len = sizeof(deep), .ptr = deep}, &deep_tape);
+    TEST_ASSERT(result.is_error && result.err == DEPTH_LIMIT_ERROR, "Nesting deeper than CBOR_MAX_DEPTH rejected");
+}
+
+int main() {
+    printf("Testing CBOR Structural Index\n");
+    printf("=============================\n");
+
+    test_tape_layout();
+    test_tape_lookup();
+    test_tape_indefinite();
+    test_tape_errors();
+
+    printf("\n=== Test Results ===\n");
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    if (tests_failed == 0) {
+        printf("🎉 All tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed!\n");
+        return 1;
+    }
+}
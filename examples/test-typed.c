@@ -0,0 +1,371 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cbor.h"
+#include "typed.h"
+#include "compat/float.h"
+#include "test.h"
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Room for a header and 100 elements of up to 8 bytes
+static uint8_t encoded[8 + 800];
+
+// Writes tag(byte string of len bytes) and returns the payload
+static uint8_t* typed_header(uint8_t tag, size_t len) {
+    encoded[0] = 0xD8;
+    encoded[1] = tag;
+    encoded[2] = 0x59;
+    encoded[3] = (uint8_t)(len >> 8);
+    encoded[4] = (uint8_t)len;
+    return encoded + 5;
+}
+
+static void store(uint8_t* dst, uint64_t value, uint8_t size, int little_endian) {
+    for (uint8_t b = 0; b < size; b++) {
+        uint8_t shift = (uint8_t)(8 * (little_endian ? b : size - 1 - b));
+        dst[b] = (uint8_t)(value >> shift);
+    }
+}
+
+// Test 1: Integer arrays of every width and byte order
+void test_typed_integers() {
+    printf("\n=== Testing Integer Typed Arrays ===\n");
+
+    static const struct {
+        uint8_t tag;
+        uint8_t size;
+        uint8_t kind;
+        uint8_t little_endian;
+    } cases[] = {
+        {64, 1, CBOR_TYPED_UINT, 0},
+        {65, 2, CBOR_TYPED_UINT, 0},
+        {66, 4, CBOR_TYPED_UINT, 0},
+        {67, 8, CBOR_TYPED_UINT, 0},
+        {69, 2, CBOR_TYPED_UINT, 1},
+        {70, 4, CBOR_TYPED_UINT, 1},
+        {71, 8, CBOR_TYPED_UINT, 1},
+        {72, 1, CBOR_TYPED_SINT, 0},
+        {73, 2, CBOR_TYPED_SINT, 0},
+        {74, 4, CBOR_TYPED_SINT, 0},
+        {75, 8, CBOR_TYPED_SINT, 0},
+        {77, 2, CBOR_TYPED_SINT, 1},
+        {78, 4, CBOR_TYPED_SINT, 1},
+        {79, 8, CBOR_TYPED_SINT, 1},
+    };
+
+    // 100 elements cover full vector steps and a scalar tail
+    const size_t count = 100;
+    int headers_match = 1;
+    int values_match = 1;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        uint8_t* payload = typed_header(cases[c].tag, count * cases[c].size);
+        for (size_t i = 0; i < count; i++) {
+            store(payload + i * cases[c].size, 0x0102030405060708ULL * (i + 1), cases[c].size, cases[c].little_endian);
+        }
+
+        cbor_typed_array_parse_result_t array = cbor_typed_array_parse((slice_t){.len = 5 + count * cases[c].size, .ptr = encoded});
+        if (array.is_error || array.ok.count != count || array.ok.element_size != cases[c].size ||
+            array.ok.kind != cases[c].kind || array.ok.little_endian != cases[c].little_endian ||
+            array.ok.data.ptr != payload || array.ok.next != payload + count * cases[c].size) {
+            headers_match = 0;
+            continue;
+        }
+
+        uint64_t out[100];
+        cbor_typed_array_copy_result_t copied = cbor_typed_array_copy(&array.ok, out, count);
+        if (copied.is_error || copied.ok != count) {
+            values_match = 0;
+            continue;
+        }
+        for (size_t i = 0; i < count; i++) {
+            uint64_t expected = 0x0102030405060708ULL * (i + 1);
+            uint64_t got = 0;
+            switch (cases[c].size) {
+            case 1: got = ((uint8_t*)out)[i]; expected &= 0xFF; break;
+            case 2: got = ((uint16_t*)out)[i]; expected &= 0xFFFF; break;
+            case 4: got = ((uint32_t*)out)[i]; expected &= 0xFFFFFFFF; break;
+            default: got = out[i]; break;
+            }
+            if (got != expected) {
+                values_match = 0;
+            }
+        }
+    }
+    TEST_ASSERT(headers_match, "All integer tags parsed with kind, size and byte order");
+    TEST_ASSERT(values_match, "All integer arrays copied in host byte order");
+
+    // Signed values keep their sign
+    uint8_t* payload = typed_header(73, 4);
+    store(payload, 0xFFFE, 2, 0);
+    store(payload + 2, 0x8000, 2, 0);
+    cbor_typed_array_parse_result_t array = cbor_typed_array_parse((slice_t){.len = 9, .ptr = encoded});
+    int16_t values[2] = {0};
+    cbor_typed_array_copy_result_t copied = cbor_typed_array_copy(&array.ok, values, 2);
+    TEST_ASSERT(!copied.is_error && values[0] == -2 && values[1] == INT16_MIN, "sint16 big endian");
+
+    // Tag 68 is a uint8 array with clamping semantics
+    uint8_t clamped[] = {0xD8, 68, 0x43, 0x00, 0x80, 0xFF};
+    array = cbor_typed_array_parse((slice_t){.len = sizeof(clamped), .ptr = clamped});
+    TEST_ASSERT(!array.is_error && array.ok.clamped && array.ok.count == 3 && array.ok.kind == CBOR_TYPED_UINT, "Uint8 clamped array");
+}
+
+// Test 2: Float arrays
+void test_typed_floats() {
+    printf("\n=== Testing Float Typed Arrays ===\n");
+
+    float out[100];
+    float expected[100];
+    for (size_t i = 0; i < 100; i++) {
+        expected[i] = (float)i * 0.5f - 20.0f;
+    }
+
+    // f16, exact for these values
+    int all_match = 1;
+    for (int little_endian = 0; little_endian <= 1; little_endian++) {
+        uint8_t* payload = typed_header(little_endian ? 84 : 80, 200);
+        for (size_t i = 0; i < 100; i++) {
+            uint16_t half = float_to_half(expected[i]);
+            store(payload + 2 * i, half, 2, little_endian);
+        }
+        cbor_typed_array_parse_result_t array = cbor_typed_array_parse((slice_t){.len = 205, .ptr = encoded});
+        cbor_typed_array_to_float_result_t converted = cbor_typed_array_to_float(&array.ok, out, 100);
+        if (array.is_error || converted.is_error || converted.ok != 100 || memcmp(out, expected, sizeof(out)) != 0) {
+            all_match = 0;
+        }
+    }
+    TEST_ASSERT(all_match, "f16 arrays converted to float in both byte orders");
+
+    // f32 and f64
+    all_match = 1;
+    for (int little_endian = 0; little_endian <= 1; little_endian++) {
+        uint8_t* payload = typed_header(little_endian ? 85 : 81, 400);
+        for (size_t i = 0; i < 100; i++) {
+            uint32_t bits;
+            memcpy(&bits, &expected[i], sizeof(bits));
+            store(payload + 4 * i, bits, 4, little_endian);
+        }
+        cbor_typed_array_parse_result_t array = cbor_typed_array_parse((slice_t){.len = 405, .ptr = encoded});
+        cbor_typed_array_to_float_result_t converted = cbor_typed_array_to_float(&array.ok, out, 100);
+        if (array.is_error || converted.is_error || memcmp(out, expected, sizeof(out)) != 0) {
+            all_match = 0;
+        }
+
+        payload = typed_header(little_endian ? 86 : 82, 800);
+        double doubles[100];
+        for (size_t i = 0; i < 100; i++) {
+            double d = (double)expected[i];
+            uint64_t bits;
+            memcpy(&bits, &d, sizeof(bits));
+            store(payload + 8 * i, bits, 8, little_endian);
+        }
+        array = cbor_typed_array_parse((slice_t){.len = 805, .ptr = encoded});
+        converted = cbor_typed_array_to_float(&array.ok, out, 100);
+        cbor_typed_array_copy_result_t copied = cbor_typed_array_copy(&array.ok, doubles, 100);
+        if (array.is_error || converted.is_error || copied.is_error || memcmp(out, expected, sizeof(out)) != 0 ||
+            doubles[99] != (double)expected[99]) {
+            all_match = 0;
+        }
+    }
+    TEST_ASSERT(all_match, "f32 and f64 arrays in both byte orders");
+}
+
+// Test 3: Zero-copy views
+void test_typed_view() {
+    printf("\n=== Testing Typed Array Views ===\n");
+
+    const int host_little = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+    const uint8_t native_tag = host_little ? 70 : 66;
+    const uint8_t swapped_tag = host_little ? 66 : 70;
+
+    // Three byte header at buf + 1 puts the payload on a 4 byte boundary
+    _Alignas(8) uint8_t buf[16] = {0x00, 0xD8, native_tag, 0x48};
+    store(buf + 4, 1, 4, host_little);
+    store(buf + 8, 2, 4, host_little);
+
+    cbor_typed_array_parse_result_t array = cbor_typed_array_parse((slice_t){.len = 11, .ptr = buf + 1});
+    const uint32_t* view = cbor_typed_array_view(&array.ok);
+    TEST_ASSERT(!array.is_error && view == (const uint32_t*)(const void*)(buf + 4) && view[0] == 1 && view[1] == 2,
+        "View of a native aligned payload");
+
+    buf[2] = swapped_tag;
+    array = cbor_typed_array_parse((slice_t){.len = 11, .ptr = buf + 1});
+    TEST_ASSERT(!array.is_error && cbor_typed_array_view(&array.ok) == NULL, "No view of a swapped payload");
+
+    buf[2] = native_tag;
+    memmove(buf + 2, buf + 1, 11);
+    array = cbor_typed_array_parse((slice_t){.len = 11, .ptr = buf + 2});
+    TEST_ASSERT(!array.is_error && cbor_typed_array_view(&array.ok) == NULL, "No view of a misaligned payload");
+
+    uint32_t out[2];
+    cbor_typed_array_copy_result_t copied = cbor_typed_array_copy(&array.ok, out, 2);
+    TEST_ASSERT(!copied.is_error && out[0] == 1 && out[1] == 2, "Misaligned payload still copies");
+
+    uint8_t bytes[] = {0xD8, 64, 0x42, 0x01, 0x02};
+    cbor_typed_array_parse_result_t u8 = cbor_typed_array_parse((slice_t){.len = sizeof(bytes), .ptr = bytes});
+    TEST_ASSERT(cbor_typed_array_view(&u8.ok) == bytes + 3, "Byte arrays are always viewable");
+}
+
+// Test 4: Rejected input
+void test_typed_errors() {
+    printf("\n=== Testing Typed Array Errors ===\n");
+
+    uint8_t not_tag[] = {0x42, 0x01, 0x02};
+    TEST_ASSERT(cbor_typed_array_parse((slice_t){.len = sizeof(not_tag), .ptr = not_tag}).err == TYPE_MISMATCH_ERROR, "Untagged byte string");
+
+    uint8_t other_tag[] = {0xC1, 0x42, 0x01, 0x02};
+    TEST_ASSERT(cbor_typed_array_parse((slice_t){.len = sizeof(other_tag), .ptr = other_tag}).err == TYPE_MISMATCH_ERROR, "Tag outside the typed array range");
+
+    uint8_t reserved[] = {0xD8, 76, 0x42, 0x01, 0x02};
+    TEST_ASSERT(cbor_typed_array_parse((slice_t){.len = sizeof(reserved), .ptr = reserved}).err == TYPE_MISMATCH_ERROR, "Reserved tag 76");
+
+    uint8_t text[] = {0xD8, 65, 0x62, 'a', 'b'};
+    TEST_ASSERT(cbor_typed_array_parse((slice_t){.len = sizeof(text), .ptr = text}).err == TYPE_MISMATCH_ERROR, "Text string content");
+
+    uint8_t odd[] = {0xD8, 65, 0x43, 0x01, 0x02, 0x03};
+    TEST_ASSERT(cbor_typed_array_parse((slice_t){.len = sizeof(odd), .ptr = odd}).err == MALFORMED_INPUT_ERROR, "Length not a multiple of the element size");
+
+    uint8_t truncated[] = {0xD8, 65, 0x44, 0x01, 0x02};
+    TEST_ASSERT(cbor_typed_array_parse((slice_t){.len = sizeof(truncated), .ptr = truncated}).err == BUFFER_OVERFLOW_ERROR, "Truncated payload");
+    TEST_ASSERT(cbor_typed_array_parse((slice_t){.len = 2, .ptr = truncated}).err == BUFFER_OVERFLOW_ERROR, "Missing tag content");
+
+    uint8_t odd_chunks[] = {0xD8, 65, 0x5F, 0x42, 0x01, 0x02, 0x41, 0x03, 0xFF};
+    TEST_ASSERT(cbor_typed_array_parse((slice_t){.len = sizeof(odd_chunks), .ptr = odd_chunks}).err == MALFORMED_INPUT_ERROR, "Chunks not a multiple of the element size");
+
+    uint8_t text_chunk[] = {0xD8, 65, 0x5F, 0x62, 0x01, 0x02, 0xFF};
+    TEST_ASSERT(cbor_typed_array_parse((slice_t){.len = sizeof(text_chunk), .ptr = text_chunk}).err == MALFORMED_INPUT_ERROR, "Text chunk in a byte string");
+    TEST_ASSERT(cbor_typed_array_parse((slice_t){.len = 6, .ptr = odd_chunks}).err == BUFFER_OVERFLOW_ERROR, "Chunked payload without a break");
+
+    uint8_t two[] = {0xD8, 65, 0x44, 0x00, 0x01, 0x00, 0x02};
+    cbor_typed_array_parse_result_t array = cbor_typed_array_parse((slice_t){.len = sizeof(two), .ptr = two});
+    uint16_t out[1];
+    TEST_ASSERT(!array.is_error && cbor_typed_array_copy(&array.ok, out, 1).err == CAPACITY_ERROR, "Output too small");
+    float floats[2];
+    TEST_ASSERT(cbor_typed_array_to_float(&array.ok, floats, 2).err == TYPE_MISMATCH_ERROR, "Integer array to float");
+
+    uint8_t f128[] = {0xD8, 83, 0x50, 0x3F, 0xFF, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    array = cbor_typed_array_parse((slice_t){.len = sizeof(f128), .ptr = f128});
+    TEST_ASSERT(!array.is_error && array.ok.element_size == 16 && array.ok.count == 1, "f128 array parsed");
+    TEST_ASSERT(cbor_typed_array_copy(&array.ok, floats, 2).err == TYPE_MISMATCH_ERROR, "f128 has no native type");
+}
+
+// Test 5: Indefinite length payloads
+void test_typed_chunked() {
+    printf("\n=== Testing Chunked Typed Arrays ===\n");
+
+    // uint16 big endian [0x0102, 0x0304, 0x0506], the second split between chunks
+    uint8_t chunked[] = {0xD8, 65, 0x5F, 0x43, 0x01, 0x02, 0x03, 0x40, 0x41, 0x04, 0x42, 0x05, 0x06, 0xFF, 0x07};
+    cbor_typed_array_parse_result_t array = cbor_typed_array_parse((slice_t){.len = sizeof(chunked), .ptr = chunked});
+    TEST_ASSERT(!array.is_error && array.ok.count == 3 && array.ok.data.len == 6, "Chunked payload parsed");
+    TEST_ASSERT(!array.is_error && array.ok.next == chunked + sizeof(chunked) - 1, "Chunked payload ends after the break");
+    TEST_ASSERT(!array.is_error && cbor_typed_array_view(&array.ok) == NULL, "No view of a chunked payload");
+
+    uint16_t out[3] = {0};
+    cbor_typed_array_copy_result_t copied = cbor_typed_array_copy(&array.ok, out, 3);
+    TEST_ASSERT(!copied.is_error && copied.ok == 3 && out[0] == 0x0102 && out[1] == 0x0304 && out[2] == 0x0506, "Chunks joined across element boundaries");
+    TEST_ASSERT(cbor_typed_array_copy(&array.ok, out, 2).err == CAPACITY_ERROR, "Chunked output too small");
+
+    // f16 little endian [1.0, -2.0] in one byte chunks
+    uint8_t halves[] = {0xD8, 84, 0x5F, 0x41, 0x00, 0x41, 0x3C, 0x41, 0x00, 0x41, 0xC0, 0xFF};
+    array = cbor_typed_array_parse((slice_t){.len = sizeof(halves), .ptr = halves});
+    float floats[2] = {0};
+    cbor_typed_array_to_float_result_t converted = cbor_typed_array_to_float(&array.ok, floats, 2);
+    TEST_ASSERT(!array.is_error && !converted.is_error && floats[0] == 1.0f && floats[1] == -2.0f, "Chunked f16 converted");
+
+    uint8_t empty[] = {0xD8, 66, 0x5F, 0x40, 0xFF};
+    array = cbor_typed_array_parse((slice_t){.len = sizeof(empty), .ptr = empty});
+    TEST_ASSERT(!array.is_error && array.ok.count == 0 && cbor_typed_array_copy(&array.ok, NULL, 0).ok == 0, "Empty chunked payload");
+}
+
+// Test 6: Encoding native arrays
+void test_typed_encode() {
+    printf("\n=== Testing Typed Array Encoding ===\n");
+
+    int16_t samples[100];
+    for (size_t i = 0; i < 100; i++) {
+        samples[i] = (int16_t)(i * 331 - 16000);
+    }
+
+    // Every element is written big endian and reads back unchanged
+    uint8_t buf[256];
+    cbor_encode_result_t encoded_be = cbor_encode_typed_array(CBOR_TAG_SINT16_BE, samples, 100, (slice_t){.len = sizeof(buf), .ptr = buf});
+    int bytes_match = !encoded_be.is_error && encoded_be.ok.len == 204 &&
+        buf[0] == 0xD8 && buf[1] == CBOR_TAG_SINT16_BE && buf[2] == 0x58 && buf[3] == 200;
+    for (size_t i = 0; bytes_match && i < 100; i++) {
+        bytes_match = buf[4 + 2 * i] == (uint8_t)((uint16_t)samples[i] >> 8) && buf[5 + 2 * i] == (uint8_t)samples[i];
+    }
+    TEST_ASSERT(bytes_match, "int16 samples encoded big endian");
+
+    int16_t decoded[100];
+    cbor_typed_array_parse_result_t array = cbor_typed_array_parse(encoded_be.ok);
+    cbor_typed_array_copy_result_t copied = cbor_typed_array_copy(&array.ok, decoded, 100);
+    TEST_ASSERT(!copied.is_error && memcmp(decoded, samples, sizeof(samples)) == 0, "Big endian round trip");
+
+    cbor_encode_result_t encoded_le = cbor_encode_typed_array(CBOR_TAG_SINT16_LE, samples, 100, (slice_t){.len = sizeof(buf), .ptr = buf});
+    bytes_match = !encoded_le.is_error && encoded_le.ok.len == 204;
+    for (size_t i = 0; bytes_match && i < 100; i++) {
+        bytes_match = buf[4 + 2 * i] == (uint8_t)samples[i] && buf[5 + 2 * i] == (uint8_t)((uint16_t)samples[i] >> 8);
+    }
+    TEST_ASSERT(bytes_match, "int16 samples encoded little endian");
+
+    // Nested in a map through cbor_encode
+    double readings[3] = {1.5, -2.25, 1e300};
+    cbor_pair_t pairs[] = {
+        {
+            .first = {.type = CBOR_TYPE_TEXT_STRING, .value.bytes = STR2SLICE("r")},
+            .second = CBOR_TYPED_ARRAY(CBOR_TAG_FLOAT64_BE, readings, 3)
+        }
+    };
+    cbor_value_t readings_map = {
+        .type = CBOR_ENCODE_TYPE_PAIRS,
+        .value.pairs = {.len = 1, .ptr = pairs}
+    };
+    cbor_encode_result_t map = cbor_encode(readings_map, (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!map.is_error && map.ok.len == 1 + 2 + 2 + 2 + 24, "Typed array encoded as a map value");
+
+    cbor_parse_result_t parsed = cbor_parse(map.ok);
+    cbor_map_find_result_t value = cbor_map_find(parsed.ok.value.map, CBOR_TEXT_KEY("r"));
+    double read_back[3] = {0};
+    array = cbor_typed_array_parse(value.ok);
+    copied = cbor_typed_array_copy(&array.ok, read_back, 3);
+    TEST_ASSERT(!copied.is_error && memcmp(read_back, readings, sizeof(readings)) == 0, "f64 values read back from the map");
+
+    // Errors
+    TEST_ASSERT(cbor_encode_typed_array(CBOR_TAG_SINT16_BE, samples, 100, (slice_t){.len = 203, .ptr = buf}).err == CBOR_ENCODER_ERROR_BUFFER_OVERFLOW,
+        "Target one byte short");
+    TEST_ASSERT(cbor_encode_typed_array(76, samples, 1, (slice_t){.len = sizeof(buf), .ptr = buf}).err == CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT,
+        "Reserved tag rejected");
+    TEST_ASSERT(cbor_encode_typed_array(CBOR_TAG_FLOAT128_LE, samples, 1, (slice_t){.len = sizeof(buf), .ptr = buf}).err == CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT,
+        "f128 rejected");
+
+    cbor_encode_result_t empty = cbor_encode_typed_array(CBOR_TAG_UINT32_LE, NULL, 0, (slice_t){.len = sizeof(buf), .ptr = buf});
+    TEST_ASSERT(!empty.is_error && empty.ok.len == 3 && buf[2] == 0x40, "Empty array");
+}
+
+int main() {
+    printf("Testing CBOR Typed Arrays\n");
+    printf("=========================\n");
+
+    test_typed_integers();
+    test_typed_floats();
+    test_typed_view();
+    test_typed_errors();
+    test_typed_chunked();
+    test_typed_encode();
+
+    printf("\n=== Test Results ===\n");
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    if (tests_failed == 0) {
+        printf("🎉 All tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed!\n");
+        return 1;
+    }
+}
@@ -0,0 +1,163 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cbor.h"
+#include "utf8.h"
+#include "test.h"
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+typedef struct {
+    const char* bytes;
+    int valid;
+    const char* name;
+} utf8_case_t;
+
+static const utf8_case_t utf8_cases[] = {
+    {"", 1, "empty string"},
+    {"hello", 1, "ASCII"},
+    {"\xC3\xA9t\xC3\xA9", 1, "two byte sequences"},
+    {"\xE2\x82\xAC", 1, "three byte sequence"},
+    {"\xF0\x9F\x98\x80", 1, "four byte sequence"},
+    {"\xED\x9F\xBF", 1, "last code point before surrogates"},
+    {"\xF4\x8F\xBF\xBF", 1, "U+10FFFF"},
+    {"\x80", 0, "stray continuation"},
+    {"\xC3", 0, "truncated two byte sequence"},
+    {"\xE2\x82", 0, "truncated three byte sequence"},
+    {"\xC0\xAF", 0, "overlong two byte form"},
+    {"\xE0\x80\xAF", 0, "overlong three byte form"},
+    {"\xF0\x80\x80\xAF", 0, "overlong four byte form"},
+    {"\xED\xA0\x80", 0, "surrogate"},
+    {"\xF4\x90\x80\x80", 0, "above U+10FFFF"},
+    {"\xF5\x80\x80\x80", 0, "invalid lead byte"},
+    {"\xC3\xA9\xA9", 0, "too many continuations"},
+    {"\xE2\x28\xA1", 0, "ASCII inside a sequence"},
+};
+
+// Deterministic generator so failures reproduce
+static uint32_t lcg_state = 12345;
+static uint32_t lcg_next(void) {
+    lcg_state = lcg_state * 1103515245u + 12345u;
+    return lcg_state >> 8;
+}
+
+// Test 1: Known sequences, alone and placed across a vector boundary
+void test_utf8_cases() {
+    printf("\n=== Testing UTF-8 Cases ===\n");
+
+    for (size_t i = 0; i < sizeof(utf8_cases) / sizeof(utf8_cases[0]); i++) {
+        const utf8_case_t* c = &utf8_cases[i];
+        size_t len = strlen(c->bytes);
+
+        int alone = cbor_utf8_validate((const uint8_t*)c->bytes, len) == c->valid
+            && cbor_utf8_validate_scalar((const uint8_t*)c->bytes, len) == c->valid;
+
+        // Straddle the first 16 byte block so the vector path sees it
+        uint8_t padded[40];
+        memset(padded, 'a', sizeof(padded));
+        memcpy(padded + 14, c->bytes, len);
+        int straddled = cbor_utf8_validate(padded, sizeof(padded)) == c->valid;
+
+        // And at the very end of the input
+        memcpy(padded + sizeof(padded) - len, c->bytes, len);
+        memset(padded + 14, 'a', len);
+        int at_end = cbor_utf8_validate(padded, sizeof(padded)) == c->valid;
+
+        char message[96];
+        snprintf(message, sizeof(message), "%s is %s", c->name, c->valid ? "valid" : "invalid");
+        TEST_ASSERT(alone && straddled && at_end, message);
+    }
+}
+
+// Test 2: Every byte pair at every offset near a block boundary agrees with the scalar validator
+void test_utf8_pairs() {
+    printf("\n=== Testing UTF-8 Byte Pairs ===\n");
+
+    uint8_t buf[34];
+    int mismatches = 0;
+    for (size_t offset = 13; offset < 18; offset++) {
+        for (uint32_t pair = 0; pair < 0x10000; pair++) {
+            memset(buf, 'a', sizeof(buf));
+            buf[offset] = (uint8_t)(pair >> 8);
+            buf[offset + 1] = (uint8_t)pair;
+            if (cbor_utf8_validate(buf, sizeof(buf)) != cbor_utf8_validate_scalar(buf, sizeof(buf))) {
+                mismatches++;
+            }
+        }
+    }
+    TEST_ASSERT(mismatches == 0, "Vector and scalar validators agree on all byte pairs");
+}
+
+// Test 3: Random mixes of sequence fragments
+void test_utf8_random() {
+    printf("\n=== Testing UTF-8 Random Input ===\n");
+
+    static const uint8_t alphabet[] = {
+        'a', 0x7F, 0x80, 0x8F, 0x90, 0x9F, 0xA0, 0xBF, 0xC0, 0xC2, 0xDF,
+        0xE0, 0xE1, 0xED, 0xEF, 0xF0, 0xF1, 0xF4, 0xF5, 0xFF,
+    };
+
+    uint8_t buf[70];
+    int mismatches = 0, valid = 0;
+    for (int round = 0; round < 100000; round++) {
+        size_t len = lcg_next() % sizeof(buf);
+        for (size_t i = 0; i < len; i++) {
+            buf[i] = alphabet[lcg_next() % sizeof(alphabet)];
+        }
+        int expected = cbor_utf8_validate_scalar(buf, len);
+        valid += expected;
+        if (cbor_utf8_validate(buf, len) != expected) {
+            mismatches++;
+        }
+    }
+    TEST_ASSERT(mismatches == 0, "Vector and scalar validators agree on random input");
+    TEST_ASSERT(valid > 0, "Random input includes valid strings");
+}
+
+// Test 4: Strict parsing of text strings
+void test_utf8_parse() {
+    printf("\n=== Testing Strict Text String Parsing ===\n");
+
+    uint8_t valid_string[] = {0x63, 0xE2, 0x82, 0xAC}; // "€"
+    cbor_parse_result_t result = cbor_parse((slice_t){.len = sizeof(valid_string), .ptr = valid_string});
+    TEST_ASSERT(!result.is_error && result.ok.value.bytes.len == 3, "Valid text string parsed");
+
+    uint8_t invalid_string[] = {0x62, 0xC0, 0xAF};
+    result = cbor_parse((slice_t){.len = sizeof(invalid_string), .ptr = invalid_string});
+#ifdef CBOR_STRICT_UTF8
+    TEST_ASSERT(result.is_error && result.err == INVALID_UTF8_ERROR, "Invalid text string rejected");
+#else
+    TEST_ASSERT(!result.is_error, "Invalid text string accepted without CBOR_STRICT_UTF8");
+#endif
+
+    // Byte strings are never checked
+    uint8_t byte_string[] = {0x42, 0xC0, 0xAF};
+    result = cbor_parse((slice_t){.len = sizeof(byte_string), .ptr = byte_string});
+    TEST_ASSERT(!result.is_error, "Byte string contents are not validated");
+}
+
+int main() {
+    printf("Testing UTF-8 Validation\n");
+    printf("========================\n");
+
+    test_utf8_cases();
+    test_utf8_pairs();
+    test_utf8_random();
+    test_utf8_parse();
+
+    printf("\n=== Test Results ===\n");
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_failed);
+
+    if (tests_failed == 0) {
+        printf("🎉 All tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed!\n");
+        return 1;
+    }
+}
@@ -1,5 +1,4 @@
 #include "cbor.h"
-#include <stdio.h>
 #include <stdint.h>
 #if defined(__linux__) || defined(__unix__) || defined(__APPLE__) || defined(__FreeBSD__)
 #include <endian.h>
@@ -9,6 +8,8 @@
 #include <string.h>
 
 #include "compat/float.h"
+#include "utf8.h"
+#include "typed.h"
 
 #define CBOR_FLOAT_PRECISION_DEFAULT CBOR_FLOAT_PRECISION_SINGLE
 
@@ -18,6 +19,41 @@
  * 
  ********************************/
 
+/*--------------------------------------------------------------------------*/
+// Initial byte table: one entry per possible initial byte, 32 per major type
+#define IB(major, tag, size, flags) { (major), (tag), (size), (flags) }
+#define IB_DIRECT(major) IB(major, ARGUMENT_1BYTE, 0, 0)
+#define IB_DIRECT8(major) \
+    IB_DIRECT(major), IB_DIRECT(major), IB_DIRECT(major), IB_DIRECT(major), \
+    IB_DIRECT(major), IB_DIRECT(major), IB_DIRECT(major), IB_DIRECT(major)
+#define IB_RESERVED(major) IB(major, ARGUMENT_MALFORMED, 0, CBOR_IB_RESERVED)
+#define IB_MAJOR(major, last) \
+    IB_DIRECT8(major), IB_DIRECT8(major), IB_DIRECT8(major), \
+    IB(major, ARGUMENT_1BYTE, 1, 0), \
+    IB(major, ARGUMENT_2BYTE, 2, 0), \
+    IB(major, ARGUMENT_4BYTE, 4, 0), \
+    IB(major, ARGUMENT_8BYTE, 8, 0), \
+    IB_RESERVED(major), IB_RESERVED(major), IB_RESERVED(major), \
+    IB(major, ARGUMENT_NONE, 0, last)
+
+const cbor_initial_byte_t cbor_initial_byte_table[256] = {
+    // Additional info 31 is only well-formed for strings, arrays and maps,
+    // and as the break code in major type 7
+    IB_MAJOR(CBOR_MAJOR_TYPE_UNSIGNED_INTEGER, CBOR_IB_RESERVED),
+    IB_MAJOR(CBOR_MAJOR_TYPE_NEGATIVE_INTEGER, CBOR_IB_RESERVED),
+    IB_MAJOR(CBOR_MAJOR_TYPE_BYTE_STRING,      CBOR_IB_INDEFINITE),
+    IB_MAJOR(CBOR_MAJOR_TYPE_TEXT_STRING,      CBOR_IB_INDEFINITE),
+    IB_MAJOR(CBOR_MAJOR_TYPE_ARRAY,            CBOR_IB_INDEFINITE),
+    IB_MAJOR(CBOR_MAJOR_TYPE_MAP,              CBOR_IB_INDEFINITE),
+    IB_MAJOR(CBOR_MAJOR_TYPE_TAG,              CBOR_IB_RESERVED),
+    IB_MAJOR(CBOR_MAJOR_TYPE_SIMPLE,           CBOR_IB_BREAK),
+};
+
+#undef IB_MAJOR
+#undef IB_RESERVED
+#undef IB_DIRECT8
+#undef IB_DIRECT
+#undef IB
 /*--------------------------------------------------------------------------*/
 // Helper function to check if we've hit the CBOR break/stop code (0xFF)
 static int cbor_is_break(const uint8_t* ptr) {
@@ -36,24 +72,20 @@ FN_RESULT (
         return ERR(cbor_parse_result_t, EMPTY_BUFFER_ERROR);
     }
     
-    cbor_major_type_t major_type = cbor_get_major_type_safe(buf);
-    if (major_type == CBOR_MAJOR_TYPE_ERROR) {
-        return ERR(cbor_parse_result_t, BUFFER_OVERFLOW_ERROR);
-    }
-    
-    cbor_value_t value = {0};  // Initialize entire struct to zero
-    value.argument = cbor_get_argument_safe(buf, 0);
-    if (value.argument.tag == ARGUMENT_MALFORMED) {
+    // Major type, argument width and flags all come from a single lookup
+    const cbor_initial_byte_t ib = cbor_initial_byte_table[*buf.ptr];
+    // Reserved covers additional info 28 to 30, and 31 on integers and tags
+    if ((ib.flags & CBOR_IB_RESERVED) || ib.size >= buf.len) {
         return ERR(cbor_parse_result_t, MALFORMED_INPUT_ERROR);
     }
 
-    // Validate that we have enough bytes for the header and argument
-    size_t header_size = 1 + value.argument.size;
-    if (!cbor_validate_bounds(buf, 0, header_size)) {
-        return ERR(cbor_parse_result_t, BUFFER_OVERFLOW_ERROR);
-    }
+    cbor_value_t value = {0};  // Initialize entire struct to zero
+    value.argument = cbor_read_argument(ib, buf.ptr);
+
+    // Header and argument are known to be in bounds at this point
+    size_t header_size = 1 + ib.size;
 
-    switch(major_type) {
+    switch((cbor_major_type_t)ib.major) {
     case CBOR_MAJOR_TYPE_UNSIGNED_INTEGER:
         value.type = CBOR_TYPE_INTEGER;
         value.value.integer = (int64_t)cbor_argument_to_fixed(value.argument);
@@ -103,6 +135,11 @@ FN_RESULT (
             if (!cbor_validate_bounds(buf, 0, total_size)) {
                 return ERR(cbor_parse_result_t, BUFFER_OVERFLOW_ERROR);
             }
+#ifdef CBOR_STRICT_UTF8
+            if (!cbor_utf8_validate(buf.ptr + header_size, string_len)) {
+                return ERR(cbor_parse_result_t, INVALID_UTF8_ERROR);
+            }
+#endif
             value.value.bytes.len = string_len;
             value.value.bytes.ptr = buf.ptr + header_size;
             value.next = buf.ptr + total_size;
@@ -147,6 +184,25 @@ FN_RESULT (
         }
         value.next = NULL;
         break;
+    case CBOR_MAJOR_TYPE_TAG: {
+        // The tagged item follows the header, walk it once to know where it ends
+        slice_t content = {.len = buf.len - header_size, .ptr = buf.ptr + header_size};
+        if (content.len == 0) {
+            return ERR(cbor_parse_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+        cbor_process_result_t end = cbor_skip_item(content);
+        if (end.is_error) {
+            return ERR(cbor_parse_result_t, end.err);
+        }
+        content.len = (size_t)(end.ok - content.ptr);
+        value.type = CBOR_TYPE_TAG;
+        value.value.tag = (cbor_tag_t) {
+            .number = cbor_argument_to_fixed(value.argument),
+            .content = content,
+        };
+        value.next = end.ok;
+        break;
+    }
     case CBOR_MAJOR_TYPE_SIMPLE:
         // Simples and floats
         switch (value.argument.tag) {
@@ -182,12 +238,12 @@ FN_RESULT (
             break;
         case ARGUMENT_4BYTE:
             // f32
-            value.value.floating = *(float*)&value.argument._4byte;
+            memcpy(&value.value.floating, &value.argument._4byte, sizeof(float));
             value.type = CBOR_TYPE_FLOAT;
             break;
         case ARGUMENT_8BYTE:
-            // f64
-            value.value.floating = double_to_float(*(double*)&value.argument._8byte);
+            // f64, kept as is
+            memcpy(&value.value.float64, &value.argument._8byte, sizeof(double));
             value.type = CBOR_TYPE_FLOAT;
             break;
         default:
@@ -202,10 +258,665 @@ FN_RESULT (
     return OK(cbor_parse_result_t, value);
 }
 /*--------------------------------------------------------------------------*/
-cbor_process_result_t cbor_process_indefinite_string(cbor_array_t string_chunks, cbor_type_t expected_type, single_processor_function process_single, void* process_arg) {
-    if (string_chunks.inside == NULL) {
+cbor_parse_item_result_t cbor_parse_item(slice_t doc, size_t offset) {
+    if (doc.ptr == NULL) {
+        return ERR(cbor_parse_item_result_t, NULL_PTR_ERROR);
+    }
+    if (offset >= doc.len) {
+        return ERR(cbor_parse_item_result_t, offset == 0 ? EMPTY_BUFFER_ERROR : BUFFER_OVERFLOW_ERROR);
+    }
+    if (offset > UINT32_MAX) {
+        return ERR(cbor_parse_item_result_t, CAPACITY_ERROR);
+    }
+
+    const uint8_t* data = doc.ptr + offset;
+    const size_t available = doc.len - offset;
+    const cbor_initial_byte_t ib = cbor_initial_byte_table[*data];
+    if ((ib.flags & (CBOR_IB_RESERVED | CBOR_IB_BREAK)) || ib.size >= available) {
+        return ERR(cbor_parse_item_result_t, MALFORMED_INPUT_ERROR);
+    }
+
+    cbor_item_t item = {
+        .type = ib.major,
+        .header = 1 + ib.size,
+        .flags = (ib.flags & CBOR_IB_INDEFINITE) ? CBOR_ITEM_INDEFINITE : 0,
+        .offset = (uint32_t)offset,
+    };
+    const argument_t argument = cbor_read_argument(ib, data);
+
+    switch ((cbor_major_type_t)ib.major) {
+    case CBOR_MAJOR_TYPE_UNSIGNED_INTEGER:
+        item.type = CBOR_TYPE_INTEGER;
+        item.value.integer = (int64_t)cbor_argument_to_fixed(argument);
+        break;
+    case CBOR_MAJOR_TYPE_NEGATIVE_INTEGER:
+        item.type = CBOR_TYPE_INTEGER;
+        item.value.integer = - 1 - (int64_t)cbor_argument_to_fixed(argument);
+        break;
+    case CBOR_MAJOR_TYPE_BYTE_STRING:
+    case CBOR_MAJOR_TYPE_TEXT_STRING:
+        if (item.flags & CBOR_ITEM_INDEFINITE) {
+            break;
+        }
+        item.value.length = cbor_argument_to_fixed(argument);
+        if (item.value.length > available - item.header) {
+            return ERR(cbor_parse_item_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+#ifdef CBOR_STRICT_UTF8
+        if (ib.major == CBOR_MAJOR_TYPE_TEXT_STRING && !cbor_utf8_validate(data + item.header, item.value.length)) {
+            return ERR(cbor_parse_item_result_t, INVALID_UTF8_ERROR);
+        }
+#endif
+        break;
+    case CBOR_MAJOR_TYPE_ARRAY:
+    case CBOR_MAJOR_TYPE_MAP:
+        if (!(item.flags & CBOR_ITEM_INDEFINITE)) {
+            item.value.length = cbor_argument_to_fixed(argument);
+        }
+        break;
+    case CBOR_MAJOR_TYPE_TAG:
+        item.value.tag = cbor_argument_to_fixed(argument);
+        break;
+    case CBOR_MAJOR_TYPE_SIMPLE:
+        switch (argument.tag) {
+        case ARGUMENT_1BYTE:
+            item.type = CBOR_TYPE_SIMPLE;
+            if (argument._1byte >= 20 && argument._1byte <= 23) {
+                item.value.simple = (cbor_simple_t)(CBOR_SIMPLE_FALSE + (argument._1byte - 20));
+            }
+            else if (argument._1byte >= 24 && argument._1byte <= 31) {
+                item.value.simple = CBOR_SIMPLE_ERROR_RESERVED;
+            }
+            else {
+                item.value.simple = CBOR_SIMPLE_ERROR_UNASSIGNED;
+            }
+            break;
+        case ARGUMENT_2BYTE:
+            item.type = CBOR_TYPE_FLOAT;
+            item.value.floating = half_to_float(argument._2byte);
+            break;
+        case ARGUMENT_4BYTE:
+            item.type = CBOR_TYPE_FLOAT;
+            memcpy(&item.value.floating, &argument._4byte, sizeof(float));
+            break;
+        case ARGUMENT_8BYTE:
+            item.type = CBOR_TYPE_FLOAT;
+            memcpy(&item.value.float64, &argument._8byte, sizeof(double));
+            break;
+        default:
+            return ERR(cbor_parse_item_result_t, MALFORMED_INPUT_ERROR);
+        }
+        break;
+    default:
+        return ERR(cbor_parse_item_result_t, PARSER_TODO);
+    }
+    return OK(cbor_parse_item_result_t, item);
+}
+/*--------------------------------------------------------------------------*/
+// Offset after item, taking over the end reported by a processor that walked it
+static cbor_validate_result_t cbor_item_end(slice_t doc, const cbor_item_t* item, uint8_t* consumed) {
+    if (consumed != NULL && consumed > doc.ptr + item->offset && consumed <= doc.ptr + doc.len) {
+        return OK(cbor_validate_result_t, (size_t)(consumed - doc.ptr));
+    }
+
+    switch (item->type) {
+    case CBOR_TYPE_BYTE_STRING:
+    case CBOR_TYPE_TEXT_STRING:
+        if (item->flags & CBOR_ITEM_INDEFINITE) {
+            break;
+        }
+        return OK(cbor_validate_result_t, item->offset + item->header + (size_t)item->value.length);
+    case CBOR_TYPE_ARRAY:
+    case CBOR_TYPE_MAP:
+    case CBOR_TYPE_TAG:
+        break;
+    default:
+        return OK(cbor_validate_result_t, (size_t)item->offset + item->header);
+    }
+
+    // Containers, tags and indefinite strings end wherever their contents end
+    cbor_process_result_t skipped = cbor_skip((slice_t) {
+        .len = doc.len - item->offset,
+        .ptr = doc.ptr + item->offset,
+    });
+    if (skipped.is_error) {
+        return ERR(cbor_validate_result_t, skipped.err);
+    }
+    return OK(cbor_validate_result_t, (size_t)(skipped.ok - doc.ptr));
+}
+/*--------------------------------------------------------------------------*/
+// Error context of the process functions, per thread on hosted targets
+#ifdef CBOR_ERROR_CONTEXT
+#ifdef TARGET_EMBEDDED
+#define CBOR_THREAD_LOCAL
+#else
+#define CBOR_THREAD_LOCAL _Thread_local
+#endif
+
+static CBOR_THREAD_LOCAL struct {
+    cbor_error_context_t last;
+    const uint8_t* base;    // Offsets are counted from here
+    uint8_t depth;          // Walks in progress
+} cbor_error_state;
+
+const cbor_error_context_t* cbor_last_error(void) {
+    return &cbor_error_state.last;
+}
+
+static void cbor_error_enter(const uint8_t* start) {
+    if (cbor_error_state.depth++ == 0) {
+        cbor_error_state.base = start;
+        cbor_error_state.last.set = 0;
+    }
+}
+
+static cbor_process_result_t cbor_error_leave(cbor_process_result_t result) {
+    cbor_error_state.depth--;
+    // A nested failure the processor recovered from is not the walk's error
+    if (!result.is_error && cbor_error_state.last.depth >= cbor_error_state.depth) {
+        cbor_error_state.last.set = 0;
+    }
+    return result;
+}
+
+static void cbor_error_record(cbor_parser_error_t error, const uint8_t* position, const uint8_t* end, uint8_t major) {
+    cbor_error_context_t* last = &cbor_error_state.last;
+    const uint8_t depth = (uint8_t)(cbor_error_state.depth - 1);
+    const uintptr_t base = (uintptr_t)cbor_error_state.base;
+    const size_t offset = position != NULL && (uintptr_t)position >= base ? (size_t)((uintptr_t)position - base) : 0;
+    // The innermost walk knows best, outer walks pass its failure on as PROCESSOR_ERROR
+    // at the item the processor was given. A deeper record before that item is from a
+    // nested failure the processor recovered from.
+    if (last->set && last->depth > depth && error == PROCESSOR_ERROR && last->offset >= offset) {
+        return;
+    }
+    *last = (cbor_error_context_t) {
+        .offset = offset,
+        .error = error,
+        .depth = depth,
+        .major_type = position != NULL && position < end ? position[0] >> 5 : major,
+        .set = 1,
+    };
+}
+
+#define CBOR_PROCESS_ERR(error, position, end, major) \
+    (cbor_error_record((error), (position), (end), (major)), ERR(cbor_process_result_t, (error)))
+#else
+static inline void cbor_error_enter(const uint8_t* start) {
+    (void)start;
+}
+
+static inline cbor_process_result_t cbor_error_leave(cbor_process_result_t result) {
+    return result;
+}
+
+#define CBOR_PROCESS_ERR(error, position, end, major) \
+    ((void)(position), (void)(end), (void)(major), ERR(cbor_process_result_t, (error)))
+#endif /* CBOR_ERROR_CONTEXT */
+
+// A processor ended the walk early at position
+#define CBOR_PROCESS_STOPPED(position) \
+    ((cbor_process_result_t) {.is_error=0, .stopped=1, .ok = (position)})
+/*--------------------------------------------------------------------------*/
+// Shared by cbor_process_array_items and cbor_process_map_items, one of the processors is set
+static cbor_process_result_t cbor_process_items(slice_t doc, const cbor_item_t* container, uint8_t type,
+    single_item_processor_function process_single, pair_item_processor_function process_pair, void* process_arg) {
+    const uint8_t major = type == CBOR_TYPE_MAP ? CBOR_MAJOR_TYPE_MAP : CBOR_MAJOR_TYPE_ARRAY;
+    if (doc.ptr == NULL || container == NULL) {
+        return CBOR_PROCESS_ERR(NULL_PTR_ERROR, NULL, NULL, major);
+    }
+    const uint8_t* end = doc.ptr + doc.len;
+    if (container->type != type) {
+        return CBOR_PROCESS_ERR(MALFORMED_INPUT_ERROR, doc.ptr + container->offset, end, major);
+    }
+
+    const int indefinite = container->flags & CBOR_ITEM_INDEFINITE;
+    size_t current = (size_t)container->offset + container->header;
+
+    for (uint64_t i = 0; indefinite || i < container->value.length; i++) {
+        if (current >= doc.len) {
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, doc.ptr + current, end, major);
+        }
+        if (indefinite && cbor_is_break(doc.ptr + current)) {
+            return OK(cbor_process_result_t, doc.ptr + current + 1);
+        }
+
+        cbor_item_t key = {0};
+        if (type == CBOR_TYPE_MAP) {
+            cbor_parse_item_result_t key_v = cbor_parse_item(doc, current);
+            if (key_v.is_error) {
+                return CBOR_PROCESS_ERR(key_v.err, doc.ptr + current, end, major);
+            }
+            key = key_v.ok;
+            cbor_validate_result_t key_end = cbor_item_end(doc, &key, NULL);
+            if (key_end.is_error) {
+                return CBOR_PROCESS_ERR(key_end.err, doc.ptr + current, end, major);
+            }
+            current = key_end.ok;
+        }
+
+        cbor_parse_item_result_t element = cbor_parse_item(doc, current);
+        if (element.is_error) {
+            return CBOR_PROCESS_ERR(element.err, doc.ptr + current, end, major);
+        }
+
+        cbor_custom_processor_result_t processed = CBOR_CUSTOM_PROCESSOR_OK();
+        if (process_single != NULL) {
+            processed = process_single(doc, &element.ok, process_arg);
+        }
+        else if (process_pair != NULL) {
+            processed = process_pair(doc, &key, &element.ok, process_arg);
+        }
+        if (processed.is_error) {
+            return CBOR_PROCESS_ERR(PROCESSOR_ERROR, doc.ptr + current, end, major);
+        }
+
+        cbor_validate_result_t element_end = cbor_item_end(doc, &element.ok, processed.consumed);
+        if (element_end.is_error) {
+            return CBOR_PROCESS_ERR(element_end.err, doc.ptr + current, end, major);
+        }
+        current = element_end.ok;
+        if (processed.stop) {
+            return CBOR_PROCESS_STOPPED(doc.ptr + current);
+        }
+    }
+    return OK(cbor_process_result_t, doc.ptr + current);
+}
+/*--------------------------------------------------------------------------*/
+cbor_process_result_t cbor_process_array_items(slice_t doc, const cbor_item_t* array, single_item_processor_function process_single, void* process_arg) {
+    cbor_error_enter(doc.ptr);
+    return cbor_error_leave(cbor_process_items(doc, array, CBOR_TYPE_ARRAY, process_single, NULL, process_arg));
+}
+/*--------------------------------------------------------------------------*/
+cbor_process_result_t cbor_process_map_items(slice_t doc, const cbor_item_t* map, pair_item_processor_function process_pair, void* process_arg) {
+    cbor_error_enter(doc.ptr);
+    return cbor_error_leave(cbor_process_items(doc, map, CBOR_TYPE_MAP, NULL, process_pair, process_arg));
+}
+/*--------------------------------------------------------------------------*/
+cbor_map_find_many_result_t cbor_map_find_many(cbor_map_t map, const slice_t* keys, slice_t* values, size_t count) {
+    if (map.inside == NULL || (count > 0 && (keys == NULL || values == NULL))) {
+        return ERR(cbor_map_find_many_result_t, NULL_PTR_ERROR);
+    }
+    for (size_t k = 0; k < count; k++) {
+        values[k] = (slice_t) {0};
+    }
+
+    uint8_t* current = map.inside;
+    uint8_t* const end = map.inside + map.max_size;
+    size_t found = 0;
+
+    for (uint32_t i = 0; map.length == CBOR_LENGTH_INDEFINITE || i < map.length; i++) {
+        if (current >= end) {
+            return ERR(cbor_map_find_many_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+        if (map.length == CBOR_LENGTH_INDEFINITE && cbor_is_break(current)) {
+            break;
+        }
+
+        // Encoded items are prefix free, a byte match means the whole key matches
+        size_t available = (size_t)(end - current);
+        uint8_t* value = NULL;
+        size_t match = count;
+        for (size_t k = 0; k < count; k++) {
+            if (values[k].ptr == NULL && keys[k].len > 0 && keys[k].len <= available &&
+                *current == *keys[k].ptr && memcmp(current, keys[k].ptr, keys[k].len) == 0) {
+                value = current + keys[k].len;
+                match = k;
+                break;
+            }
+        }
+        if (value == NULL) {
+            cbor_process_result_t key_end = cbor_skip_item((slice_t) {.len = available, .ptr = current});
+            if (key_end.is_error) {
+                return ERR(cbor_map_find_many_result_t, key_end.err);
+            }
+            value = key_end.ok;
+        }
+
+        cbor_process_result_t value_end = cbor_skip_item((slice_t) {.len = (size_t)(end - value), .ptr = value});
+        if (value_end.is_error) {
+            return ERR(cbor_map_find_many_result_t, value_end.err);
+        }
+        current = value_end.ok;
+
+        if (match < count) {
+            values[match] = (slice_t) {.len = (size_t)(current - value), .ptr = value};
+            if (++found == count) {
+                break;
+            }
+        }
+    }
+    return OK(cbor_map_find_many_result_t, found);
+}
+/*--------------------------------------------------------------------------*/
+cbor_array_get_result_t cbor_array_get(cbor_array_t array, size_t index) {
+    if (array.inside == NULL) {
+        return ERR(cbor_array_get_result_t, NULL_PTR_ERROR);
+    }
+    if (array.length != CBOR_LENGTH_INDEFINITE && index >= array.length) {
+        return ERR(cbor_array_get_result_t, KEY_NOT_FOUND_ERROR);
+    }
+
+    uint8_t* current = array.inside;
+    uint8_t* const end = array.inside + array.max_size;
+    for (size_t i = 0; ; i++) {
+        if (current >= end) {
+            return ERR(cbor_array_get_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+        if (array.length == CBOR_LENGTH_INDEFINITE && cbor_is_break(current)) {
+            return ERR(cbor_array_get_result_t, KEY_NOT_FOUND_ERROR);
+        }
+        cbor_process_result_t element_end = cbor_skip_item((slice_t) {.len = (size_t)(end - current), .ptr = current});
+        if (element_end.is_error) {
+            return ERR(cbor_array_get_result_t, element_end.err);
+        }
+        if (i == index) {
+            return OK(cbor_array_get_result_t, ((slice_t) {.len = (size_t)(element_end.ok - current), .ptr = current}));
+        }
+        current = element_end.ok;
+    }
+}
+/*--------------------------------------------------------------------------*/
+cbor_map_find_result_t cbor_map_find(cbor_map_t map, slice_t key) {
+    slice_t value = {0};
+    cbor_map_find_many_result_t found = cbor_map_find_many(map, &key, &value, 1);
+    if (found.is_error) {
+        return ERR(cbor_map_find_result_t, found.err);
+    }
+    if (found.ok == 0) {
+        return ERR(cbor_map_find_result_t, KEY_NOT_FOUND_ERROR);
+    }
+    return OK(cbor_map_find_result_t, value);
+}
+/*--------------------------------------------------------------------------*/
+// Behind cbor_validate, keeps a frame per open container to enforce max_depth
+static cbor_process_result_t cbor_walk(slice_t buf, const cbor_limits_t* limits) {
+    if (buf.ptr == NULL) {
+        return ERR(cbor_process_result_t, NULL_PTR_ERROR);
+    }
+    if (buf.len == 0) {
+        return ERR(cbor_process_result_t, EMPTY_BUFFER_ERROR);
+    }
+
+    size_t max_depth = CBOR_MAX_DEPTH;
+    size_t items_left = SIZE_MAX;
+    uint64_t max_string_length = UINT64_MAX;
+    if (limits != NULL) {
+        if (limits->max_depth != 0 && limits->max_depth < max_depth) {
+            max_depth = limits->max_depth;
+        }
+        if (limits->max_items != 0) {
+            items_left = limits->max_items;
+        }
+        if (limits->max_string_length != 0) {
+            max_string_length = limits->max_string_length;
+        }
+    }
+
+    // Items left in each open container, SIZE_MAX for indefinite length ones.
+    // Frames with a string major type are indefinite strings, their items are chunks.
+    // Indefinite maps track whether a value is still missing in odd.
+    struct {
+        size_t remaining;
+        uint8_t major;
+        uint8_t odd;
+    } stack[CBOR_MAX_DEPTH];
+    size_t depth = 0;
+
+    uint64_t string_total = 0;  // Length of the open indefinite string so far, they cannot nest
+    int tagged = 0;             // A tag is waiting for its item
+
+    uint8_t* current = buf.ptr;
+    uint8_t* const end = buf.ptr + buf.len;
+
+    for (;;) {
+        if (current >= end) {
+            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+
+        const cbor_initial_byte_t ib = cbor_initial_byte_table[*current];
+
+        if (ib.flags & CBOR_IB_BREAK) {
+            if (depth == 0 || stack[depth - 1].remaining != SIZE_MAX || tagged ||
+                (stack[depth - 1].major == CBOR_MAJOR_TYPE_MAP && stack[depth - 1].odd)) {
+                return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+            }
+            current++;
+            depth--;
+        }
+        else {
+            if (ib.flags & CBOR_IB_RESERVED) {
+                return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+            }
+            size_t available = (size_t)(end - current);
+            if (ib.size >= available) {
+                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            }
+            if (items_left-- == 0) {
+                return ERR(cbor_process_result_t, LIMIT_EXCEEDED_ERROR);
+            }
+
+            // Chunks of an indefinite string must be definite strings of the same type
+            int chunk = depth > 0 &&
+                (stack[depth - 1].major == CBOR_MAJOR_TYPE_BYTE_STRING || stack[depth - 1].major == CBOR_MAJOR_TYPE_TEXT_STRING);
+            if (chunk && (ib.major != stack[depth - 1].major || (ib.flags & CBOR_IB_INDEFINITE))) {
+                return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+            }
+
+            uint64_t argument = cbor_argument_to_fixed(cbor_read_argument(ib, current));
+            current += 1 + ib.size;
+            available -= 1 + ib.size;
+            tagged = 0;
+
+            if (ib.flags & CBOR_IB_INDEFINITE) {
+                if (depth == max_depth) {
+                    return ERR(cbor_process_result_t, DEPTH_LIMIT_ERROR);
+                }
+                stack[depth].remaining = SIZE_MAX;
+                stack[depth].major = ib.major;
+                stack[depth].odd = 0;
+                depth++;
+                string_total = 0;
+                continue;
+            }
+
+            switch (ib.major) {
+            case CBOR_MAJOR_TYPE_BYTE_STRING:
+            case CBOR_MAJOR_TYPE_TEXT_STRING:
+                if (argument > available) {
+                    return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                }
+                string_total = chunk ? string_total + argument : argument;
+                if (string_total > max_string_length) {
+                    return ERR(cbor_process_result_t, LIMIT_EXCEEDED_ERROR);
+                }
+                current += argument;
+                break;
+            case CBOR_MAJOR_TYPE_ARRAY:
+            case CBOR_MAJOR_TYPE_MAP:
+                if (argument == 0) {
+                    break;
+                }
+                // Every item takes at least one byte, so larger counts cannot fit
+                if (argument > available || (ib.major == CBOR_MAJOR_TYPE_MAP && argument > available / 2)) {
+                    return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                }
+                if (depth == max_depth) {
+                    return ERR(cbor_process_result_t, DEPTH_LIMIT_ERROR);
+                }
+                stack[depth].remaining = ib.major == CBOR_MAJOR_TYPE_MAP ? (size_t)argument * 2 : (size_t)argument;
+                stack[depth].major = ib.major;
+                depth++;
+                continue;
+            case CBOR_MAJOR_TYPE_TAG:
+                // The tagged item follows and completes this one
+                tagged = 1;
+                continue;
+            case CBOR_MAJOR_TYPE_SIMPLE:
+                // Two byte simple values below 32 are not well-formed
+                if (ib.size == 1 && argument < 32) {
+                    return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+                }
+                break;
+            default:
+                // Integers are header only
+                break;
+            }
+        }
+
+        // An item just ended, close every definite container it completes
+        while (depth > 0 && stack[depth - 1].remaining != SIZE_MAX) {
+            if (--stack[depth - 1].remaining > 0) {
+                break;
+            }
+            depth--;
+        }
+        if (depth > 0 && stack[depth - 1].major == CBOR_MAJOR_TYPE_MAP) {
+            stack[depth - 1].odd ^= 1;
+        }
+
+        if (depth == 0) {
+            return OK(cbor_process_result_t, current);
+        }
+    }
+}
+/*--------------------------------------------------------------------------*/
+cbor_process_result_t cbor_skip(slice_t buf) {
+    if (buf.ptr == NULL) {
         return ERR(cbor_process_result_t, NULL_PTR_ERROR);
     }
+    if (buf.len == 0) {
+        return ERR(cbor_process_result_t, EMPTY_BUFFER_ERROR);
+    }
+
+    // Definite containers and tags add their items to pending, so nesting them
+    // takes no memory. Only indefinite ones end at a break and need a frame,
+    // which keeps the pending count of the level around them. Inside an
+    // indefinite container pending is 0 between its items.
+    struct {
+        size_t pending;
+        uint8_t major;
+        uint8_t odd;
+    } stack[CBOR_MAX_DEPTH];
+    size_t depth = 0;
+    size_t pending = 1;
+
+    uint8_t* current = buf.ptr;
+    uint8_t* const end = buf.ptr + buf.len;
+
+    for (;;) {
+        if (current >= end) {
+            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+
+        const cbor_initial_byte_t ib = cbor_initial_byte_table[*current];
+
+        if (ib.flags & CBOR_IB_BREAK) {
+            if (depth == 0 || pending != 0 ||
+                (stack[depth - 1].major == CBOR_MAJOR_TYPE_MAP && stack[depth - 1].odd)) {
+                return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+            }
+            current++;
+            pending = stack[--depth].pending;
+        }
+        else {
+            if (ib.flags & CBOR_IB_RESERVED) {
+                return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+            }
+            size_t available = (size_t)(end - current);
+            if (ib.size >= available) {
+                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            }
+
+            // Chunks of an indefinite string must be definite strings of the same type
+            if (depth > 0 &&
+                (stack[depth - 1].major == CBOR_MAJOR_TYPE_BYTE_STRING || stack[depth - 1].major == CBOR_MAJOR_TYPE_TEXT_STRING) &&
+                (ib.major != stack[depth - 1].major || (ib.flags & CBOR_IB_INDEFINITE))) {
+                return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+            }
+
+            uint64_t argument = cbor_argument_to_fixed(cbor_read_argument(ib, current));
+            current += 1 + ib.size;
+            available -= 1 + ib.size;
+            if (pending > 0) {
+                pending--;
+            }
+
+            if (ib.flags & CBOR_IB_INDEFINITE) {
+                if (depth == CBOR_MAX_DEPTH) {
+                    return ERR(cbor_process_result_t, DEPTH_LIMIT_ERROR);
+                }
+                stack[depth].pending = pending;
+                stack[depth].major = ib.major;
+                stack[depth].odd = 0;
+                depth++;
+                pending = 0;
+                continue;
+            }
+
+            // Every pending item takes at least one byte, so larger counts cannot fit
+            switch (ib.major) {
+            case CBOR_MAJOR_TYPE_BYTE_STRING:
+            case CBOR_MAJOR_TYPE_TEXT_STRING:
+                if (argument > available) {
+                    return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                }
+                current += argument;
+                break;
+            case CBOR_MAJOR_TYPE_ARRAY:
+                if (argument > available || pending + (size_t)argument > available) {
+                    return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                }
+                pending += (size_t)argument;
+                break;
+            case CBOR_MAJOR_TYPE_MAP:
+                if (argument > available / 2 || pending + (size_t)argument * 2 > available) {
+                    return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                }
+                pending += (size_t)argument * 2;
+                break;
+            case CBOR_MAJOR_TYPE_TAG:
+                // The tagged item follows and completes this one
+                pending++;
+                break;
+            case CBOR_MAJOR_TYPE_SIMPLE:
+                // Two byte simple values below 32 are not well-formed
+                if (ib.size == 1 && argument < 32) {
+                    return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+                }
+                break;
+            default:
+                // Integers are header only
+                break;
+            }
+        }
+
+        if (pending == 0) {
+            if (depth == 0) {
+                return OK(cbor_process_result_t, current);
+            }
+            // An item of the open indefinite container just ended
+            if (stack[depth - 1].major == CBOR_MAJOR_TYPE_MAP) {
+                stack[depth - 1].odd ^= 1;
+            }
+        }
+    }
+}
+/*--------------------------------------------------------------------------*/
+cbor_validate_result_t cbor_validate(slice_t buf, const cbor_limits_t* limits) {
+    cbor_process_result_t end = cbor_walk(buf, limits);
+    if (end.is_error) {
+        return ERR(cbor_validate_result_t, end.err);
+    }
+    return OK(cbor_validate_result_t, (size_t)(end.ok - buf.ptr));
+}
+/*--------------------------------------------------------------------------*/
+static cbor_process_result_t cbor_process_chunks(cbor_array_t string_chunks, cbor_type_t expected_type, single_processor_function process_single, void* process_arg) {
+    const uint8_t string_major = expected_type == CBOR_TYPE_TEXT_STRING ? CBOR_MAJOR_TYPE_TEXT_STRING : CBOR_MAJOR_TYPE_BYTE_STRING;
+    if (string_chunks.inside == NULL) {
+        return CBOR_PROCESS_ERR(NULL_PTR_ERROR, NULL, NULL, string_major);
+    }
+    const uint8_t* end = string_chunks.inside + string_chunks.max_size;
     
     uint8_t* current = string_chunks.inside;
     
@@ -213,14 +924,13 @@ cbor_process_result_t cbor_process_indefinite_string(cbor_array_t string_chunks,
     while (!cbor_is_break(current)) {
         // Check bounds
         if (current >= string_chunks.inside + string_chunks.max_size) {
-            printf("ERROR: String processing exceeded bounds in indefinite string\n");
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, string_major);
         }
         
         // Calculate remaining bytes
         size_t remaining = string_chunks.max_size - (current - string_chunks.inside);
         if (remaining == 0) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, string_major);
         }
         
         slice_t chunk_slice = (slice_t) {
@@ -231,48 +941,58 @@ cbor_process_result_t cbor_process_indefinite_string(cbor_array_t string_chunks,
         cbor_parse_result_t chunk = cbor_parse(chunk_slice);
 
         if (chunk.is_error) {
-            printf("STRING CHUNK RETURNED ERROR: %d\n", chunk.err);
-            return ERR(cbor_process_result_t, chunk.err);
+            return CBOR_PROCESS_ERR(chunk.err, current, end, string_major);
         }
 
         // Verify the chunk is the correct string type
         if (chunk.ok.type != expected_type) {
-            printf("ERROR: Mixed string types in indefinite string (expected %d, got %d)\n", expected_type, chunk.ok.type);
-            return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+            return CBOR_PROCESS_ERR(MALFORMED_INPUT_ERROR, current, end, string_major);
         }
 
         // Verify it's a definite length string chunk
         if (chunk.ok.argument.tag == ARGUMENT_NONE) {
-            printf("ERROR: Indefinite length chunk within indefinite string\n");
-            return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+            return CBOR_PROCESS_ERR(MALFORMED_INPUT_ERROR, current, end, string_major);
         }
 
+        cbor_custom_processor_result_t processed = CBOR_CUSTOM_PROCESSOR_OK();
         if (process_single != NULL) {
-            process_single(&chunk.ok, process_arg);
+            processed = process_single(&chunk.ok, process_arg);
+            if (processed.is_error) {
+                return CBOR_PROCESS_ERR(PROCESSOR_ERROR, current, end, string_major);
+            }
         }
 
         // Validate next pointer bounds
         if (chunk.ok.next == NULL || chunk.ok.next < string_chunks.inside || 
             chunk.ok.next > string_chunks.inside + string_chunks.max_size) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, string_major);
         }
         
         current = chunk.ok.next;
+        if (processed.stop) {
+            return CBOR_PROCESS_STOPPED(current);
+        }
     }
     
     // Validate break code position
     if (current >= string_chunks.inside + string_chunks.max_size) {
-        return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+        return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, string_major);
     }
     
     // Skip over the break code
     return OK(cbor_process_result_t, current + 1);
 }
 /*--------------------------------------------------------------------------*/
-cbor_process_result_t cbor_process_array(cbor_array_t array, single_processor_function process_single, void* process_arg) {
+cbor_process_result_t cbor_process_indefinite_string(cbor_array_t string_chunks, cbor_type_t expected_type, single_processor_function process_single, void* process_arg) {
+    cbor_error_enter(string_chunks.inside);
+    return cbor_error_leave(cbor_process_chunks(string_chunks, expected_type, process_single, process_arg));
+}
+/*--------------------------------------------------------------------------*/
+static cbor_process_result_t cbor_process_elements(cbor_array_t array, single_processor_function process_single, void* process_arg) {
     if (array.inside == NULL) {
-        return ERR(cbor_process_result_t, NULL_PTR_ERROR);
+        return CBOR_PROCESS_ERR(NULL_PTR_ERROR, NULL, NULL, CBOR_MAJOR_TYPE_ARRAY);
     }
+    const uint8_t* end = array.inside + array.max_size;
     
     uint8_t* current = array.inside;
     
@@ -282,14 +1002,13 @@ cbor_process_result_t cbor_process_array(cbor_array_t array, single_processor_fu
         while (!cbor_is_break(current)) {
             // Check bounds
             if (current >= array.inside + array.max_size) {
-                printf("ERROR: Array processing exceeded bounds in indefinite array\n");
-                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_ARRAY);
             }
             
             // Calculate remaining bytes
             size_t remaining = array.max_size - (current - array.inside);
             if (remaining == 0) {
-                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_ARRAY);
             }
             
             slice_t element_slice = (slice_t) {
@@ -300,56 +1019,44 @@ cbor_process_result_t cbor_process_array(cbor_array_t array, single_processor_fu
             cbor_parse_result_t element = cbor_parse(element_slice);
 
             if (element.is_error) {
-                printf("ELEMENT RETURNED ERROR: %d\n", element.err);
-                return ERR(cbor_process_result_t, element.err);
+                return CBOR_PROCESS_ERR(element.err, current, end, CBOR_MAJOR_TYPE_ARRAY);
             }
 
+            cbor_custom_processor_result_t processed = CBOR_CUSTOM_PROCESSOR_OK();
             if (process_single != NULL) {
-                process_single(&element.ok, process_arg);
+                processed = process_single(&element.ok, process_arg);
+                if (processed.is_error) {
+                    return CBOR_PROCESS_ERR(PROCESSOR_ERROR, current, end, CBOR_MAJOR_TYPE_ARRAY);
+                }
+                // Take over the end of a value the processor already walked
+                if (element.ok.next == NULL && processed.consumed != NULL && processed.consumed > current) {
+                    element.ok.next = processed.consumed;
+                }
             }
 
             if (element.ok.next == NULL) {
-                if (element.ok.type == CBOR_TYPE_MAP) {
-                    cbor_process_result_t map_result = cbor_process_map(element.ok.value.map, NULL, process_arg);
-                    if (map_result.is_error) {
-                        return map_result;
-                    }
-                    element.ok.next = map_result.ok;
-                } 
-                else if (element.ok.type == CBOR_TYPE_ARRAY) {
-                    cbor_process_result_t array_result = cbor_process_array(element.ok.value.array, NULL, process_arg);
-                    if (array_result.is_error) {
-                        return array_result;
-                    }
-                    element.ok.next = array_result.ok;
-                }
-                else if (element.ok.type == CBOR_TYPE_BYTE_STRING && element.ok.argument.tag == ARGUMENT_NONE) {
-                    cbor_process_result_t string_result = cbor_process_indefinite_string(element.ok.value.array, CBOR_TYPE_BYTE_STRING, NULL, process_arg);
-                    if (string_result.is_error) {
-                        return string_result;
-                    }
-                    element.ok.next = string_result.ok;
-                }
-                else if (element.ok.type == CBOR_TYPE_TEXT_STRING && element.ok.argument.tag == ARGUMENT_NONE) {
-                    cbor_process_result_t string_result = cbor_process_indefinite_string(element.ok.value.array, CBOR_TYPE_TEXT_STRING, NULL, process_arg);
-                    if (string_result.is_error) {
-                        return string_result;
-                    }
-                    element.ok.next = string_result.ok;
+                // Containers and indefinite strings end wherever their contents end
+                cbor_process_result_t skipped = cbor_skip(element_slice);
+                if (skipped.is_error) {
+                    return CBOR_PROCESS_ERR(skipped.err, current, end, CBOR_MAJOR_TYPE_ARRAY);
                 }
+                element.ok.next = skipped.ok;
             }
             
             // Validate next pointer bounds
             if (element.ok.next == NULL || element.ok.next < array.inside || 
                 element.ok.next > array.inside + array.max_size) {
-                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_ARRAY);
             }
             
             current = element.ok.next;
+            if (processed.stop) {
+                return CBOR_PROCESS_STOPPED(current);
+            }
         }
         // Validate break code position
         if (current >= array.inside + array.max_size) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_ARRAY);
         }
         // Skip over the break code
         return OK(cbor_process_result_t, current + 1);
@@ -363,13 +1070,13 @@ cbor_process_result_t cbor_process_array(cbor_array_t array, single_processor_fu
     for (size_t i = 0; i < array.length; i++) {
         // Check bounds
         if (current >= array.inside + array.max_size) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_ARRAY);
         }
         
         // Calculate remaining bytes
         size_t remaining = array.max_size - (current - array.inside);
         if (remaining == 0) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_ARRAY);
         }
         
         slice_t element_slice = (slice_t) {
@@ -380,61 +1087,54 @@ cbor_process_result_t cbor_process_array(cbor_array_t array, single_processor_fu
         cbor_parse_result_t element = cbor_parse(element_slice);
 
         if (element.is_error) {
-            printf("ELEMENT RETURNED ERROR: %d\n", element.err);
-            return ERR(cbor_process_result_t, element.err);
+            return CBOR_PROCESS_ERR(element.err, current, end, CBOR_MAJOR_TYPE_ARRAY);
         }
 
+        cbor_custom_processor_result_t processed = CBOR_CUSTOM_PROCESSOR_OK();
         if (process_single != NULL) {
-            // printf("Current: %3d", current - buf);
-            process_single(&element.ok, process_arg);
+            processed = process_single(&element.ok, process_arg);
+            if (processed.is_error) {
+                return CBOR_PROCESS_ERR(PROCESSOR_ERROR, current, end, CBOR_MAJOR_TYPE_ARRAY);
+            }
+            // Take over the end of a value the processor already walked
+            if (element.ok.next == NULL && processed.consumed != NULL && processed.consumed > current) {
+                element.ok.next = processed.consumed;
+            }
         }
 
         if (element.ok.next == NULL) {
-            if (element.ok.type == CBOR_TYPE_MAP) {
-                cbor_process_result_t map_result = cbor_process_map(element.ok.value.map, NULL, process_arg);
-                if (map_result.is_error) {
-                    return map_result;
-                }
-                element.ok.next = map_result.ok;
-            } 
-            else if (element.ok.type == CBOR_TYPE_ARRAY) {
-                cbor_process_result_t array_result = cbor_process_array(element.ok.value.array, NULL, process_arg);
-                if (array_result.is_error) {
-                    return array_result;
-                }
-                element.ok.next = array_result.ok;
-            }
-            else if (element.ok.type == CBOR_TYPE_BYTE_STRING && element.ok.argument.tag == ARGUMENT_NONE) {
-                cbor_process_result_t string_result = cbor_process_indefinite_string(element.ok.value.array, CBOR_TYPE_BYTE_STRING, NULL, process_arg);
-                if (string_result.is_error) {
-                    return string_result;
-                }
-                element.ok.next = string_result.ok;
-            }
-            else if (element.ok.type == CBOR_TYPE_TEXT_STRING && element.ok.argument.tag == ARGUMENT_NONE) {
-                cbor_process_result_t string_result = cbor_process_indefinite_string(element.ok.value.array, CBOR_TYPE_TEXT_STRING, NULL, process_arg);
-                if (string_result.is_error) {
-                    return string_result;
-                }
-                element.ok.next = string_result.ok;
+            // Containers and indefinite strings end wherever their contents end
+            cbor_process_result_t skipped = cbor_skip(element_slice);
+            if (skipped.is_error) {
+                return CBOR_PROCESS_ERR(skipped.err, current, end, CBOR_MAJOR_TYPE_ARRAY);
             }
+            element.ok.next = skipped.ok;
         }
 
         // Validate next pointer bounds
         if (element.ok.next == NULL || element.ok.next < array.inside || 
             element.ok.next > array.inside + array.max_size) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_ARRAY);
         }
         
         current = element.ok.next;
+        if (processed.stop) {
+            return CBOR_PROCESS_STOPPED(current);
+        }
     }
     return OK(cbor_process_result_t, current);
 }
 /*--------------------------------------------------------------------------*/
-cbor_process_result_t cbor_process_map(cbor_map_t map, pair_processor_function process_pair, void* process_arg) {
+cbor_process_result_t cbor_process_array(cbor_array_t array, single_processor_function process_single, void* process_arg) {
+    cbor_error_enter(array.inside);
+    return cbor_error_leave(cbor_process_elements(array, process_single, process_arg));
+}
+/*--------------------------------------------------------------------------*/
+static cbor_process_result_t cbor_process_pairs(cbor_map_t map, pair_processor_function process_pair, void* process_arg) {
     if (map.inside == NULL) {
-        return ERR(cbor_process_result_t, NULL_PTR_ERROR);
+        return CBOR_PROCESS_ERR(NULL_PTR_ERROR, NULL, NULL, CBOR_MAJOR_TYPE_MAP);
     }
+    const uint8_t* end = map.inside + map.max_size;
     
     uint8_t* current = map.inside;
     
@@ -444,15 +1144,13 @@ cbor_process_result_t cbor_process_map(cbor_map_t map, pair_processor_function p
         while (!cbor_is_break(current)) {
             // Check bounds
             if (current >= map.inside + map.max_size) {
-                printf("ERROR: Map processing exceeded bounds in indefinite map\n");
-                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_MAP);
             }
             
             // Calculate remaining bytes for key
             size_t remaining = map.max_size - (current - map.inside);
             if (remaining == 0) {
-                printf("ERROR: Map processing no bytes remain to parse the key\n");
-                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_MAP);
             }
             
             // Parse key
@@ -463,22 +1161,19 @@ cbor_process_result_t cbor_process_map(cbor_map_t map, pair_processor_function p
             cbor_parse_result_t key_v = cbor_parse(key_slice);
 
             if (key_v.is_error) {
-                printf("KEY RETURNED ERROR: %d\n", key_v.err);
-                return ERR(cbor_process_result_t, key_v.err);
+                return CBOR_PROCESS_ERR(key_v.err, current, end, CBOR_MAJOR_TYPE_MAP);
             }
 
             // Validate key next pointer
             if (key_v.ok.next == NULL || key_v.ok.next < map.inside || 
                 key_v.ok.next > map.inside + map.max_size) {
-                printf("ERROR: Invalid next pointer for key\n");
-                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_MAP);
             }
 
             // Calculate remaining bytes for value
             remaining = map.max_size - (key_v.ok.next - map.inside);
             if (remaining == 0) {
-                printf("ERROR: Map processing no bytes remain to parse the value\n");
-                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, key_v.ok.next, end, CBOR_MAJOR_TYPE_MAP);
             }
             
             // Parse value
@@ -489,42 +1184,44 @@ cbor_process_result_t cbor_process_map(cbor_map_t map, pair_processor_function p
             cbor_parse_result_t value_v = cbor_parse(value_slice);
 
             if (value_v.is_error) {
-                printf("VALUE RETURNED ERROR: %d\n", value_v.err);
-                return ERR(cbor_process_result_t, value_v.err);
+                return CBOR_PROCESS_ERR(value_v.err, key_v.ok.next, end, CBOR_MAJOR_TYPE_MAP);
             }
 
+            cbor_custom_processor_result_t processed = CBOR_CUSTOM_PROCESSOR_OK();
             if (process_pair != NULL) {
-                process_pair((const cbor_value_t*)&key_v.ok, (const cbor_value_t*)&value_v.ok, process_arg);
+                processed = process_pair((const cbor_value_t*)&key_v.ok, (const cbor_value_t*)&value_v.ok, process_arg);
+                if (processed.is_error) {
+                    return CBOR_PROCESS_ERR(PROCESSOR_ERROR, key_v.ok.next, end, CBOR_MAJOR_TYPE_MAP);
+                }
+                // Take over the end of a value the processor already walked
+                if (value_v.ok.next == NULL && processed.consumed != NULL && processed.consumed > key_v.ok.next) {
+                    value_v.ok.next = processed.consumed;
+                }
             }
 
             if (value_v.ok.next == NULL) {
-                if (value_v.ok.type == CBOR_TYPE_MAP) {
-                    cbor_process_result_t map_result = cbor_process_map(value_v.ok.value.map, NULL, process_arg);
-                    if (map_result.is_error) {
-                        return map_result;
-                    }
-                    value_v.ok.next = map_result.ok;
-                }
-                else if (value_v.ok.type == CBOR_TYPE_ARRAY) {
-                    cbor_process_result_t array_result = cbor_process_array(value_v.ok.value.array, NULL, process_arg);
-                    if (array_result.is_error) {
-                        return array_result;
-                    }
-                    value_v.ok.next = array_result.ok;
+                // Containers and indefinite strings end wherever their contents end
+                cbor_process_result_t skipped = cbor_skip(value_slice);
+                if (skipped.is_error) {
+                    return CBOR_PROCESS_ERR(skipped.err, key_v.ok.next, end, CBOR_MAJOR_TYPE_MAP);
                 }
+                value_v.ok.next = skipped.ok;
             }
             
             // Validate value next pointer
             if (value_v.ok.next == NULL || value_v.ok.next < map.inside || 
                 value_v.ok.next > map.inside + map.max_size) {
-                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, key_v.ok.next, end, CBOR_MAJOR_TYPE_MAP);
             }
             
             current = value_v.ok.next;
+            if (processed.stop) {
+                return CBOR_PROCESS_STOPPED(current);
+            }
         }
         // Validate break code position
         if (current >= map.inside + map.max_size) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_MAP);
         }
         // Skip over the break code
         return OK(cbor_process_result_t, current + 1);
@@ -538,13 +1235,13 @@ cbor_process_result_t cbor_process_map(cbor_map_t map, pair_processor_function p
     for (size_t i = 0; i < map.length; i++) {
         // Check bounds
         if (current >= map.inside + map.max_size) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_MAP);
         }
         
         // Calculate remaining bytes for key
         size_t remaining = map.max_size - (current - map.inside);
         if (remaining == 0) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_MAP);
         }
         
         slice_t key_slice = {
@@ -554,20 +1251,19 @@ cbor_process_result_t cbor_process_map(cbor_map_t map, pair_processor_function p
         cbor_parse_result_t key_v = cbor_parse(key_slice);
 
         if (key_v.is_error) {
-            printf("KEY RETURNED ERROR: %d\n", key_v.err);
-            return ERR(cbor_process_result_t, key_v.err);
+            return CBOR_PROCESS_ERR(key_v.err, current, end, CBOR_MAJOR_TYPE_MAP);
         }
 
         // Validate key next pointer
         if (key_v.ok.next == NULL || key_v.ok.next < map.inside || 
             key_v.ok.next > map.inside + map.max_size) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, current, end, CBOR_MAJOR_TYPE_MAP);
         }
 
         // Calculate remaining bytes for value
         remaining = map.max_size - (key_v.ok.next - map.inside);
         if (remaining == 0) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, key_v.ok.next, end, CBOR_MAJOR_TYPE_MAP);
         }
         
         slice_t value_slice = {
@@ -577,55 +1273,48 @@ cbor_process_result_t cbor_process_map(cbor_map_t map, pair_processor_function p
         cbor_parse_result_t value_v = cbor_parse(value_slice);
 
         if (value_v.is_error) {
-            printf("VALUE RETURNED ERROR: %d\n", value_v.err);
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(value_v.err, key_v.ok.next, end, CBOR_MAJOR_TYPE_MAP);
         }
 
+        cbor_custom_processor_result_t processed = CBOR_CUSTOM_PROCESSOR_OK();
         if (process_pair != NULL) {
-            process_pair((const cbor_value_t*)&key_v.ok, (const cbor_value_t*)&value_v.ok, process_arg);
+            processed = process_pair((const cbor_value_t*)&key_v.ok, (const cbor_value_t*)&value_v.ok, process_arg);
+            if (processed.is_error) {
+                return CBOR_PROCESS_ERR(PROCESSOR_ERROR, key_v.ok.next, end, CBOR_MAJOR_TYPE_MAP);
+            }
+            // Take over the end of a value the processor already walked
+            if (value_v.ok.next == NULL && processed.consumed != NULL && processed.consumed > key_v.ok.next) {
+                value_v.ok.next = processed.consumed;
+            }
         }
 
         if (value_v.ok.next == NULL) {
-            if (value_v.ok.type == CBOR_TYPE_MAP) {
-                cbor_process_result_t map_result = cbor_process_map(value_v.ok.value.map, NULL, process_arg);
-                if (map_result.is_error) {
-                    return map_result;
-                }
-                value_v.ok.next = map_result.ok;
-            }
-            else if (value_v.ok.type == CBOR_TYPE_ARRAY) {
-                cbor_process_result_t array_result = cbor_process_array(value_v.ok.value.array, NULL, process_arg);
-                if (array_result.is_error) {
-                    return array_result;
-                }
-                value_v.ok.next = array_result.ok;
-            }
-            else if (value_v.ok.type == CBOR_TYPE_BYTE_STRING && value_v.ok.argument.tag == ARGUMENT_NONE) {
-                cbor_process_result_t string_result = cbor_process_indefinite_string(value_v.ok.value.array, CBOR_TYPE_BYTE_STRING, NULL, process_arg);
-                if (string_result.is_error) {
-                    return string_result;
-                }
-                value_v.ok.next = string_result.ok;
-            }
-            else if (value_v.ok.type == CBOR_TYPE_TEXT_STRING && value_v.ok.argument.tag == ARGUMENT_NONE) {
-                cbor_process_result_t string_result = cbor_process_indefinite_string(value_v.ok.value.array, CBOR_TYPE_TEXT_STRING, NULL, process_arg);
-                if (string_result.is_error) {
-                    return string_result;
-                }
-                value_v.ok.next = string_result.ok;
+            // Containers and indefinite strings end wherever their contents end
+            cbor_process_result_t skipped = cbor_skip(value_slice);
+            if (skipped.is_error) {
+                return CBOR_PROCESS_ERR(skipped.err, key_v.ok.next, end, CBOR_MAJOR_TYPE_MAP);
             }
+            value_v.ok.next = skipped.ok;
         }
         
         // Validate value next pointer
         if (value_v.ok.next == NULL || value_v.ok.next < map.inside || 
             value_v.ok.next > map.inside + map.max_size) {
-            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            return CBOR_PROCESS_ERR(BUFFER_OVERFLOW_ERROR, key_v.ok.next, end, CBOR_MAJOR_TYPE_MAP);
         }
         
         current = value_v.ok.next;
+        if (processed.stop) {
+            return CBOR_PROCESS_STOPPED(current);
+        }
     }
     return OK(cbor_process_result_t, current);
 }
+/*--------------------------------------------------------------------------*/
+cbor_process_result_t cbor_process_map(cbor_map_t map, pair_processor_function process_pair, void* process_arg) {
+    cbor_error_enter(map.inside);
+    return cbor_error_leave(cbor_process_pairs(map, process_pair, process_arg));
+}
 
 /********************************
  * 
@@ -803,20 +1492,52 @@ cbor_encode_result_t cbor_encode_simple(cbor_simple_t simple, slice_t target) {
     return OK(cbor_encode_result_t, target);
 }
 
-enum cbor_float_precision {
-    CBOR_FLOAT_PRECISION_HALF,
-    CBOR_FLOAT_PRECISION_SINGLE,
-    CBOR_FLOAT_PRECISION_DOUBLE
-};
+cbor_encode_result_t cbor_encode_double(double value, slice_t target) {
+    if (target.len < 9) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_BUFFER_OVERFLOW);
+    }
 
+    target.ptr[0] = (uint8_t)((CBOR_MAJOR_TYPE_SIMPLE << 5) | 27);
+    uint64_t bytes;
+    memcpy(&bytes, &value, sizeof(value));
+    bytes = htobe64(bytes);
+    memcpy(&target.ptr[1], &bytes, sizeof(bytes));
+    target.len = 9;
+    return OK(cbor_encode_result_t, target);
+}
+
+cbor_encode_result_t cbor_encode_tag(uint64_t number, slice_t target) {
+    uint8_t size = number <= 23 ? 0 : number <= UINT8_MAX ? 1 : number <= UINT16_MAX ? 2 : number <= UINT32_MAX ? 4 : 8;
+    if (target.len < 1u + size) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_BUFFER_OVERFLOW);
+    }
+
+    static const uint8_t additional_info[9] = {0, 24, 25, 0, 26, 0, 0, 0, 27};
+    target.ptr[0] = (uint8_t)((CBOR_MAJOR_TYPE_TAG << 5) | (size == 0 ? number : additional_info[size]));
+    for (uint8_t i = 0; i < size; i++) {
+        target.ptr[1 + i] = (uint8_t)(number >> (8 * (size - 1 - i)));
+    }
+    target.len = 1u + size;
+    return OK(cbor_encode_result_t, target);
+}
+
+// Half precision rounds values that do not fit
 cbor_encode_result_t cbor_encode_float(float value, enum cbor_float_precision precision, slice_t target) {
-    if (target.len < 5) {
+    if (precision == CBOR_FLOAT_PRECISION_DOUBLE) {
+        return cbor_encode_double(float_to_double(value), target);
+    }
+    if (target.len < (precision == CBOR_FLOAT_PRECISION_HALF ? 3u : 5u)) {
         return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_BUFFER_OVERFLOW);
     }
 
     switch (precision) {
-        case CBOR_FLOAT_PRECISION_HALF:
-            return ERR(cbor_encode_result_t, CBOR_ENCODER_TODO);
+        case CBOR_FLOAT_PRECISION_HALF: {
+            target.ptr[0] = (uint8_t)((CBOR_MAJOR_TYPE_SIMPLE << 5) | 25);
+            uint16_t half = htobe16(float_to_half(value));
+            memcpy(&target.ptr[1], &half, sizeof(half));
+            target.len = 3;
+            break;
+        }
         case CBOR_FLOAT_PRECISION_SINGLE:
             target.ptr[0] = (uint8_t)((CBOR_MAJOR_TYPE_SIMPLE << 5) | 26);
             uint32_t bytes;
@@ -826,7 +1547,7 @@ cbor_encode_result_t cbor_encode_float(float value, enum cbor_float_precision pr
             target.len = 5;
             break;
         case CBOR_FLOAT_PRECISION_DOUBLE:
-            return ERR(cbor_encode_result_t, CBOR_ENCODER_TODO);
+            break;
     }
 
     return OK(cbor_encode_result_t, target);
@@ -1079,11 +1800,50 @@ cbor_encode, cbor_value_t value, slice_t target) {
         case CBOR_TYPE_MAP:
             return ERR(cbor_encode_result_t, CBOR_ENCODER_UNKNOWN_SIZE);
         case CBOR_TYPE_TAG:
-            return ERR(cbor_encode_result_t, CBOR_ENCODER_TODO);
+        case CBOR_ENCODE_TYPE_TAGGED: {
+            const uint64_t number = value.type == CBOR_TYPE_TAG ? value.value.tag.number : value.value.tagged.number;
+            cbor_encode_result_t header = cbor_encode_tag(number, target);
+            if (header.is_error) {
+                return header;
+            }
+            slice_t rest = {.len = target.len - header.ok.len, .ptr = target.ptr + header.ok.len};
+            cbor_encode_result_t content;
+            if (value.type == CBOR_ENCODE_TYPE_TAGGED) {
+                if (value.value.tagged.item == NULL) {
+                    return ERR(cbor_encode_result_t, CBOR_ENCODER_NULL_PTR_ERROR);
+                }
+                content = cbor_encode(*value.value.tagged.item, rest);
+            }
+            else {
+                // Parsed tags carry their item already encoded
+                const slice_t encoded = value.value.tag.content;
+                if (encoded.ptr == NULL || encoded.len == 0) {
+                    return ERR(cbor_encode_result_t, CBOR_ENCODER_NULL_PTR_ERROR);
+                }
+                if (rest.len < encoded.len) {
+                    return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_BUFFER_OVERFLOW);
+                }
+                memcpy(rest.ptr, encoded.ptr, encoded.len);
+                content = OK(cbor_encode_result_t, ((slice_t){.len = encoded.len, .ptr = rest.ptr}));
+            }
+            if (content.is_error) {
+                return content;
+            }
+            target.len = header.ok.len + content.ok.len;
+            return OK(cbor_encode_result_t, target);
+        }
         case CBOR_TYPE_SIMPLE:
             return cbor_encode_simple(value.value.simple, target);
         case CBOR_TYPE_FLOAT:
-            return cbor_encode_float(value.value.floating, CBOR_FLOAT_PRECISION_DEFAULT, target);
+            // Parsed values are written back with the width they were read with
+            switch (cbor_value_float_precision(&value)) {
+            case CBOR_FLOAT_PRECISION_DOUBLE:
+                return cbor_encode_double(value.value.float64, target);
+            case CBOR_FLOAT_PRECISION_HALF:
+                return cbor_encode_float(value.value.floating, CBOR_FLOAT_PRECISION_HALF, target);
+            default:
+                return cbor_encode_float(value.value.floating, CBOR_FLOAT_PRECISION_DEFAULT, target);
+            }
         case CBOR_ENCODE_TYPE_VALUES:
             return cbor_encode_value_array(value.value.values, target);
         case CBOR_ENCODE_TYPE_PAIRS:
@@ -1104,6 +1864,8 @@ cbor_encode, cbor_value_t value, slice_t target) {
                 }
                 return OK(cbor_encode_result_t, result.ok);
             }
+        case CBOR_ENCODE_TYPE_TYPED_ARRAY:
+            return cbor_encode_typed_array(value.value.typed_array.tag, value.value.typed_array.ptr, value.value.typed_array.count, target);
         default:
             return ERR(cbor_encode_result_t, CBOR_ENCODER_TODO);
     }
@@ -48,7 +48,9 @@ typedef enum {
     CBOR_ENCODE_TYPE_PAIRS_INDEFINITE,
     CBOR_ENCODE_TYPE_BYTE_STRING_INDEFINITE,
     CBOR_ENCODE_TYPE_TEXT_STRING_INDEFINITE,
-    CBOR_ENCODE_TYPE_CUSTOM_ENCODER
+    CBOR_ENCODE_TYPE_CUSTOM_ENCODER,
+    CBOR_ENCODE_TYPE_TYPED_ARRAY,
+    CBOR_ENCODE_TYPE_TAGGED
 } cbor_type_t;
 
 typedef enum {
@@ -60,6 +62,12 @@ typedef enum {
     CBOR_SIMPLE_ERROR_UNASSIGNED
 } cbor_simple_t;
 
+enum cbor_float_precision {
+    CBOR_FLOAT_PRECISION_HALF,
+    CBOR_FLOAT_PRECISION_SINGLE,
+    CBOR_FLOAT_PRECISION_DOUBLE
+};
+
 typedef enum {
     CBOR_ENCODER_NULL_PTR_ERROR,
     CBOR_ENCODER_ERROR_BUFFER_OVERFLOW,
@@ -73,7 +81,15 @@ typedef enum {
     EMPTY_BUFFER_ERROR,
     MALFORMED_INPUT_ERROR,
     BUFFER_OVERFLOW_ERROR,
-    PARSER_TODO
+    PARSER_TODO,
+    DEPTH_LIMIT_ERROR,
+    CAPACITY_ERROR,
+    INVALID_UTF8_ERROR,
+    LIMIT_EXCEEDED_ERROR,
+    KEY_NOT_FOUND_ERROR,
+    TYPE_MISMATCH_ERROR,
+    OUT_OF_RANGE_ERROR,
+    PROCESSOR_ERROR
 } cbor_parser_error_t;
 
 #define CBOR_LENGTH_INDEFINITE UINT32_MAX
@@ -136,6 +152,15 @@ typedef struct {
     cbor_pair_t* ptr;
 } cbor_pair_slice_t;
 
+/**
+ * A tag and the encoded item it encloses. Parsing walks the enclosed item
+ * once to find its end, its bytes are not copied.
+ */
+typedef struct {
+    uint64_t number;
+    slice_t content;
+} cbor_tag_t;
+
 /*--------------------------------------------------------------------------*/
 /* Encoder Types */
 /*--------------------------------------------------------------------------*/
@@ -150,6 +175,19 @@ typedef struct {
     void* argument;
 } cbor_custom_encoder_t;
 
+/* Native array written as an RFC 8746 typed array, see CBOR_TYPED_ARRAY in typed.h */
+typedef struct {
+    const void* ptr;
+    size_t count;
+    uint8_t tag;
+} cbor_typed_array_value_t;
+
+/* Value written after a tag number, see CBOR_TAGGED */
+typedef struct {
+    uint64_t number;
+    const cbor_value_t* item;
+} cbor_tagged_value_t;
+
 /*--------------------------------------------------------------------------*/
 /* Main CBOR Value Structure */
 /*--------------------------------------------------------------------------*/
@@ -167,11 +205,15 @@ typedef struct cbor_value_s {
         int64_t length;
         cbor_map_t map;
         cbor_array_t array;
-        float floating;
+        float floating;         // f16 and f32
+        double float64;         // f64, see cbor_value_double()
         cbor_simple_t simple;
         cbor_value_slice_t values;
         cbor_pair_slice_t pairs;
         cbor_custom_encoder_t custom_encoder;
+        cbor_typed_array_value_t typed_array;
+        cbor_tag_t tag;
+        cbor_tagged_value_t tagged;
     } value;
     uint8_t *next;
 } cbor_value_t;
@@ -181,6 +223,69 @@ typedef struct cbor_pair_s {
     cbor_value_t second;
 } cbor_pair_t;
 
+/**
+ * Floats keep the width they were encoded with. f16 and f32 are read into
+ * floating, f64 into float64 without being rounded to float. The argument
+ * tells them apart; values built for encoding with only floating set are f32.
+ */
+static inline enum cbor_float_precision cbor_value_float_precision(const cbor_value_t* value) {
+    switch (value->argument.tag) {
+    case ARGUMENT_2BYTE:
+        return CBOR_FLOAT_PRECISION_HALF;
+    case ARGUMENT_8BYTE:
+        return CBOR_FLOAT_PRECISION_DOUBLE;
+    default:
+        return CBOR_FLOAT_PRECISION_SINGLE;
+    }
+}
+
+static inline double cbor_value_double(const cbor_value_t* value) {
+    if (cbor_value_float_precision(value) == CBOR_FLOAT_PRECISION_DOUBLE) {
+        return value->value.float64;
+    }
+    return (double)value->value.floating;
+}
+
+// Rounds f64 values to float
+static inline float cbor_value_float(const cbor_value_t* value) {
+    if (cbor_value_float_precision(value) == CBOR_FLOAT_PRECISION_DOUBLE) {
+        return (float)value->value.float64;
+    }
+    return value->value.floating;
+}
+
+#define CBOR_DOUBLE_VALUE(d) \
+    ((cbor_value_t) {.type = CBOR_TYPE_FLOAT, .argument = {.tag = ARGUMENT_8BYTE, .size = 8}, .value.float64 = (d)})
+
+#define CBOR_HALF_VALUE(f) \
+    ((cbor_value_t) {.type = CBOR_TYPE_FLOAT, .argument = {.tag = ARGUMENT_2BYTE, .size = 2}, .value.floating = (f)})
+
+#define CBOR_ITEM_INDEFINITE 0x01
+
+/**
+ * Compact decoded item for walking large documents. Strings and containers
+ * are not resolved to pointers, their contents start at
+ * offset + header in the document (see cbor_item_data).
+ *
+ * Size: 16 bytes
+ */
+typedef struct {
+    uint8_t type;       // cbor_type_t
+    uint8_t header;     // Bytes taken by the initial byte and the argument
+    uint8_t flags;      // CBOR_ITEM_INDEFINITE
+    uint32_t offset;    // Offset of the initial byte in the document
+    union {
+        int64_t integer;
+        uint64_t length;        // String length or container item count (pairs for maps)
+        uint64_t tag;           // Tag number, the tagged item follows the header
+        float floating;         // f16 and f32
+        double float64;         // f64, header is 9
+        cbor_simple_t simple;
+    } value;
+} cbor_item_t;
+
+_Static_assert(sizeof(cbor_item_t) == 16, "cbor_item_t should be 16 bytes");
+
 /*--------------------------------------------------------------------------*/
 /* Utility Macros */
 /*--------------------------------------------------------------------------*/
@@ -243,6 +348,36 @@ typedef struct cbor_pair_s {
         .value.values = VALUES_INDEFINITE(chunks_array) \
     })
 
+/* Tags item_ptr (a cbor_value_t*) with a tag number */
+#define CBOR_TAGGED(tag_number, item_ptr) \
+    ((cbor_value_t) { \
+        .type = CBOR_ENCODE_TYPE_TAGGED, \
+        .value.tagged = {.number = (tag_number), .item = (item_ptr)} \
+    })
+
+/*--------------------------------------------------------------------------*/
+/* Initial Byte Table */
+/*--------------------------------------------------------------------------*/
+
+/* Flags describing an initial byte, see cbor_initial_byte_t.flags */
+#define CBOR_IB_INDEFINITE 0x01 /* Indefinite length string/array/map header */
+#define CBOR_IB_RESERVED   0x02 /* Reserved or not well-formed additional info */
+#define CBOR_IB_BREAK      0x04 /* The 0xFF "break" stop code */
+
+/**
+ * Everything the decoder needs to know about an initial byte, so that a
+ * header can be classified with a single table load instead of a chain of
+ * comparisons on the additional information bits.
+ */
+typedef struct {
+    uint8_t major;  /* cbor_major_type_t */
+    uint8_t tag;    /* enum argument_t_tag */
+    uint8_t size;   /* Number of argument bytes following the initial byte */
+    uint8_t flags;  /* CBOR_IB_* */
+} cbor_initial_byte_t;
+
+extern const cbor_initial_byte_t cbor_initial_byte_table[256];
+
 /*--------------------------------------------------------------------------*/
 /* Function Declarations */
 /*--------------------------------------------------------------------------*/
@@ -260,142 +395,57 @@ static inline cbor_major_type_t cbor_get_major_type(const uint8_t* data) {
     return (*data) >> 5;
 }
 
-static inline argument_t cbor_get_argument_safe(const slice_t buf, size_t offset) {
-    if (offset >= buf.len || buf.ptr == NULL) {
-        return (argument_t){.tag = ARGUMENT_MALFORMED};
-    }
-    
-    uint8_t argument = (buf.ptr[offset]) & 0x1F;
-
-    if (argument < 24) {
-        return (argument_t){
-            .tag = ARGUMENT_1BYTE,
-            ._1byte = argument,
-            .size = 0
-        };
-    }
-    
-    if (argument == 24) {
-        if (offset + 1 >= buf.len) {
-            return (argument_t){.tag = ARGUMENT_MALFORMED};
-        }
-        return (argument_t){
-            .tag = ARGUMENT_1BYTE,
-            ._1byte = buf.ptr[offset + 1],
-            .size = 1
-        };
-    }
-    
-    if (argument == 25) {
-        if (offset + 2 >= buf.len) {
-            return (argument_t){.tag = ARGUMENT_MALFORMED};
-        }
-        uint16_t temp;
-        memcpy(&temp, buf.ptr + offset + 1, sizeof(temp));
-        return (argument_t){
-            .tag = ARGUMENT_2BYTE,
-            ._2byte = be16toh(temp),
-            .size = 2
-        };
-    }
-    
-    if (argument == 26) {
-        if (offset + 4 >= buf.len) {
-            return (argument_t){.tag = ARGUMENT_MALFORMED};
-        }
-        uint32_t temp;
-        memcpy(&temp, buf.ptr + offset + 1, sizeof(temp));
-        return (argument_t){
-            .tag = ARGUMENT_4BYTE,
-            ._4byte = be32toh(temp),
-            .size = 4
-        };
-    }
-    
-    if (argument == 27) {
-        if (offset + 8 >= buf.len) {
-            return (argument_t){.tag = ARGUMENT_MALFORMED};
-        }
-        uint64_t temp;
-        memcpy(&temp, buf.ptr + offset + 1, sizeof(temp));
-        return (argument_t){
-            .tag = ARGUMENT_8BYTE,
-            ._8byte = be64toh(temp),
-            .size = 8
-        };
-    }
-    
-    if (argument == 31) {
-        return (argument_t){
-            .tag = ARGUMENT_NONE,
-            .size = 0
-        };
-    }
-    
-    return (argument_t){
-        .tag = ARGUMENT_MALFORMED
+static inline argument_t cbor_read_argument(cbor_initial_byte_t ib, const uint8_t* data) {
+    argument_t arg = {
+        .tag = (enum argument_t_tag)ib.tag,
+        .size = ib.size,
     };
-}
 
-static inline argument_t cbor_get_argument(const uint8_t* data) {
-    uint8_t argument = (*data) & 0x1F;
-
-    if (argument < 24) {
-        return (argument_t){
-            .tag = ARGUMENT_1BYTE,
-            ._1byte = argument,
-            .size = 0
-        };
-    }
-    
-    if (argument == 24) {
-        return (argument_t){
-            .tag = ARGUMENT_1BYTE,
-            ._1byte = *(data + 1),
-            .size = 1
-        };
-    }
-    
-    if (argument == 25) {
+    switch (ib.size) {
+    case 0:
+        if (ib.tag == ARGUMENT_1BYTE) {
+            arg._1byte = data[0] & 0x1F;
+        }
+        break;
+    case 1:
+        arg._1byte = data[1];
+        break;
+    case 2: {
         uint16_t temp;
         memcpy(&temp, data + 1, sizeof(temp));
-        return (argument_t){
-            .tag = ARGUMENT_2BYTE,
-            ._2byte = be16toh(temp),
-            .size = 2
-        };
+        arg._2byte = be16toh(temp);
+        break;
     }
-    
-    if (argument == 26) {
+    case 4: {
         uint32_t temp;
         memcpy(&temp, data + 1, sizeof(temp));
-        return (argument_t){
-            .tag = ARGUMENT_4BYTE,
-            ._4byte = be32toh(temp),
-            .size = 4
-        };
+        arg._4byte = be32toh(temp);
+        break;
     }
-    
-    if (argument == 27) {
+    default: {
         uint64_t temp;
         memcpy(&temp, data + 1, sizeof(temp));
-        return (argument_t){
-            .tag = ARGUMENT_8BYTE,
-            ._8byte = be64toh(temp),
-            .size = 8
-        };
+        arg._8byte = be64toh(temp);
+        break;
     }
-    
-    if (argument == 31) {
-        return (argument_t){
-            .tag = ARGUMENT_NONE,
-            .size = 0
-        };
     }
-    
-    return (argument_t){
-        .tag = ARGUMENT_MALFORMED
-    };
+    return arg;
+}
+
+static inline argument_t cbor_get_argument_safe(const slice_t buf, size_t offset) {
+    if (offset >= buf.len || buf.ptr == NULL) {
+        return (argument_t){.tag = ARGUMENT_MALFORMED};
+    }
+
+    const cbor_initial_byte_t ib = cbor_initial_byte_table[buf.ptr[offset]];
+    if (ib.size >= buf.len - offset) {
+        return (argument_t){.tag = ARGUMENT_MALFORMED};
+    }
+    return cbor_read_argument(ib, buf.ptr + offset);
+}
+
+static inline argument_t cbor_get_argument(const uint8_t* data) {
+    return cbor_read_argument(cbor_initial_byte_table[*data], data);
 }
 
 /* Helper function to validate pointer bounds */
@@ -419,34 +469,202 @@ FN_RESULT (
     cbor_parse, slice_t buf
 );
 
-typedef union {
+typedef struct {
     uint8_t is_error;
-    uint8_t ok;
+    uint8_t stop;       // End the walk after this value, see CBOR_CUSTOM_PROCESSOR_STOP
     enum {
         CBOR_CUSTOM_PROCESSOR_SUCESS = 0,
         CBOR_CUSTOM_PROCESSOR_ERROR_PARSER,
     } err;
+    /**
+     * End of the value passed to the processor, if the processor already
+     * walked it (e.g. by calling cbor_process_map on a nested map).
+     * The caller then continues from there instead of walking the value
+     * again. NULL if the processor did not descend, or if its nested walk
+     * came back stopped.
+     */
+    uint8_t* consumed;
 } cbor_custom_processor_result_t;
 
 #define CBOR_CUSTOM_PROCESSOR_OK() \
 (cbor_custom_processor_result_t) {.is_error=0}
 
+#define CBOR_CUSTOM_PROCESSOR_CONSUMED(end) \
+(cbor_custom_processor_result_t) {.is_error=0, .consumed = (end)}
+
 #define CUSTOM_PROCESSOR_ERR(errcode) \
-(cbor_custom_processor_result_t) {.err = errcode}
+(cbor_custom_processor_result_t) {.is_error=1, .err = errcode}
+
+/**
+ * Ends the walk after the current value, e.g. once a lookup found its key.
+ * The process function returns the end of that value instead of the end of
+ * the container, with stopped set, so the rest is never parsed. An error result aborts the
+ * walk and the process function returns PROCESSOR_ERROR.
+ */
+#define CBOR_CUSTOM_PROCESSOR_STOP() \
+(cbor_custom_processor_result_t) {.is_error=0, .stop=1}
 
 /* Processing Functions */
 typedef cbor_custom_processor_result_t (*pair_processor_function)(const cbor_value_t* key, const cbor_value_t* value, void* process_arg);
 typedef cbor_custom_processor_result_t (*single_processor_function)(const cbor_value_t* value, void* process_arg);
 
 /* Result types for processing functions */
-typedef uint8_t* uint8_ptr_t;
-DEFINE_RESULT_TYPE(uint8_ptr_t, cbor_parser_error_t);
-typedef result_uint8_ptr_t_cbor_parser_error_t_t cbor_process_result_t;
+typedef struct {
+    uint8_t is_error;
+    /**
+     * A processor returned CBOR_CUSTOM_PROCESSOR_STOP, ok is the end of the
+     * value it stopped at and not the end of the container. A processor
+     * walking a nested container must not hand such an end to the outer
+     * walk as consumed.
+     */
+    uint8_t stopped;
+    union {
+        uint8_t* ok;
+        cbor_parser_error_t err;
+    };
+} cbor_process_result_t;
+
+/**
+ * Looks up a key by its encoded bytes (header and payload, see CBOR_TEXT_KEY)
+ * and returns the encoded value, stopping at the first match.
+ * Keys are compared with memcmp, so they have to be encoded the same way,
+ * e.g. in the shortest form. Returns KEY_NOT_FOUND_ERROR if the key is missing.
+ */
+DEFINE_RESULT_TYPE(slice_t, cbor_parser_error_t);
+FN_RESULT(slice_t, cbor_parser_error_t,
+cbor_map_find, cbor_map_t map, slice_t key);
+
+/* Returns the encoded element at index, KEY_NOT_FOUND_ERROR if the array is shorter */
+FN_RESULT(slice_t, cbor_parser_error_t,
+cbor_array_get, cbor_array_t array, size_t index);
+
+/**
+ * Looks up several keys in one pass and stops once all of them are found.
+ * values[i] is set to the encoded value of keys[i], or {0, NULL} if missing.
+ * Returns the number of keys found.
+ */
+DEFINE_RESULT_TYPE(size_t, cbor_parser_error_t);
+FN_RESULT(size_t, cbor_parser_error_t,
+cbor_map_find_many, cbor_map_t map, const slice_t* keys, slice_t* values, size_t count);
+
+/**
+ * Encoded text string key for cbor_map_find, for string literals up to 23 bytes.
+ * Longer literals do not compile, they would need a length byte after the header.
+ * The storage lives until the end of the enclosing block.
+ */
+#define CBOR_TEXT_KEY(str) \
+    ((slice_t) { \
+        .len = sizeof(str) + 0 * sizeof(char[sizeof(str) <= 24 ? 1 : -1]), \
+        .ptr = (uint8_t*)&(struct { uint8_t header; char text[sizeof(str)]; }) { \
+            .header = (CBOR_MAJOR_TYPE_TEXT_STRING << 5) | (sizeof(str) - 1), \
+            .text = str, \
+        }, \
+    })
+
+/* Compact item parsing and processing */
+DEFINE_RESULT_TYPE(cbor_item_t, cbor_parser_error_t);
+FN_RESULT(cbor_item_t, cbor_parser_error_t,
+cbor_parse_item, slice_t doc, size_t offset);
+
+typedef cbor_custom_processor_result_t (*pair_item_processor_function)(slice_t doc, const cbor_item_t* key, const cbor_item_t* value, void* process_arg);
+typedef cbor_custom_processor_result_t (*single_item_processor_function)(slice_t doc, const cbor_item_t* item, void* process_arg);
+
+cbor_process_result_t cbor_process_array_items(slice_t doc, const cbor_item_t* array, single_item_processor_function process_single, void* process_arg);
+cbor_process_result_t cbor_process_map_items(slice_t doc, const cbor_item_t* map, pair_item_processor_function process_pair, void* process_arg);
+
+static inline uint8_t* cbor_item_data(slice_t doc, const cbor_item_t* item) {
+    return doc.ptr + item->offset + item->header;
+}
+
+/* Contents of a definite length string item */
+static inline slice_t cbor_item_bytes(slice_t doc, const cbor_item_t* item) {
+    return (slice_t) {
+        .len = (size_t)item->value.length,
+        .ptr = cbor_item_data(doc, item),
+    };
+}
+
+static inline double cbor_item_double(const cbor_item_t* item) {
+    return item->header == 9 ? item->value.float64 : (double)item->value.floating;
+}
+
+/**
+ * Returns a pointer to the byte after the end of the item at the start of
+ * buf, including nested containers and indefinite length strings.
+ * The walk is iterative and never invokes processors. Definite length
+ * arrays, maps and tags only add to a count of items left, so they may nest
+ * to any depth; indefinite length containers nested deeper than
+ * CBOR_MAX_DEPTH are rejected with DEPTH_LIMIT_ERROR. The process functions
+ * skip elements with it and share these limits.
+ */
+cbor_process_result_t cbor_skip(slice_t buf);
+
+/* cbor_skip with a fast path for items whose size is in the header */
+static inline cbor_process_result_t cbor_skip_item(slice_t buf) {
+    if (buf.len > 0) {
+        const cbor_initial_byte_t ib = cbor_initial_byte_table[*buf.ptr];
+        if (!(ib.flags & (CBOR_IB_RESERVED | CBOR_IB_INDEFINITE | CBOR_IB_BREAK)) && ib.size < buf.len) {
+            switch (ib.major) {
+            case CBOR_MAJOR_TYPE_UNSIGNED_INTEGER:
+            case CBOR_MAJOR_TYPE_NEGATIVE_INTEGER:
+            case CBOR_MAJOR_TYPE_SIMPLE:
+                return OK(cbor_process_result_t, buf.ptr + 1 + ib.size);
+            case CBOR_MAJOR_TYPE_BYTE_STRING:
+            case CBOR_MAJOR_TYPE_TEXT_STRING: {
+                uint64_t len = cbor_argument_to_fixed(cbor_read_argument(ib, buf.ptr));
+                if (len > buf.len - 1 - ib.size) {
+                    return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                }
+                return OK(cbor_process_result_t, buf.ptr + 1 + ib.size + len);
+            }
+            default:
+                break;
+            }
+        }
+    }
+    return cbor_skip(buf);
+}
+
+/**
+ * Limits for cbor_validate, 0 means no limit.
+ * max_depth is capped at CBOR_MAX_DEPTH.
+ */
+typedef struct {
+    size_t max_depth;           // Nested arrays, maps and indefinite strings
+    size_t max_items;           // Item headers in total, including keys, tags and string chunks
+    uint64_t max_string_length; // Bytes per string, indefinite strings count all chunks
+} cbor_limits_t;
+
+/**
+ * Checks that the item at the start of buf is well-formed and within limits
+ * (which may be NULL) and returns its length in bytes. Same walk as cbor_skip,
+ * no values are built and no processors are called.
+ * Exceeding max_depth gives DEPTH_LIMIT_ERROR, the other limits LIMIT_EXCEEDED_ERROR.
+ */
+FN_RESULT(size_t, cbor_parser_error_t,
+cbor_validate, slice_t buf, const cbor_limits_t* limits);
 
 cbor_process_result_t cbor_process_array(cbor_array_t array, single_processor_function process_single, void* process_arg);
 cbor_process_result_t cbor_process_map(cbor_map_t map, pair_processor_function process_pair, void* process_arg);
 cbor_process_result_t cbor_process_indefinite_string(cbor_array_t string_chunks, cbor_type_t expected_type, single_processor_function process_single, void* process_arg);
 
+#ifdef CBOR_ERROR_CONTEXT
+/**
+ * Where the last cbor_process_* call on this thread failed. Walks started
+ * by processors count as part of the outer call, the innermost failure is
+ * kept unless the processor recovered from it. Recorded without any I/O, so rejections can be logged later.
+ */
+typedef struct {
+    size_t offset;              // From the contents of the outermost container, or from doc for the item walkers
+    cbor_parser_error_t error;
+    uint8_t depth;              // 0 for the outermost container
+    uint8_t major_type;         // Of the failing item, of the container if the input ended
+    uint8_t set;                // 0 if the last call succeeded
+} cbor_error_context_t;
+
+const cbor_error_context_t* cbor_last_error(void);
+#endif
+
 /* Encoding Functions */
 FN_RESULT(slice_t, cbor_encode_error_t,
 cbor_encode, cbor_value_t value, slice_t target);
@@ -457,6 +675,15 @@ cbor_encode_result_t cbor_encode_value_map_indefinite(cbor_pair_slice_t pairs, s
 
 cbor_encode_result_t cbor_encode_pair (cbor_value_t first, cbor_value_t second, slice_t target);
 
+/* Scalar Encoding Functions, the result is the written part of target */
+cbor_encode_result_t cbor_encode_integer(int64_t integer, slice_t target);
+cbor_encode_result_t cbor_encode_string(slice_t string, cbor_type_t type, slice_t target);
+cbor_encode_result_t cbor_encode_simple(cbor_simple_t simple, slice_t target);
+cbor_encode_result_t cbor_encode_float(float value, enum cbor_float_precision precision, slice_t target);
+cbor_encode_result_t cbor_encode_double(double value, slice_t target);
+// Writes only the tag header, the tagged item has to follow
+cbor_encode_result_t cbor_encode_tag(uint64_t number, slice_t target);
+
 // raw function that writes only the major type and the argument!!!
 uint8_t cbor_write_len_header(size_t len, cbor_major_type_t major_type, slice_t target);
 
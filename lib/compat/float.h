@@ -5,116 +5,125 @@
 
 // Compiler intrinsics
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <math.h>
 
-// f16 to f32 conversion
-static inline float __extendhfsf2(uint16_t h) {
-    // Extract sign, exponent, and mantissa from half-precision
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+// f16 to f32 conversion without branches or loops. Subnormals are
+// normalized with a single count-leading-zeros (CLZ on Cortex-M3), NaNs
+// come out quiet with their payload kept, matching F16C.
+static inline float half_to_float_soft(uint16_t h) {
     uint32_t sign = ((uint32_t)h & 0x8000) << 16;
-    int32_t exp = (h & 0x7C00) >> 10;
+    uint32_t exp = h & 0x7C00;
     uint32_t mant = h & 0x03FF;
-    
-    if (exp == 0) {
-        // Zero or subnormal
-        if (mant == 0) {
-            return *(float*)&sign; // ±0.0
-        }
-        // Subnormal - normalize
-        while (!(mant & 0x0400)) {
-            mant <<= 1;
-            exp--;
-        }
-        exp++;
-        mant &= 0x03FF;
-    } else if (exp == 0x1F) {
-        // NaN or Infinity
-        if (mant == 0) {
-            // Infinity
-            uint32_t inf = sign | 0x7F800000;
-            return *(float*)&inf;
-        } else {
-            // NaN - preserve payload in quiet NaN
-            uint32_t nan = sign | 0x7FC00000 | (mant << 13);
-            return *(float*)&nan;
-        }
-    }
-    
-    // Convert to single precision: bias 127 vs 15
-    uint32_t result = sign | ((exp + (127 - 15)) << 23) | (mant << 13);
-    return *(float*)&result;
+
+    // All-ones masks selecting the encoding class
+    uint32_t is_zero_exp = -(uint32_t)(exp == 0);
+    uint32_t is_max_exp = -(uint32_t)(exp == 0x7C00);
+    uint32_t is_subnormal = is_zero_exp & -(uint32_t)(mant != 0);
+
+    // Normal, infinity and NaN: rebias 15 -> 127, Inf/NaN get exponent 0xFF
+    uint32_t normal = ((exp | mant) << 13) + ((uint32_t)(127 - 15) << 23);
+    normal += is_max_exp & ((uint32_t)(128 - 16) << 23);
+    normal |= is_max_exp & -(uint32_t)(mant != 0) & 0x00400000;
+
+    // Subnormal: value is mant * 2^-24, lead bit p = 31 - clz(mant)
+    uint32_t lead = 31 - (uint32_t)__builtin_clz(mant | 1);
+    uint32_t subnormal = ((lead + 127 - 24) << 23) | ((mant << (23 - lead)) & 0x007FFFFF);
+
+    uint32_t bits = sign | (~is_zero_exp & normal) | (is_subnormal & subnormal);
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
 }
 
-// f32 to f16 conversion
-static inline uint16_t __truncsfhf2(float f) {
-    uint32_t x = *(uint32_t*)&f;
-    
-    // Extract components from single-precision
-    uint32_t sign = (x & 0x80000000) >> 16;
-    int32_t exp = (x & 0x7F800000) >> 23;
-    uint32_t mant = x & 0x007FFFFF;
-    
-    // Handle special cases
-    if (exp == 0xFF) {
-        // NaN or Infinity
-        if (mant == 0) {
-            return sign | 0x7C00; // Infinity
-        } else {
-            // NaN - convert to half-precision NaN (preserve some payload)
-            return sign | 0x7E00 | (mant >> 13);
-        }
-    }
-    
-    // Adjust exponent from single to half precision (bias 127 vs 15)
-    exp = exp - 127 + 15;
-    
-    if (exp <= 0) {
-        // Underflow - becomes zero or subnormal
-        if (exp < -10) {
-            return sign; // Underflow to zero
-        }
-        // Subnormal
-        mant = (mant | 0x00800000) >> (1 - exp);
-        if (mant & 0x00001000) {
-            mant += 0x00002000; // Round
-        }
-        return sign | (mant >> 13);
+// f32 to f16 conversion, rounding to nearest with ties to even like the
+// _Float16 cast and F16C, so every target encodes the same bytes
+static inline uint16_t float_to_half_soft(float f) {
+    uint32_t x;
+    memcpy(&x, &f, sizeof(x));
+    const uint16_t sign = (uint16_t)((x >> 16) & 0x8000);
+    const uint32_t abs = x & 0x7FFFFFFF;
+
+    if (abs > 0x7F800000) {
+        // NaN comes out quiet with the top of its payload
+        return sign | 0x7E00 | (uint16_t)((abs >> 13) & 0x03FF);
     }
-    
-    if (exp >= 0x1F) {
-        // Overflow - becomes infinity
+    if (abs >= 0x477FF000) {
+        // 65520 and above, including infinity
         return sign | 0x7C00;
     }
-    
-    // Normal number
-    if (mant & 0x00001000) {
-        mant += 0x00002000; // Round
-        if (mant & 0x00800000) {
-            mant = 0;        // Overflow in rounding
-            exp++;
-            if (exp >= 0x1F) {
-                return sign | 0x7C00; // Overflow to infinity
-            }
-        }
+
+    uint32_t h, rem, halfway;
+    if (abs >= 0x38800000) {
+        // Normal: rebias 127 -> 15 and drop 13 mantissa bits, a carry moves into the exponent
+        h = (abs - ((uint32_t)(127 - 15) << 23)) >> 13;
+        rem = abs & 0x1FFF;
+        halfway = 0x1000;
     }
-    
-    return sign | (exp << 10) | (mant >> 13);
+    else if (abs >= 0x33000000) {
+        // Subnormal: units of 2^-24, exponent 102 to 112 shifts by 24 to 14
+        const uint32_t shift = 126 - (abs >> 23);
+        const uint32_t mant = (abs & 0x007FFFFF) | 0x00800000;
+        h = mant >> shift;
+        rem = mant & ((1u << shift) - 1);
+        halfway = 1u << (shift - 1);
+    }
+    else {
+        // At most half of the smallest subnormal
+        return sign;
+    }
+    h += rem > halfway || (rem == halfway && (h & 1));
+    return sign | (uint16_t)h;
 }
 
 // Helper functions for better usability
 static inline float half_to_float(uint16_t half_val) {
-#if !__HAVE_FLOAT16 || defined(__STRICT_ANSI__) || (defined(__GNUC__) && defined(__PEDANTIC__))
-    // Use software implementation when Float16 is not available or in pedantic mode
-    return __extendhfsf2(half_val);
+#if defined(__F16C__)
+    return _cvtsh_ss(half_val);
 #else
-    return (float)*(_Float16*)&half_val;
+    return half_to_float_soft(half_val);
+#endif
+}
+
+// Bulk f16 to f32 conversion of host-order values
+static inline void half_to_float_n(float* out, const uint16_t* in, size_t count) {
+    size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+    for (; i + 8 <= count; i += 8) {
+        __m128i h = _mm_loadu_si128((const __m128i*)(const void*)(in + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = half_to_float(in[i]);
+    }
+}
+
+// Bulk f16 to f32 conversion of big-endian bytes, as found in CBOR payloads
+static inline void half_be_to_float_n(float* out, const uint8_t* in, size_t count) {
+    size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+    const __m128i swap = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for (; i + 8 <= count; i += 8) {
+        __m128i h = _mm_loadu_si128((const __m128i*)(const void*)(in + 2 * i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_shuffle_epi8(h, swap)));
+    }
 #endif
+    for (; i < count; i++) {
+        out[i] = half_to_float((uint16_t)(((uint16_t)in[2 * i] << 8) | in[2 * i + 1]));
+    }
 }
 
 static inline uint16_t float_to_half(float float_val) {
 #if !__HAVE_FLOAT16 || defined(__STRICT_ANSI__) || (defined(__GNUC__) && defined(__PEDANTIC__))
     // Use software implementation when Float16 is not available or in pedantic mode
-    return __truncsfhf2(float_val);
+    return float_to_half_soft(float_val);
 #else
     _Float16 hf = (_Float16)float_val;
     return *(uint16_t*)&hf;
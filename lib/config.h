@@ -3,4 +3,18 @@
 
 #define CBOR_DEBUG_REPR
 
+// Maximum container nesting handled by the non-recursive walkers
+#ifndef CBOR_MAX_DEPTH
+#define CBOR_MAX_DEPTH 16
+#endif
+
+// Record where cbor_process_* calls fail, read back with cbor_last_error().
+// Build with -DCBOR_NO_ERROR_CONTEXT to keep the bookkeeping out of the process loops.
+#if !defined(CBOR_ERROR_CONTEXT) && !defined(CBOR_NO_ERROR_CONTEXT)
+#define CBOR_ERROR_CONTEXT
+#endif
+
+// Reject text strings that are not valid UTF-8 with INVALID_UTF8_ERROR
+// #define CBOR_STRICT_UTF8
+
 #endif /*CBOR_CONFIG_H*/
@@ -13,10 +13,18 @@ cbor_custom_processor_result_t print_single(const cbor_value_t* value, void* arg
     #ifdef CBOR_DEBUG_REPR
     print_cbor_value(*value, (size_t)arg);
     if (value->type == CBOR_TYPE_MAP) {
-        cbor_process_map(value->value.map, print_pair, (void*)((size_t)arg + (size_t)4));
+        cbor_process_result_t result = cbor_process_map(value->value.map, print_pair, (void*)((size_t)arg + (size_t)4));
+        return CBOR_CUSTOM_PROCESSOR_CONSUMED(result.is_error ? NULL : result.ok);
     }        
     if (value->type == CBOR_TYPE_ARRAY) {
-        cbor_process_array(value->value.array, print_single, (void*)((size_t)arg + (size_t)4));
+        cbor_process_result_t result = cbor_process_array(value->value.array, print_single, (void*)((size_t)arg + (size_t)4));
+        return CBOR_CUSTOM_PROCESSOR_CONSUMED(result.is_error ? NULL : result.ok);
+    }
+    if (value->type == CBOR_TYPE_TAG) {
+        cbor_parse_result_t item = cbor_parse(value->value.tag.content);
+        if (!item.is_error) {
+            print_single(&item.ok, (void*)((size_t)arg + (size_t)4));
+        }
     }
     #endif
     return CBOR_CUSTOM_PROCESSOR_OK();
@@ -27,10 +35,18 @@ cbor_custom_processor_result_t print_pair(const cbor_value_t* key, const cbor_va
     print_cbor_value(*key, (size_t)arg);
     print_cbor_value(*value, (size_t)arg);
     if (value->type == CBOR_TYPE_MAP) {
-        cbor_process_map(value->value.map, print_pair, (void*)((size_t)arg + (size_t)4));
+        cbor_process_result_t result = cbor_process_map(value->value.map, print_pair, (void*)((size_t)arg + (size_t)4));
+        return CBOR_CUSTOM_PROCESSOR_CONSUMED(result.is_error ? NULL : result.ok);
     }
     if (value->type == CBOR_TYPE_ARRAY) {
-        cbor_process_array(value->value.array, print_single, (void*)((size_t)arg + (size_t)4));
+        cbor_process_result_t result = cbor_process_array(value->value.array, print_single, (void*)((size_t)arg + (size_t)4));
+        return CBOR_CUSTOM_PROCESSOR_CONSUMED(result.is_error ? NULL : result.ok);
+    }
+    if (value->type == CBOR_TYPE_TAG) {
+        cbor_parse_result_t item = cbor_parse(value->value.tag.content);
+        if (!item.is_error) {
+            print_single(&item.ok, (void*)((size_t)arg + (size_t)4));
+        }
     }
     #endif
     return CBOR_CUSTOM_PROCESSOR_OK();
@@ -56,6 +72,9 @@ void print_cbor_type(cbor_major_type_t type) {
     case CBOR_TYPE_MAP:
         printf("CBOR Type: Map");
         break;
+    case CBOR_TYPE_TAG:
+        printf("CBOR Type: Tag");
+        break;
     default:
         printf("CBOR Type: Unknown (%d)", (int)type);
         break;
@@ -107,8 +126,10 @@ void print_cbor_value(cbor_value_t value, int indent)
         }
         break;
     case CBOR_TYPE_FLOAT:
-        
-        printf("Float: %f\n", (double)value.value.floating);
+        printf("Float: %f\n", cbor_value_double(&value));
+        break;
+    case CBOR_TYPE_TAG:
+        printf("Tag: %llu\n", (unsigned long long)value.value.tag.number);
         break;
     default:
         /* Other CBOR types are not printed yet */
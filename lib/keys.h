@@ -0,0 +1,197 @@
+#ifndef CBOR_KEYS_H
+#define CBOR_KEYS_H
+
+#include "cbor.h"
+
+/*--------------------------------------------------------------------------*/
+/* Key Dispatch */
+/*--------------------------------------------------------------------------*/
+
+/**
+ * Maps string keys to ids without copying or strcmp. The generated function
+ * switches on the key length and, within each length, compares the first
+ * 8 bytes of the key as one word against the names of that length, packed
+ * into constants at compile time. Names longer than 8 bytes compare their
+ * remaining bytes with memcmp once the word matches. Nothing is built at run
+ * time, the function is code only.
+ *
+ * Lengths up to CBOR_KEY_CASE_MAX get a case each, longer keys share the
+ * default case. The key list is expanded once per case, and the length
+ * check each entry makes against the case is a constant, so the compiler
+ * keeps only the entries of that length.
+ *
+ * A lookup function is generated from an X-macro list. Define X to map an
+ * entry to CBOR_KEY_ID(name, id), then expand CBOR_KEY_LOOKUP_FUNCTION:
+ *
+ *   #define X(name, key) CBOR_KEY_ID(name, IDENTIFY_SHIFT_ ## key)
+ *   CBOR_KEY_LOOKUP_FUNCTION(identify_parameter_id, IDENTIFY_PARAMETERS)
+ *   #undef X
+ *
+ * The generated function takes the string contents and returns the id, or -1.
+ */
+
+// Lengths with a case of their own in CBOR_KEY_LOOKUP_FUNCTION
+#define CBOR_KEY_CASE_MAX 16
+
+// First 8 bytes of a key, first byte in the lowest bits
+static inline uint64_t cbor_key_word(const uint8_t* key, size_t len) {
+    uint64_t word = 0;
+    for (size_t i = 0; i < len && i < 8; i++) {
+        word |= (uint64_t)key[i] << (8 * i);
+    }
+    return word;
+}
+
+// The same for a string literal, a constant after folding
+#define CBOR_KEY_BYTE(s, i) \
+    ((uint64_t)(sizeof(s) - 1 > (i) ? (uint8_t)(s)[(i) < sizeof(s) ? (i) : 0] : 0) << (8 * (i)))
+#define CBOR_KEY_PACK(s) \
+    (CBOR_KEY_BYTE(s, 0) | CBOR_KEY_BYTE(s, 1) | CBOR_KEY_BYTE(s, 2) | CBOR_KEY_BYTE(s, 3) | \
+     CBOR_KEY_BYTE(s, 4) | CBOR_KEY_BYTE(s, 5) | CBOR_KEY_BYTE(s, 6) | CBOR_KEY_BYTE(s, 7))
+
+// Bytes after the first 8 of a key as long as name
+static inline int cbor_key_tail_matches(slice_t key, const char* name, size_t len) {
+    return len <= 8 || memcmp(key.ptr + 8, name + 8, len - 8) == 0;
+}
+
+// An entry of the key list, expanded inside each case of the generated switch
+#define CBOR_KEY_ID(name, id) \
+    if ((cbor_key_len != 0 ? sizeof(#name) - 1 == cbor_key_len : sizeof(#name) - 1 > CBOR_KEY_CASE_MAX) && \
+        sizeof(#name) - 1 == key.len && word == CBOR_KEY_PACK(#name) && cbor_key_tail_matches(key, #name, sizeof(#name) - 1)) { \
+        return (id); \
+    }
+
+// Entries of length n, 0 for those longer than CBOR_KEY_CASE_MAX
+#define CBOR_KEY_CASE(n, LIST) { \
+        enum { cbor_key_len = n }; \
+        const uint64_t word = cbor_key_word(key.ptr, key.len); \
+        LIST \
+    } \
+    break;
+
+#define CBOR_KEY_LOOKUP_FUNCTION(fn, LIST) \
+    static inline int fn(slice_t key) { \
+        switch (key.len) { \
+        case 1: CBOR_KEY_CASE(1, LIST) \
+        case 2: CBOR_KEY_CASE(2, LIST) \
+        case 3: CBOR_KEY_CASE(3, LIST) \
+        case 4: CBOR_KEY_CASE(4, LIST) \
+        case 5: CBOR_KEY_CASE(5, LIST) \
+        case 6: CBOR_KEY_CASE(6, LIST) \
+        case 7: CBOR_KEY_CASE(7, LIST) \
+        case 8: CBOR_KEY_CASE(8, LIST) \
+        case 9: CBOR_KEY_CASE(9, LIST) \
+        case 10: CBOR_KEY_CASE(10, LIST) \
+        case 11: CBOR_KEY_CASE(11, LIST) \
+        case 12: CBOR_KEY_CASE(12, LIST) \
+        case 13: CBOR_KEY_CASE(13, LIST) \
+        case 14: CBOR_KEY_CASE(14, LIST) \
+        case 15: CBOR_KEY_CASE(15, LIST) \
+        case 16: CBOR_KEY_CASE(16, LIST) \
+        default: CBOR_KEY_CASE(0, LIST) \
+        } \
+        return -1; \
+    }
+
+typedef int (*cbor_key_lookup_function)(slice_t key);
+
+/**
+ * The reverse of CBOR_KEY_LOOKUP_FUNCTION, generated from the same list with
+ * X mapping an entry to CBOR_KEY_NAME(name, id). The generated function
+ * returns the name of an id, an empty slice for unknown ids.
+ */
+#define CBOR_KEY_NAME(name, id) \
+    case (id): \
+        return (slice_t) {.len = sizeof(#name) - 1, .ptr = (uint8_t*)#name};
+
+#define CBOR_KEY_NAME_FUNCTION(fn, LIST) \
+    static inline slice_t fn(int id) { \
+        switch (id) { \
+        LIST \
+        default: \
+            return (slice_t) {0}; \
+        } \
+    }
+
+typedef slice_t (*cbor_key_name_function)(int id);
+
+/**
+ * Decodes an array of text strings into a bitmap, setting bit lookup(string)
+ * for every known string. Unknown strings and other items are skipped.
+ * Inline, so a static lookup function is inlined into the loop.
+ */
+static inline cbor_process_result_t cbor_decode_key_bitmap(cbor_array_t array, cbor_key_lookup_function lookup, uint64_t* bitmap) {
+    if (array.inside == NULL || bitmap == NULL) {
+        return ERR(cbor_process_result_t, NULL_PTR_ERROR);
+    }
+
+    uint8_t* current = array.inside;
+    uint8_t* const end = array.inside + array.max_size;
+    for (uint32_t i = 0; array.length == CBOR_LENGTH_INDEFINITE || i < array.length; i++) {
+        if (current >= end) {
+            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+        if (array.length == CBOR_LENGTH_INDEFINITE && (cbor_initial_byte_table[*current].flags & CBOR_IB_BREAK)) {
+            return OK(cbor_process_result_t, current + 1);
+        }
+
+        slice_t rest = {.len = (size_t)(end - current), .ptr = current};
+        cbor_parse_result_t element = cbor_parse(rest);
+        if (!element.is_error && element.ok.type == CBOR_TYPE_TEXT_STRING && element.ok.next != NULL) {
+            int id = lookup(element.ok.value.bytes);
+            if (id >= 0 && id < 64) {
+                *bitmap |= (uint64_t)1 << id;
+            }
+            current = element.ok.next;
+            continue;
+        }
+
+        cbor_process_result_t skipped = cbor_skip(rest);
+        if (skipped.is_error) {
+            return skipped;
+        }
+        current = skipped.ok;
+    }
+    return OK(cbor_process_result_t, current);
+}
+
+/**
+ * Encodes a bitmap as an array of the names of its set bits, lowest bit
+ * first, the reverse of cbor_decode_key_bitmap. A set bit without a name
+ * gives CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT.
+ */
+static inline cbor_encode_result_t cbor_encode_key_bitmap(uint64_t bitmap, cbor_key_name_function name, slice_t target) {
+    if (name == NULL || target.ptr == NULL) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_NULL_PTR_ERROR);
+    }
+
+    size_t count = 0;
+    for (uint64_t bits = bitmap; bits != 0; bits &= bits - 1) {
+        count++;
+    }
+    // At most 64 names, so the header takes one or two bytes
+    if (target.len < (count <= 23 ? 1u : 2u)) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_BUFFER_OVERFLOW);
+    }
+    uint8_t header_size = cbor_write_len_header(count, CBOR_MAJOR_TYPE_ARRAY, target);
+    slice_t current = {.len = target.len - header_size, .ptr = target.ptr + header_size};
+
+    for (int id = 0; id < 64; id++) {
+        if (!(bitmap & ((uint64_t)1 << id))) {
+            continue;
+        }
+        slice_t key = name(id);
+        if (key.len == 0) {
+            return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT);
+        }
+        cbor_encode_result_t encoded = cbor_encode_string(key, CBOR_TYPE_TEXT_STRING, current);
+        if (encoded.is_error) {
+            return encoded;
+        }
+        current.ptr += encoded.ok.len;
+        current.len -= encoded.ok.len;
+    }
+    return OK(cbor_encode_result_t, ((slice_t) {.len = (size_t)(current.ptr - target.ptr), .ptr = target.ptr}));
+}
+
+#endif /* CBOR_KEYS_H */
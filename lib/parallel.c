@@ -0,0 +1,190 @@
+#include "parallel.h"
+
+#ifndef TARGET_EMBEDDED
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+typedef struct {
+    pthread_mutex_t scan_lock;
+    pthread_mutex_t lock;
+    pthread_cond_t turn_changed;
+    seq_item_processor_function process;
+    void* process_arg;
+    uint8_t flags;
+
+    // Guarded by scan_lock, so finding boundaries does not wait on turn changes
+    uint8_t* scan;              // Start of the next unclaimed chunk
+    uint8_t* end;
+    size_t next_index;          // Index of the first item of the next chunk
+    size_t next_chunk;
+
+    // Guarded by lock, taken after scan_lock when both are needed
+    size_t turn;                // Chunk allowed to call process when ordered
+    int failed;
+    cbor_parser_error_t err;
+    size_t err_index;           // Item the error is about
+    size_t stopped_at;          // Items up to the first that asked to stop, 0 if none did
+
+    atomic_int stop;            // Set on processor errors and stops, read without the lock
+} cbor_parallel_state_t;
+
+typedef struct {
+    uint8_t* start;
+    uint8_t* ends[CBOR_PARALLEL_CHUNK_ITEMS];   // End of each item, found while claiming
+    size_t index;               // Sequence index of the first item
+    size_t count;
+    size_t id;
+} cbor_parallel_chunk_t;
+
+// Keeps the error about the earliest item, whichever thread found it first. Called with the lock held.
+static void cbor_parallel_fail(cbor_parallel_state_t* state, cbor_parser_error_t err, size_t index) {
+    if (!state->failed || index < state->err_index) {
+        state->failed = 1;
+        state->err = err;
+        state->err_index = index;
+    }
+}
+
+// Finds the items of the next chunk, called with scan_lock held. Returns 0 when there are none left.
+static int cbor_parallel_claim(cbor_parallel_state_t* state, cbor_parallel_chunk_t* chunk) {
+    if (atomic_load_explicit(&state->stop, memory_order_relaxed)) {
+        return 0;
+    }
+
+    uint8_t* current = state->scan;
+    size_t count = 0;
+    while (current < state->end && count < CBOR_PARALLEL_CHUNK_ITEMS
+        && (count == 0 || (size_t)(current - state->scan) < CBOR_PARALLEL_CHUNK_BYTES)) {
+        cbor_process_result_t item_end = cbor_skip_item((slice_t) {.len = (size_t)(state->end - current), .ptr = current});
+        if (item_end.is_error) {
+            // Items before the damage are still handed out, nothing after it
+            pthread_mutex_lock(&state->lock);
+            cbor_parallel_fail(state, item_end.err, state->next_index + count);
+            pthread_mutex_unlock(&state->lock);
+            state->end = current;
+            break;
+        }
+        current = item_end.ok;
+        chunk->ends[count++] = current;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    chunk->start = state->scan;
+    chunk->index = state->next_index;
+    chunk->count = count;
+    chunk->id = state->next_chunk++;
+    state->scan = current;
+    state->next_index += count;
+    return 1;
+}
+
+static void* cbor_parallel_worker(void* arg) {
+    cbor_parallel_state_t* state = arg;
+    const int ordered = state->flags & CBOR_PARALLEL_ORDERED;
+
+    for (;;) {
+        cbor_parallel_chunk_t chunk;
+        pthread_mutex_lock(&state->scan_lock);
+        int claimed = cbor_parallel_claim(state, &chunk);
+        pthread_mutex_unlock(&state->scan_lock);
+        if (!claimed) {
+            break;
+        }
+        if (ordered) {
+            pthread_mutex_lock(&state->lock);
+            while (state->turn != chunk.id && !atomic_load_explicit(&state->stop, memory_order_relaxed)) {
+                pthread_cond_wait(&state->turn_changed, &state->lock);
+            }
+            pthread_mutex_unlock(&state->lock);
+        }
+
+        uint8_t* current = chunk.start;
+        for (size_t i = 0; i < chunk.count && !atomic_load_explicit(&state->stop, memory_order_relaxed); i++) {
+            uint8_t* item_end = chunk.ends[i];
+            slice_t item = {.len = (size_t)(item_end - current), .ptr = current};
+
+            cbor_custom_processor_result_t result = state->process(item, chunk.index + i, state->process_arg);
+            if (result.is_error || result.stop) {
+                const size_t index = chunk.index + i;
+                pthread_mutex_lock(&state->lock);
+                if (result.is_error) {
+                    cbor_parallel_fail(state, PROCESSOR_ERROR, index);
+                }
+                else if (state->stopped_at == 0 || index + 1 < state->stopped_at) {
+                    state->stopped_at = index + 1;
+                }
+                atomic_store_explicit(&state->stop, 1, memory_order_relaxed);
+                pthread_cond_broadcast(&state->turn_changed);
+                pthread_mutex_unlock(&state->lock);
+                break;
+            }
+            current = item_end;
+        }
+
+        if (ordered) {
+            pthread_mutex_lock(&state->lock);
+            state->turn++;
+            pthread_cond_broadcast(&state->turn_changed);
+            pthread_mutex_unlock(&state->lock);
+        }
+    }
+    return NULL;
+}
+/*--------------------------------------------------------------------------*/
+cbor_process_sequence_parallel_result_t cbor_process_sequence_parallel(slice_t buf, size_t threads, uint8_t flags,
+    seq_item_processor_function process, void* process_arg) {
+    if (buf.ptr == NULL || process == NULL) {
+        return ERR(cbor_process_sequence_parallel_result_t, NULL_PTR_ERROR);
+    }
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (size_t)online : 1;
+    }
+
+    cbor_parallel_state_t state = {
+        .process = process,
+        .process_arg = process_arg,
+        .flags = flags,
+        .scan = buf.ptr,
+        .end = buf.ptr + buf.len,
+    };
+    atomic_init(&state.stop, 0);
+    pthread_mutex_init(&state.scan_lock, NULL);
+    pthread_mutex_init(&state.lock, NULL);
+    pthread_cond_init(&state.turn_changed, NULL);
+
+    // Fewer threads than asked for if they cannot be created, the calling thread always works
+    pthread_t* workers = threads > 1 ? malloc((threads - 1) * sizeof(*workers)) : NULL;
+    size_t started = 0;
+    if (workers != NULL) {
+        while (started < threads - 1 && pthread_create(&workers[started], NULL, cbor_parallel_worker, &state) == 0) {
+            started++;
+        }
+    }
+    cbor_parallel_worker(&state);
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+
+    pthread_cond_destroy(&state.turn_changed);
+    pthread_mutex_destroy(&state.lock);
+    pthread_mutex_destroy(&state.scan_lock);
+
+    // Errors past the item that stopped are not reported, as in a sequential walk
+    if (state.stopped_at != 0 && (!state.failed || state.stopped_at <= state.err_index)) {
+        return OK(cbor_process_sequence_parallel_result_t, state.stopped_at);
+    }
+    if (state.failed) {
+        return ERR(cbor_process_sequence_parallel_result_t, state.err);
+    }
+    return OK(cbor_process_sequence_parallel_result_t, state.next_index);
+}
+
+#endif /* TARGET_EMBEDDED */
@@ -0,0 +1,58 @@
+#ifndef CBOR_PARALLEL_H
+#define CBOR_PARALLEL_H
+
+#include "cbor.h"
+
+/*--------------------------------------------------------------------------*/
+/* Parallel Sequence Processing (native only) */
+/*--------------------------------------------------------------------------*/
+
+#ifndef TARGET_EMBEDDED
+
+// Call the processor in sequence order instead of as items complete
+#define CBOR_PARALLEL_ORDERED 0x01
+
+// Items are handed out in chunks of about this many bytes
+#ifndef CBOR_PARALLEL_CHUNK_BYTES
+#define CBOR_PARALLEL_CHUNK_BYTES (64 * 1024)
+#endif
+
+// and at most this many items, whose ends are kept while the chunk is processed
+#ifndef CBOR_PARALLEL_CHUNK_ITEMS
+#define CBOR_PARALLEL_CHUNK_ITEMS 1024
+#endif
+
+typedef cbor_custom_processor_result_t (*seq_item_processor_function)(slice_t item, size_t index, void* process_arg);
+
+/**
+ * Runs process on every top level item of a CBOR Sequence (RFC 8742) in buf,
+ * using threads threads (0 for one per online CPU). The calling thread is
+ * one of them.
+ *
+ * Threads take the next chunk of items whenever they are done with their
+ * last one, so uneven items balance out. Item boundaries are found once,
+ * while handing out chunks, since CBOR has no marker to resync on at an
+ * arbitrary offset; decoding is left to process, which gets the encoded
+ * item and its index in the sequence and may be called concurrently.
+ *
+ * With CBOR_PARALLEL_ORDERED process is called once at a time in sequence
+ * order, for processors with ordered side effects such as writing output.
+ * Threads then only overlap in finding the boundaries of the next chunks.
+ *
+ * Returns the number of items. A malformed or truncated item returns its
+ * error after every item before it was processed. A processor error returns
+ * PROCESSOR_ERROR and stops all threads after their current item. Of
+ * several errors, the one about the earliest item is returned.
+ *
+ * A processor returning CBOR_CUSTOM_PROCESSOR_STOP() stops all threads the
+ * same way, and the call returns the index of the stopping item plus one.
+ * Errors about later items are then not reported. Unless ordered, items
+ * around the stopping one may or may not have been processed.
+ */
+FN_RESULT(size_t, cbor_parser_error_t,
+cbor_process_sequence_parallel, slice_t buf, size_t threads, uint8_t flags,
+    seq_item_processor_function process, void* process_arg);
+
+#endif /* TARGET_EMBEDDED */
+
+#endif /* CBOR_PARALLEL_H */
@@ -0,0 +1,248 @@
+#include "path.h"
+
+/*--------------------------------------------------------------------------*/
+cbor_path_compile_result_t cbor_path_compile(const char* path, cbor_path_t* compiled) {
+    if (path == NULL || compiled == NULL) {
+        return ERR(cbor_path_compile_result_t, NULL_PTR_ERROR);
+    }
+    memset(compiled, 0, sizeof(*compiled));
+
+    const char* p = path;
+    while (*p != '\0') {
+        if (compiled->count == CBOR_PATH_MAX_STEPS) {
+            return ERR(cbor_path_compile_result_t, CAPACITY_ERROR);
+        }
+
+        if (*p == '[') {
+            p++;
+            if (*p < '0' || *p > '9') {
+                return ERR(cbor_path_compile_result_t, MALFORMED_INPUT_ERROR);
+            }
+            uint64_t index = 0;
+            while (*p >= '0' && *p <= '9') {
+                index = index * 10 + (uint64_t)(*p++ - '0');
+                if (index > UINT32_MAX) {
+                    return ERR(cbor_path_compile_result_t, CAPACITY_ERROR);
+                }
+            }
+            if (*p++ != ']') {
+                return ERR(cbor_path_compile_result_t, MALFORMED_INPUT_ERROR);
+            }
+            compiled->steps[compiled->count].len = CBOR_PATH_INDEX_STEP;
+            compiled->steps[compiled->count].index = (uint32_t)index;
+        }
+        else {
+            // Keys after the first one are introduced by a dot
+            if (compiled->count > 0) {
+                if (*p++ != '.') {
+                    return ERR(cbor_path_compile_result_t, MALFORMED_INPUT_ERROR);
+                }
+            }
+            size_t len = strcspn(p, ".[");
+            if (len == 0) {
+                return ERR(cbor_path_compile_result_t, MALFORMED_INPUT_ERROR);
+            }
+
+            // Encode as a text string, shortest form
+            size_t header = len < 24 ? 1 : 2;
+            if (len > UINT8_MAX || compiled->key_bytes + header + len > CBOR_PATH_KEY_BYTES) {
+                return ERR(cbor_path_compile_result_t, CAPACITY_ERROR);
+            }
+            uint8_t* key = compiled->keys + compiled->key_bytes;
+            if (header == 1) {
+                key[0] = (CBOR_MAJOR_TYPE_TEXT_STRING << 5) | (uint8_t)len;
+            }
+            else {
+                key[0] = (CBOR_MAJOR_TYPE_TEXT_STRING << 5) | 24;
+                key[1] = (uint8_t)len;
+            }
+            memcpy(key + header, p, len);
+            p += len;
+
+            compiled->steps[compiled->count].offset = compiled->key_bytes;
+            compiled->steps[compiled->count].len = (uint8_t)(header + len);
+            compiled->key_bytes += header + len;
+        }
+        compiled->count++;
+    }
+    return OK(cbor_path_compile_result_t, compiled->count);
+}
+/*--------------------------------------------------------------------------*/
+cbor_path_find_result_t cbor_path_find(const cbor_path_t* path, slice_t buf) {
+    if (path == NULL || buf.ptr == NULL) {
+        return ERR(cbor_path_find_result_t, NULL_PTR_ERROR);
+    }
+
+    // Only an empty path needs the end of the root, every step returns its
+    // value already bounded
+    if (path->count == 0) {
+        cbor_process_result_t end = cbor_skip_item(buf);
+        if (end.is_error) {
+            return ERR(cbor_path_find_result_t, end.err);
+        }
+        return OK(cbor_path_find_result_t, ((slice_t){.len = (size_t)(end.ok - buf.ptr), .ptr = buf.ptr}));
+    }
+
+    slice_t item = buf;
+    for (size_t step = 0; step < path->count; step++) {
+        cbor_parse_result_t container = cbor_parse(item);
+        if (container.is_error) {
+            return ERR(cbor_path_find_result_t, container.err);
+        }
+
+        cbor_map_find_result_t next;
+        if (cbor_path_step_is_index(path, step)) {
+            if (container.ok.type != CBOR_TYPE_ARRAY) {
+                return ERR(cbor_path_find_result_t, KEY_NOT_FOUND_ERROR);
+            }
+            next = cbor_array_get(container.ok.value.array, path->steps[step].index);
+        }
+        else {
+            if (container.ok.type != CBOR_TYPE_MAP) {
+                return ERR(cbor_path_find_result_t, KEY_NOT_FOUND_ERROR);
+            }
+            next = cbor_map_find(container.ok.value.map, cbor_path_step_key(path, step));
+        }
+        if (next.is_error) {
+            return ERR(cbor_path_find_result_t, next.err);
+        }
+        item = next.ok;
+    }
+    return OK(cbor_path_find_result_t, item);
+}
+/*--------------------------------------------------------------------------*/
+typedef struct {
+    const cbor_path_t* paths;
+    slice_t* values;
+    uint8_t* end;
+    uint64_t remaining;     // Paths not found yet
+    size_t found;
+} cbor_project_state_t;
+
+// Paths in mask whose step at depth selects the key or index
+static uint64_t cbor_project_match(const cbor_project_state_t* state, uint64_t mask, size_t depth, slice_t key, uint64_t index) {
+    uint64_t matched = 0;
+    for (uint64_t bits = mask; bits != 0; bits &= bits - 1) {
+        size_t i = (size_t)__builtin_ctzll(bits);
+        const cbor_path_t* path = &state->paths[i];
+        if (key.ptr == NULL) {
+            if (cbor_path_step_is_index(path, depth) && path->steps[depth].index == index) {
+                matched |= bits & -bits;
+            }
+        }
+        else if (!cbor_path_step_is_index(path, depth) && path->steps[depth].len == key.len
+            && memcmp(path->keys + path->steps[depth].offset, key.ptr, key.len) == 0) {
+            matched |= bits & -bits;
+        }
+    }
+    return matched;
+}
+
+// Returns the end of the item. Recursion is bounded by CBOR_PATH_MAX_STEPS.
+static cbor_process_result_t cbor_project_item(cbor_project_state_t* state, uint8_t* item, size_t depth, uint64_t mask) {
+    slice_t rest = {.len = (size_t)(state->end - item), .ptr = item};
+    cbor_process_result_t item_end = {.is_error = 0, .ok = NULL};
+
+    // Paths ending here take the whole item
+    for (uint64_t bits = mask; bits != 0; bits &= bits - 1) {
+        size_t i = (size_t)__builtin_ctzll(bits);
+        if (state->paths[i].count != depth) {
+            continue;
+        }
+        if (item_end.ok == NULL) {
+            item_end = cbor_skip_item(rest);
+            if (item_end.is_error) {
+                return item_end;
+            }
+        }
+        state->values[i] = (slice_t) {.len = (size_t)(item_end.ok - item), .ptr = item};
+        state->remaining &= ~(bits & -bits);
+        state->found++;
+        mask &= ~(bits & -bits);
+    }
+    if (mask == 0) {
+        return item_end.ok != NULL ? item_end : cbor_skip_item(rest);
+    }
+
+    const uint8_t major = cbor_initial_byte_table[*item].major;
+    if (major != CBOR_MAJOR_TYPE_ARRAY && major != CBOR_MAJOR_TYPE_MAP) {
+        return item_end.ok != NULL ? item_end : cbor_skip_item(rest);
+    }
+    cbor_parse_result_t container = cbor_parse(rest);
+    if (container.is_error) {
+        return ERR(cbor_process_result_t, container.err);
+    }
+
+    const int is_map = major == CBOR_MAJOR_TYPE_MAP;
+    const uint32_t length = is_map ? container.ok.value.map.length : container.ok.value.array.length;
+    uint8_t* current = is_map ? container.ok.value.map.inside : container.ok.value.array.inside;
+
+    for (uint64_t index = 0; length == CBOR_LENGTH_INDEFINITE || index < length; index++) {
+        if (current >= state->end) {
+            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+        if (length == CBOR_LENGTH_INDEFINITE && *current == 0xFF) {
+            return OK(cbor_process_result_t, current + 1);
+        }
+
+        // Once this container's paths are all found the rest is only skipped
+        const uint64_t wanted = mask & state->remaining;
+        uint64_t matched = 0;
+        if (is_map) {
+            cbor_process_result_t key_end = cbor_skip_item((slice_t) {.len = (size_t)(state->end - current), .ptr = current});
+            if (key_end.is_error) {
+                return key_end;
+            }
+            if (wanted != 0) {
+                slice_t key = {.len = (size_t)(key_end.ok - current), .ptr = current};
+                matched = cbor_project_match(state, wanted, depth, key, 0);
+            }
+            current = key_end.ok;
+            if (current >= state->end) {
+                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            }
+        }
+        else if (wanted != 0) {
+            matched = cbor_project_match(state, wanted, depth, (slice_t) {0}, index);
+        }
+
+        cbor_process_result_t next = matched != 0
+            ? cbor_project_item(state, current, depth + 1, matched)
+            : cbor_skip_item((slice_t) {.len = (size_t)(state->end - current), .ptr = current});
+        if (next.is_error || state->remaining == 0) {
+            return next;
+        }
+        current = next.ok;
+    }
+    return OK(cbor_process_result_t, current);
+}
+/*--------------------------------------------------------------------------*/
+cbor_project_result_t cbor_project(slice_t buf, const cbor_path_t* paths, size_t count, slice_t* values) {
+    if (buf.ptr == NULL || paths == NULL || values == NULL) {
+        return ERR(cbor_project_result_t, NULL_PTR_ERROR);
+    }
+    if (buf.len == 0) {
+        return ERR(cbor_project_result_t, EMPTY_BUFFER_ERROR);
+    }
+    if (count > CBOR_PROJECT_MAX_PATHS) {
+        return ERR(cbor_project_result_t, CAPACITY_ERROR);
+    }
+    if (count == 0) {
+        return OK(cbor_project_result_t, 0);
+    }
+
+    memset(values, 0, count * sizeof(*values));
+    cbor_project_state_t state = {
+        .paths = paths,
+        .values = values,
+        .end = buf.ptr + buf.len,
+        .remaining = count == CBOR_PROJECT_MAX_PATHS ? UINT64_MAX : (UINT64_C(1) << count) - 1,
+        .found = 0,
+    };
+
+    cbor_process_result_t end = cbor_project_item(&state, buf.ptr, 0, state.remaining);
+    if (end.is_error) {
+        return ERR(cbor_project_result_t, end.err);
+    }
+    return OK(cbor_project_result_t, state.found);
+}
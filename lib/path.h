@@ -0,0 +1,78 @@
+#ifndef CBOR_PATH_H
+#define CBOR_PATH_H
+
+#include "cbor.h"
+
+/*--------------------------------------------------------------------------*/
+/* Path Queries */
+/*--------------------------------------------------------------------------*/
+
+#ifndef CBOR_PATH_MAX_STEPS
+#define CBOR_PATH_MAX_STEPS 8
+#endif
+
+// Room for the encoded keys of one path
+#ifndef CBOR_PATH_KEY_BYTES
+#define CBOR_PATH_KEY_BYTES 64
+#endif
+
+#define CBOR_PATH_INDEX_STEP 0xFF
+
+/**
+ * A path such as "d.sn" or "r.parameters[2]" compiled into steps. Map keys
+ * are stored encoded as text strings so they can be compared with memcmp.
+ */
+typedef struct {
+    struct {
+        uint8_t offset;     // Encoded key in keys[]
+        uint8_t len;        // Encoded key length, CBOR_PATH_INDEX_STEP for array indices
+        uint32_t index;
+    } steps[CBOR_PATH_MAX_STEPS];
+    uint8_t count;
+    uint8_t key_bytes;
+    uint8_t keys[CBOR_PATH_KEY_BYTES];
+} cbor_path_t;
+
+/**
+ * Compiles a path of dot separated map keys and [n] array indices, returns
+ * the number of steps. Keys are text strings and may not contain '.' or '['.
+ * Returns MALFORMED_INPUT_ERROR for syntax errors and CAPACITY_ERROR if the
+ * path does not fit in cbor_path_t.
+ */
+FN_RESULT(size_t, cbor_parser_error_t,
+cbor_path_compile, const char* path, cbor_path_t* compiled);
+
+/**
+ * Follows the path from the item at the start of buf and returns the encoded
+ * target item. Siblings off the path are skipped without being parsed, and
+ * nothing after the target is read.
+ * Returns KEY_NOT_FOUND_ERROR if a key or index is missing or a step meets
+ * the wrong container type.
+ */
+FN_RESULT(slice_t, cbor_parser_error_t,
+cbor_path_find, const cbor_path_t* path, slice_t buf);
+
+#define CBOR_PROJECT_MAX_PATHS 64
+
+/**
+ * Looks up several paths in a single pass over buf. values[i] receives the
+ * encoded item at paths[i], or {0, NULL} if it is missing. Subtrees no path
+ * refers to are skipped and the walk stops as soon as every path is found,
+ * so shared prefixes are only read once. Returns the number of paths found,
+ * CAPACITY_ERROR for more than CBOR_PROJECT_MAX_PATHS paths.
+ */
+FN_RESULT(size_t, cbor_parser_error_t,
+cbor_project, slice_t buf, const cbor_path_t* paths, size_t count, slice_t* values);
+
+static inline int cbor_path_step_is_index(const cbor_path_t* path, size_t step) {
+    return path->steps[step].len == CBOR_PATH_INDEX_STEP;
+}
+
+static inline slice_t cbor_path_step_key(const cbor_path_t* path, size_t step) {
+    return (slice_t) {
+        .len = path->steps[step].len,
+        .ptr = (uint8_t*)path->keys + path->steps[step].offset,
+    };
+}
+
+#endif /* CBOR_PATH_H */
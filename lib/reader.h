@@ -0,0 +1,152 @@
+#ifndef CBOR_READER_H
+#define CBOR_READER_H
+
+#include "cbor.h"
+
+/*--------------------------------------------------------------------------*/
+/* Cursor API */
+/*--------------------------------------------------------------------------*/
+
+/**
+ * Pull style alternative to the processor callbacks. The reader walks the
+ * buffer item by item; cbor_reader_enter() steps into an array or map and
+ * cbor_reader_leave() steps out of it, skipping whatever was not read.
+ * Map keys and values are read as consecutive items.
+ *
+ * Everything is inline so loops over a reader compile without indirect calls.
+ *
+ * At depth 0 the reader returns items until the end of the buffer.
+ */
+typedef struct {
+    uint8_t* current;
+    uint8_t* end;
+    size_t depth;
+    size_t remaining[CBOR_MAX_DEPTH + 1];  // Items left per level, SIZE_MAX for indefinite length
+    uint8_t pairing[CBOR_MAX_DEPTH + 1];   // Indefinite maps: 1 after a value, 2 after a key, else 0
+} cbor_reader_t;
+
+static inline void cbor_reader_init(cbor_reader_t* reader, slice_t buf) {
+    reader->current = buf.ptr;
+    reader->end = buf.ptr + buf.len;
+    reader->depth = 0;
+    reader->remaining[0] = SIZE_MAX;
+    reader->pairing[0] = 0;
+}
+
+/* Returns 1 if there are no more items in the current container */
+static inline int cbor_reader_at_end(const cbor_reader_t* reader) {
+    if (reader->depth == 0) {
+        return reader->current >= reader->end;
+    }
+    if (reader->remaining[reader->depth] == SIZE_MAX) {
+        return reader->current < reader->end && (cbor_initial_byte_table[*reader->current].flags & CBOR_IB_BREAK);
+    }
+    return reader->remaining[reader->depth] == 0;
+}
+
+static inline slice_t cbor_reader_rest(const cbor_reader_t* reader) {
+    return (slice_t) {
+        .len = (size_t)(reader->end - reader->current),
+        .ptr = reader->current,
+    };
+}
+
+static inline void cbor_reader_consumed(cbor_reader_t* reader, uint8_t* next) {
+    reader->current = next;
+    if (reader->remaining[reader->depth] != SIZE_MAX) {
+        reader->remaining[reader->depth]--;
+    }
+    else if (reader->pairing[reader->depth]) {
+        reader->pairing[reader->depth] ^= 3;
+    }
+}
+
+/* Parses the current item without moving past it, BUFFER_OVERFLOW_ERROR past the end of the container */
+static inline cbor_parse_result_t cbor_reader_peek(const cbor_reader_t* reader) {
+    if (cbor_reader_at_end(reader) || reader->current >= reader->end) {
+        return ERR(cbor_parse_result_t, BUFFER_OVERFLOW_ERROR);
+    }
+    if (cbor_initial_byte_table[*reader->current].flags & CBOR_IB_BREAK) {
+        return ERR(cbor_parse_result_t, MALFORMED_INPUT_ERROR);
+    }
+    return cbor_parse(cbor_reader_rest(reader));
+}
+
+/**
+ * Returns the current item and moves past it. Arrays, maps and indefinite
+ * length strings are skipped as a whole and their next pointer is set.
+ */
+static inline cbor_parse_result_t cbor_reader_next(cbor_reader_t* reader) {
+    cbor_parse_result_t value = cbor_reader_peek(reader);
+    if (value.is_error) {
+        return value;
+    }
+    if (value.ok.next == NULL) {
+        cbor_process_result_t end = cbor_skip(cbor_reader_rest(reader));
+        if (end.is_error) {
+            return ERR(cbor_parse_result_t, end.err);
+        }
+        value.ok.next = end.ok;
+    }
+    cbor_reader_consumed(reader, value.ok.next);
+    return value;
+}
+
+/* Steps into the array or map at the current position and returns it */
+static inline cbor_parse_result_t cbor_reader_enter(cbor_reader_t* reader) {
+    cbor_parse_result_t value = cbor_reader_peek(reader);
+    if (value.is_error) {
+        return value;
+    }
+    if (value.ok.type != CBOR_TYPE_ARRAY && value.ok.type != CBOR_TYPE_MAP) {
+        return ERR(cbor_parse_result_t, MALFORMED_INPUT_ERROR);
+    }
+    if (reader->depth == CBOR_MAX_DEPTH) {
+        return ERR(cbor_parse_result_t, DEPTH_LIMIT_ERROR);
+    }
+
+    // Arrays and maps share the same layout
+    cbor_array_t container = value.ok.value.array;
+    size_t remaining = SIZE_MAX;
+    if (container.length != CBOR_LENGTH_INDEFINITE) {
+        // Every item takes at least one byte, so larger counts cannot fit
+        size_t per_item = value.ok.type == CBOR_TYPE_MAP ? 2 : 1;
+        if (container.length > container.max_size / per_item) {
+            return ERR(cbor_parse_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+        remaining = (size_t)container.length * per_item;
+    }
+
+    cbor_reader_consumed(reader, container.inside);
+    reader->remaining[++reader->depth] = remaining;
+    reader->pairing[reader->depth] = remaining == SIZE_MAX && value.ok.type == CBOR_TYPE_MAP;
+    return value;
+}
+
+/* Skips the rest of the current container and steps out of it, returns the end of the container */
+static inline cbor_process_result_t cbor_reader_leave(cbor_reader_t* reader) {
+    if (reader->depth == 0) {
+        return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+    }
+    while (!cbor_reader_at_end(reader)) {
+        if (reader->current >= reader->end) {
+            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+        cbor_process_result_t end = cbor_skip(cbor_reader_rest(reader));
+        if (end.is_error) {
+            return end;
+        }
+        cbor_reader_consumed(reader, end.ok);
+    }
+    if (reader->remaining[reader->depth] == SIZE_MAX) {
+        // A break after a key leaves the map one value short
+        if (reader->pairing[reader->depth] == 2) {
+            return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+        }
+        reader->current++;  // Break
+    }
+    reader->depth--;
+    return OK(cbor_process_result_t, reader->current);
+}
+
+#endif /* CBOR_READER_H */
@@ -0,0 +1,37 @@
+#include "seq.h"
+
+/*--------------------------------------------------------------------------*/
+void cbor_seq_init(cbor_seq_iter_t* iter, slice_t buf, uint8_t flags) {
+    iter->buf = buf;
+    iter->offset = 0;
+    iter->skipped = 0;
+    iter->flags = flags;
+}
+/*--------------------------------------------------------------------------*/
+cbor_seq_next_result_t cbor_seq_next(cbor_seq_iter_t* iter) {
+    if (iter == NULL || iter->buf.ptr == NULL) {
+        return ERR(cbor_seq_next_result_t, NULL_PTR_ERROR);
+    }
+
+    int retry = 0;
+    while (!cbor_seq_at_end(iter)) {
+        slice_t rest = cbor_seq_rest(iter);
+        if (retry && rest.len > CBOR_SEQ_RESYNC_WINDOW) {
+            rest.len = CBOR_SEQ_RESYNC_WINDOW;
+        }
+        cbor_process_result_t end = cbor_skip_item(rest);
+        if (!end.is_error) {
+            slice_t item = {.len = (size_t)(end.ok - rest.ptr), .ptr = rest.ptr};
+            iter->offset += item.len;
+            return OK(cbor_seq_next_result_t, item);
+        }
+
+        if (!(iter->flags & CBOR_SEQ_RESYNC)) {
+            return ERR(cbor_seq_next_result_t, end.err);
+        }
+        iter->offset++;
+        iter->skipped++;
+        retry = 1;
+    }
+    return ERR(cbor_seq_next_result_t, EMPTY_BUFFER_ERROR);
+}
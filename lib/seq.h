@@ -0,0 +1,58 @@
+#ifndef CBOR_SEQ_H
+#define CBOR_SEQ_H
+
+#include "cbor.h"
+
+/*--------------------------------------------------------------------------*/
+/* CBOR Sequences (RFC 8742) */
+/*--------------------------------------------------------------------------*/
+
+// Skip corrupt items instead of stopping at them
+#define CBOR_SEQ_RESYNC 0x01
+
+// Bytes an item may span while resynchronizing, which bounds each retry
+#ifndef CBOR_SEQ_RESYNC_WINDOW
+#define CBOR_SEQ_RESYNC_WINDOW (64 * 1024)
+#endif
+
+/**
+ * Iterates over back to back top level items. Each call to cbor_seq_next
+ * returns the encoded span of one item, found with cbor_skip_item, so
+ * containers are skipped without building values.
+ */
+typedef struct {
+    slice_t buf;
+    size_t offset;      // Start of the next item
+    size_t skipped;     // Bytes dropped while resynchronizing
+    uint8_t flags;      // CBOR_SEQ_*
+} cbor_seq_iter_t;
+
+void cbor_seq_init(cbor_seq_iter_t* iter, slice_t buf, uint8_t flags);
+
+/**
+ * Returns the next item, EMPTY_BUFFER_ERROR once the sequence is used up.
+ *
+ * A corrupt item returns its error and the iterator stays in front of it,
+ * so a truncated last item gives BUFFER_OVERFLOW_ERROR and cbor_seq_rest()
+ * its bytes, to be completed with more data. With CBOR_SEQ_RESYNC, meant for
+ * complete buffers such as files, the iterator instead drops one byte at a
+ * time until an item decodes again and counts the dropped bytes in skipped.
+ * The first attempt at an item may span the whole buffer, the retries after
+ * a failure only look within CBOR_SEQ_RESYNC_WINDOW bytes, so every dropped
+ * byte costs at most one window. An item longer than the window that starts
+ * right after corrupt bytes is not found again, its contents are then
+ * resynchronized like the corrupt bytes.
+ */
+FN_RESULT(slice_t, cbor_parser_error_t,
+cbor_seq_next, cbor_seq_iter_t* iter);
+
+static inline int cbor_seq_at_end(const cbor_seq_iter_t* iter) {
+    return iter->offset >= iter->buf.len;
+}
+
+// Unread part of the buffer, e.g. a truncated last item
+static inline slice_t cbor_seq_rest(const cbor_seq_iter_t* iter) {
+    return (slice_t) {.len = iter->buf.len - iter->offset, .ptr = iter->buf.ptr + iter->offset};
+}
+
+#endif /* CBOR_SEQ_H */
@@ -0,0 +1,172 @@
+#include "stream.h"
+
+#define STREAM_INDEFINITE UINT32_MAX
+
+enum {
+    STREAM_NO_STRING,
+    STREAM_STRING,  // Definite length string, ends with an END event
+    STREAM_CHUNK,   // Chunk of an indefinite length string, ends silently
+};
+
+/*--------------------------------------------------------------------------*/
+void cbor_stream_init(cbor_stream_t* stream) {
+    memset(stream, 0, sizeof(*stream));
+}
+/*--------------------------------------------------------------------------*/
+static inline void cbor_stream_item_done(cbor_stream_t* stream) {
+    if (stream->depth > 0 && stream->remaining[stream->depth - 1] != STREAM_INDEFINITE) {
+        stream->remaining[stream->depth - 1]--;
+    }
+    else if (stream->depth > 0 && stream->major[stream->depth - 1] == CBOR_MAJOR_TYPE_MAP) {
+        stream->odd[stream->depth - 1] ^= 1;
+    }
+}
+/*--------------------------------------------------------------------------*/
+static inline cbor_stream_result_t cbor_stream_event(const cbor_stream_t* stream, cbor_stream_event_type_t type, cbor_major_type_t major) {
+    return OK(cbor_stream_result_t, ((cbor_stream_event_t) {
+        .type = type,
+        .major = major,
+        .depth = stream->depth,
+    }));
+}
+/*--------------------------------------------------------------------------*/
+static cbor_stream_result_t cbor_stream_push(cbor_stream_t* stream, cbor_major_type_t major, uint64_t items, cbor_stream_result_t event) {
+    if (stream->depth == CBOR_MAX_DEPTH) {
+        return ERR(cbor_stream_result_t, DEPTH_LIMIT_ERROR);
+    }
+    if (items >= STREAM_INDEFINITE && items != CBOR_STREAM_INDEFINITE) {
+        return ERR(cbor_stream_result_t, CAPACITY_ERROR);
+    }
+    stream->remaining[stream->depth] = items == CBOR_STREAM_INDEFINITE ? STREAM_INDEFINITE : (uint32_t)items;
+    stream->major[stream->depth] = major;
+    stream->odd[stream->depth] = 0;
+    stream->depth++;
+    return event;
+}
+/*--------------------------------------------------------------------------*/
+cbor_stream_result_t cbor_stream_next(cbor_stream_t* stream, slice_t* input) {
+    for (;;) {
+        // Deliver string contents straight from the input
+        if (stream->string_state != STREAM_NO_STRING) {
+            uint8_t data_depth = stream->string_state == STREAM_CHUNK ? stream->depth - 1 : stream->depth;
+            // header[] still holds the initial byte of a definite length string
+            cbor_major_type_t major = stream->string_state == STREAM_CHUNK ? stream->major[stream->depth - 1] : stream->header[0] >> 5;
+
+            if (stream->string_left > 0) {
+                if (input->len == 0) {
+                    return cbor_stream_event(stream, CBOR_STREAM_NEED_MORE, major);
+                }
+                size_t n = stream->string_left < input->len ? (size_t)stream->string_left : input->len;
+                cbor_stream_result_t result = cbor_stream_event(stream, CBOR_STREAM_DATA, major);
+                result.ok.depth = data_depth;
+                result.ok.data = (slice_t) {.len = n, .ptr = input->ptr};
+                input->ptr += n;
+                input->len -= n;
+                stream->string_left -= n;
+                return result;
+            }
+
+            int chunk = stream->string_state == STREAM_CHUNK;
+            stream->string_state = STREAM_NO_STRING;
+            if (!chunk) {
+                cbor_stream_item_done(stream);
+                return cbor_stream_event(stream, CBOR_STREAM_END, major);
+            }
+        }
+
+        // Close definite length containers and tags once their last item is done
+        if (stream->depth > 0 && stream->remaining[stream->depth - 1] == 0) {
+            stream->depth--;
+            cbor_stream_item_done(stream);
+            if (stream->major[stream->depth] == CBOR_MAJOR_TYPE_TAG) {
+                continue;
+            }
+            return cbor_stream_event(stream, CBOR_STREAM_END, stream->major[stream->depth]);
+        }
+
+        // Collect the header, it may be split across chunks
+        if (input->len == 0) {
+            return cbor_stream_event(stream, CBOR_STREAM_NEED_MORE, CBOR_MAJOR_TYPE_ERROR);
+        }
+        if (stream->header_len == 0) {
+            stream->header[stream->header_len++] = *input->ptr++;
+            input->len--;
+        }
+        const cbor_initial_byte_t ib = cbor_initial_byte_table[stream->header[0]];
+        if (ib.flags & CBOR_IB_RESERVED) {
+            return ERR(cbor_stream_result_t, MALFORMED_INPUT_ERROR);
+        }
+        size_t missing = 1 + ib.size - stream->header_len;
+        size_t n = missing < input->len ? missing : input->len;
+        memcpy(stream->header + stream->header_len, input->ptr, n);
+        stream->header_len += n;
+        input->ptr += n;
+        input->len -= n;
+        if (n < missing) {
+            return cbor_stream_event(stream, CBOR_STREAM_NEED_MORE, CBOR_MAJOR_TYPE_ERROR);
+        }
+        stream->header_len = 0;
+
+        uint64_t argument = (ib.flags & CBOR_IB_INDEFINITE)
+            ? CBOR_STREAM_INDEFINITE
+            : cbor_argument_to_fixed(cbor_read_argument(ib, stream->header));
+
+        if (ib.flags & CBOR_IB_BREAK) {
+            if (stream->depth == 0 || stream->remaining[stream->depth - 1] != STREAM_INDEFINITE || stream->odd[stream->depth - 1]) {
+                return ERR(cbor_stream_result_t, MALFORMED_INPUT_ERROR);
+            }
+            stream->depth--;
+            cbor_stream_item_done(stream);
+            return cbor_stream_event(stream, CBOR_STREAM_END, stream->major[stream->depth]);
+        }
+
+        // Inside an indefinite length string only definite chunks of the same type may appear
+        if (stream->depth > 0 &&
+            (stream->major[stream->depth - 1] == CBOR_MAJOR_TYPE_BYTE_STRING || stream->major[stream->depth - 1] == CBOR_MAJOR_TYPE_TEXT_STRING)) {
+            if (ib.major != stream->major[stream->depth - 1] || argument == CBOR_STREAM_INDEFINITE) {
+                return ERR(cbor_stream_result_t, MALFORMED_INPUT_ERROR);
+            }
+            stream->string_state = STREAM_CHUNK;
+            stream->string_left = argument;
+            continue;
+        }
+
+        cbor_stream_result_t result;
+        switch (ib.major) {
+        case CBOR_MAJOR_TYPE_BYTE_STRING:
+        case CBOR_MAJOR_TYPE_TEXT_STRING:
+            result = cbor_stream_event(stream, CBOR_STREAM_START, ib.major);
+            result.ok.length = argument;
+            if (argument == CBOR_STREAM_INDEFINITE) {
+                return cbor_stream_push(stream, ib.major, argument, result);
+            }
+            stream->string_state = STREAM_STRING;
+            stream->string_left = argument;
+            return result;
+        case CBOR_MAJOR_TYPE_ARRAY:
+        case CBOR_MAJOR_TYPE_MAP:
+            result = cbor_stream_event(stream, CBOR_STREAM_START, ib.major);
+            result.ok.length = argument;
+            if (ib.major == CBOR_MAJOR_TYPE_MAP && argument != CBOR_STREAM_INDEFINITE) {
+                // Keys and values are counted separately
+                argument = argument > UINT32_MAX ? UINT32_MAX : argument * 2;
+            }
+            return cbor_stream_push(stream, ib.major, argument, result);
+        case CBOR_MAJOR_TYPE_TAG:
+            result = cbor_stream_event(stream, CBOR_STREAM_TAG, ib.major);
+            result.ok.tag = argument;
+            return cbor_stream_push(stream, ib.major, 1, result);
+        default: {
+            cbor_parse_result_t value = cbor_parse((slice_t) {.len = 1 + ib.size, .ptr = stream->header});
+            if (value.is_error) {
+                return ERR(cbor_stream_result_t, value.err);
+            }
+            result = cbor_stream_event(stream, CBOR_STREAM_VALUE, ib.major);
+            result.ok.value = value.ok;
+            result.ok.value.next = NULL;  // Would point into the state, not the input
+            cbor_stream_item_done(stream);
+            return result;
+        }
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef CBOR_STREAM_H
+#define CBOR_STREAM_H
+
+#include "cbor.h"
+
+/*--------------------------------------------------------------------------*/
+/* Streaming Parser */
+/*--------------------------------------------------------------------------*/
+
+#define CBOR_STREAM_INDEFINITE UINT64_MAX
+
+typedef enum {
+    CBOR_STREAM_NEED_MORE,  // The input chunk is used up, call again with the next one
+    CBOR_STREAM_VALUE,      // Integer, simple or float
+    CBOR_STREAM_START,      // Array, map or string header
+    CBOR_STREAM_DATA,       // Part of the contents of a string
+    CBOR_STREAM_END,        // End of an array, map or string
+    CBOR_STREAM_TAG,        // Tag number, the tagged item follows
+} cbor_stream_event_type_t;
+
+typedef struct {
+    cbor_stream_event_type_t type;
+    cbor_major_type_t major;
+    uint8_t depth;              // Nesting depth of the item, 0 at the top level
+    union {
+        cbor_value_t value;     // VALUE
+        uint64_t length;        // START: item count or string length, CBOR_STREAM_INDEFINITE if not known
+        slice_t data;           // DATA: points into the input chunk, valid as long as the chunk is
+        uint64_t tag;           // TAG
+    };
+} cbor_stream_event_t;
+
+/**
+ * Decoder state kept between input chunks. Headers split across chunks are
+ * collected in header[], string contents are never copied.
+ */
+typedef struct {
+    uint64_t string_left;                    // Bytes of the current string not delivered yet
+    uint32_t remaining[CBOR_MAX_DEPTH];      // Items left per level, UINT32_MAX for indefinite length
+    uint8_t major[CBOR_MAX_DEPTH];           // Major type per level, strings for indefinite string chunks
+    uint8_t odd[CBOR_MAX_DEPTH];             // Indefinite maps: a key is waiting for its value
+    uint8_t header[9];
+    uint8_t header_len;
+    uint8_t depth;
+    uint8_t string_state;
+} cbor_stream_t;
+
+_Static_assert(CBOR_MAX_DEPTH > 16 || sizeof(cbor_stream_t) <= 128, "cbor_stream_t should fit in 128 bytes");
+
+DEFINE_RESULT_TYPE(cbor_stream_event_t, cbor_parser_error_t);
+typedef RESULT_TYPE_NAME(cbor_stream_event_t, cbor_parser_error_t) cbor_stream_result_t;
+
+void cbor_stream_init(cbor_stream_t* stream);
+
+/**
+ * Returns the next event from input and advances input past the bytes used.
+ * Returns CBOR_STREAM_NEED_MORE once input is empty and more data is needed.
+ * After an error the stream has to be initialized again.
+ */
+cbor_stream_result_t cbor_stream_next(cbor_stream_t* stream, slice_t* input);
+
+/* Returns 1 between top level items, when the input seen so far ends on an item boundary */
+static inline int cbor_stream_idle(const cbor_stream_t* stream) {
+    return stream->depth == 0 && stream->header_len == 0 && stream->string_state == 0;
+}
+
+#endif /* CBOR_STREAM_H */
@@ -0,0 +1,361 @@
+#include "struct.h"
+
+/*--------------------------------------------------------------------------*/
+static uint64_t cbor_field_max_unsigned(uint8_t size) {
+    return size >= 8 ? UINT64_MAX : ((uint64_t)1 << (8 * size)) - 1;
+}
+
+static void cbor_field_store_unsigned(uint8_t* member, uint8_t size, uint64_t value) {
+    switch (size) {
+    case 1: { uint8_t v = (uint8_t)value;   memcpy(member, &v, sizeof(v)); break; }
+    case 2: { uint16_t v = (uint16_t)value; memcpy(member, &v, sizeof(v)); break; }
+    case 4: { uint32_t v = (uint32_t)value; memcpy(member, &v, sizeof(v)); break; }
+    default: memcpy(member, &value, sizeof(value)); break;
+    }
+}
+
+static void cbor_field_store_signed(uint8_t* member, uint8_t size, int64_t value) {
+    switch (size) {
+    case 1: { int8_t v = (int8_t)value;   memcpy(member, &v, sizeof(v)); break; }
+    case 2: { int16_t v = (int16_t)value; memcpy(member, &v, sizeof(v)); break; }
+    case 4: { int32_t v = (int32_t)value; memcpy(member, &v, sizeof(v)); break; }
+    default: memcpy(member, &value, sizeof(value)); break;
+    }
+}
+
+static cbor_process_result_t cbor_decode_struct_at(cbor_map_t map, const cbor_struct_schema_t* schema, uint8_t* out, uint64_t* missing, size_t depth);
+
+// Decodes one value into its member, present is cleared for null values
+static cbor_process_result_t cbor_decode_field(const cbor_field_t* field, slice_t rest, uint8_t* out, size_t depth, int* present) {
+    uint8_t* member = out + field->offset;
+    const uint8_t major = cbor_initial_byte_table[*rest.ptr].major;
+
+    if (*rest.ptr == 0xF6) {
+        *present = 0;
+        return OK(cbor_process_result_t, rest.ptr + 1);
+    }
+    if (field->kind == CBOR_FIELD_ITEM) {
+        cbor_process_result_t end = cbor_skip_item(rest);
+        if (!end.is_error) {
+            slice_t item = {.len = (size_t)(end.ok - rest.ptr), .ptr = rest.ptr};
+            memcpy(member, &item, sizeof(item));
+        }
+        return end;
+    }
+
+    cbor_parse_result_t value = cbor_parse(rest);
+    if (value.is_error) {
+        return ERR(cbor_process_result_t, value.err);
+    }
+
+    switch (field->kind) {
+    case CBOR_FIELD_INT:
+    case CBOR_FIELD_UINT: {
+        if (value.ok.type != CBOR_TYPE_INTEGER) {
+            return ERR(cbor_process_result_t, TYPE_MISMATCH_ERROR);
+        }
+        // Negative integers are -1 - argument, so both signs share one bound
+        const uint64_t argument = cbor_argument_to_fixed(value.ok.argument);
+        const uint64_t max = cbor_field_max_unsigned(field->size);
+        if (field->kind == CBOR_FIELD_UINT) {
+            if (major == CBOR_MAJOR_TYPE_NEGATIVE_INTEGER || argument > max) {
+                return ERR(cbor_process_result_t, OUT_OF_RANGE_ERROR);
+            }
+            cbor_field_store_unsigned(member, field->size, argument);
+        }
+        else {
+            if (argument > (max >> 1)) {
+                return ERR(cbor_process_result_t, OUT_OF_RANGE_ERROR);
+            }
+            int64_t integer = major == CBOR_MAJOR_TYPE_NEGATIVE_INTEGER ? -1 - (int64_t)argument : (int64_t)argument;
+            cbor_field_store_signed(member, field->size, integer);
+        }
+        return OK(cbor_process_result_t, value.ok.next);
+    }
+    case CBOR_FIELD_BOOL:
+        if (value.ok.type != CBOR_TYPE_SIMPLE
+            || (value.ok.value.simple != CBOR_SIMPLE_FALSE && value.ok.value.simple != CBOR_SIMPLE_TRUE)) {
+            return ERR(cbor_process_result_t, TYPE_MISMATCH_ERROR);
+        }
+        *member = value.ok.value.simple == CBOR_SIMPLE_TRUE;
+        return OK(cbor_process_result_t, value.ok.next);
+    case CBOR_FIELD_FLOAT:
+        if (value.ok.type != CBOR_TYPE_FLOAT) {
+            return ERR(cbor_process_result_t, TYPE_MISMATCH_ERROR);
+        }
+        if (field->size == sizeof(double)) {
+            double f64 = cbor_value_double(&value.ok);
+            memcpy(member, &f64, sizeof(f64));
+        }
+        else {
+            float f32 = cbor_value_float(&value.ok);
+            memcpy(member, &f32, sizeof(f32));
+        }
+        return OK(cbor_process_result_t, value.ok.next);
+    case CBOR_FIELD_BYTES:
+    case CBOR_FIELD_TEXT: {
+        // Indefinite length strings have no single slice to point at
+        const cbor_type_t expected = field->kind == CBOR_FIELD_BYTES ? CBOR_TYPE_BYTE_STRING : CBOR_TYPE_TEXT_STRING;
+        if (value.ok.type != expected || value.ok.next == NULL) {
+            return ERR(cbor_process_result_t, TYPE_MISMATCH_ERROR);
+        }
+        memcpy(member, &value.ok.value.bytes, sizeof(value.ok.value.bytes));
+        return OK(cbor_process_result_t, value.ok.next);
+    }
+    case CBOR_FIELD_MAP: {
+        if (value.ok.type != CBOR_TYPE_MAP) {
+            return ERR(cbor_process_result_t, TYPE_MISMATCH_ERROR);
+        }
+        uint64_t nested_missing = 0;
+        cbor_process_result_t end = cbor_decode_struct_at(value.ok.value.map, field->nested.schema, member, &nested_missing, depth + 1);
+        if (!end.is_error && nested_missing != 0) {
+            *present = 0;
+        }
+        return end;
+    }
+    case CBOR_FIELD_KEY_BITMAP: {
+        if (value.ok.type != CBOR_TYPE_ARRAY) {
+            return ERR(cbor_process_result_t, TYPE_MISMATCH_ERROR);
+        }
+        uint64_t bitmap = 0;
+        cbor_process_result_t end = cbor_decode_key_bitmap(value.ok.value.array, field->nested.keys.lookup, &bitmap);
+        if (end.is_error) {
+            return end;
+        }
+        if (bitmap > cbor_field_max_unsigned(field->size)) {
+            return ERR(cbor_process_result_t, OUT_OF_RANGE_ERROR);
+        }
+        cbor_field_store_unsigned(member, field->size, bitmap);
+        return end;
+    }
+    default:
+        return ERR(cbor_process_result_t, TYPE_MISMATCH_ERROR);
+    }
+}
+/*--------------------------------------------------------------------------*/
+static cbor_process_result_t cbor_decode_struct_at(cbor_map_t map, const cbor_struct_schema_t* schema, uint8_t* out, uint64_t* missing, size_t depth) {
+    if (map.inside == NULL || schema == NULL || out == NULL) {
+        return ERR(cbor_process_result_t, NULL_PTR_ERROR);
+    }
+    if (schema->count > CBOR_STRUCT_MAX_FIELDS) {
+        return ERR(cbor_process_result_t, CAPACITY_ERROR);
+    }
+    if (depth >= CBOR_MAX_DEPTH) {
+        return ERR(cbor_process_result_t, DEPTH_LIMIT_ERROR);
+    }
+
+    uint64_t found = 0;
+    size_t hint = 0;    // Field after the previous match
+    uint8_t* current = map.inside;
+    uint8_t* const end = map.inside + map.max_size;
+
+    for (uint32_t i = 0; map.length == CBOR_LENGTH_INDEFINITE || i < map.length; i++) {
+        if (current >= end) {
+            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+        if (map.length == CBOR_LENGTH_INDEFINITE && (cbor_initial_byte_table[*current].flags & CBOR_IB_BREAK)) {
+            current++;
+            break;
+        }
+
+        slice_t rest = {.len = (size_t)(end - current), .ptr = current};
+        cbor_parse_result_t key = cbor_parse(rest);
+        if (key.is_error) {
+            return ERR(cbor_process_result_t, key.err);
+        }
+
+        // Non string keys and indefinite strings never match
+        size_t match = schema->count;
+        if (key.ok.type == CBOR_TYPE_TEXT_STRING && key.ok.next != NULL) {
+            for (size_t n = 0; n < schema->count; n++) {
+                size_t f = hint + n < schema->count ? hint + n : hint + n - schema->count;
+                if (schema->fields[f].key_len == key.ok.value.bytes.len
+                    && memcmp(schema->fields[f].key, key.ok.value.bytes.ptr, key.ok.value.bytes.len) == 0) {
+                    match = f;
+                    break;
+                }
+            }
+            current = key.ok.next;
+        }
+        else {
+            cbor_process_result_t key_end = cbor_skip(rest);
+            if (key_end.is_error) {
+                return key_end;
+            }
+            current = key_end.ok;
+        }
+
+        if (current >= end) {
+            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+        rest = (slice_t) {.len = (size_t)(end - current), .ptr = current};
+
+        cbor_process_result_t value_end;
+        if (match == schema->count) {
+            value_end = cbor_skip_item(rest);
+        }
+        else {
+            int present = 1;
+            value_end = cbor_decode_field(&schema->fields[match], rest, out, depth, &present);
+            if (present) {
+                found |= (uint64_t)1 << match;
+            }
+            hint = match + 1;
+        }
+        if (value_end.is_error) {
+            return value_end;
+        }
+        current = value_end.ok;
+    }
+
+    if (missing != NULL) {
+        *missing = 0;
+        for (size_t f = 0; f < schema->count; f++) {
+            if ((schema->fields[f].flags & CBOR_FIELD_REQUIRED) && !(found & ((uint64_t)1 << f))) {
+                *missing |= (uint64_t)1 << f;
+            }
+        }
+    }
+    return OK(cbor_process_result_t, current);
+}
+/*--------------------------------------------------------------------------*/
+cbor_process_result_t cbor_decode_struct(cbor_map_t map, const cbor_struct_schema_t* schema, void* out, uint64_t* missing) {
+    return cbor_decode_struct_at(map, schema, out, missing, 0);
+}
+/*--------------------------------------------------------------------------*/
+static uint64_t cbor_field_load_unsigned(const uint8_t* member, uint8_t size) {
+    switch (size) {
+    case 1: { uint8_t v;  memcpy(&v, member, sizeof(v)); return v; }
+    case 2: { uint16_t v; memcpy(&v, member, sizeof(v)); return v; }
+    case 4: { uint32_t v; memcpy(&v, member, sizeof(v)); return v; }
+    default: { uint64_t v; memcpy(&v, member, sizeof(v)); return v; }
+    }
+}
+
+static int64_t cbor_field_load_signed(const uint8_t* member, uint8_t size) {
+    switch (size) {
+    case 1: { int8_t v;  memcpy(&v, member, sizeof(v)); return v; }
+    case 2: { int16_t v; memcpy(&v, member, sizeof(v)); return v; }
+    case 4: { int32_t v; memcpy(&v, member, sizeof(v)); return v; }
+    default: { int64_t v; memcpy(&v, member, sizeof(v)); return v; }
+    }
+}
+
+static cbor_encode_result_t cbor_encode_struct_at(const cbor_struct_schema_t* schema, const uint8_t* obj, uint64_t field_mask, slice_t target, int with_header, size_t depth);
+
+static cbor_encode_result_t cbor_encode_field(const cbor_field_t* field, const uint8_t* obj, slice_t target, size_t depth) {
+    const uint8_t* member = obj + field->offset;
+
+    switch (field->kind) {
+    case CBOR_FIELD_INT:
+        return cbor_encode_integer(cbor_field_load_signed(member, field->size), target);
+    case CBOR_FIELD_UINT: {
+        uint64_t value = cbor_field_load_unsigned(member, field->size);
+        if (value <= INT64_MAX) {
+            return cbor_encode_integer((int64_t)value, target);
+        }
+        // Above INT64_MAX, always 8 bytes
+        if (target.len < 9) {
+            return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_BUFFER_OVERFLOW);
+        }
+        target.ptr[0] = (uint8_t)((CBOR_MAJOR_TYPE_UNSIGNED_INTEGER << 5) | 27);
+        uint64_t bytes = htobe64(value);
+        memcpy(&target.ptr[1], &bytes, sizeof(bytes));
+        target.len = 9;
+        return OK(cbor_encode_result_t, target);
+    }
+    case CBOR_FIELD_BOOL:
+        return cbor_encode_simple(*member ? CBOR_SIMPLE_TRUE : CBOR_SIMPLE_FALSE, target);
+    case CBOR_FIELD_FLOAT: {
+        if (field->size == sizeof(double)) {
+            double value;
+            memcpy(&value, member, sizeof(value));
+            return cbor_encode_double(value, target);
+        }
+        float value;
+        memcpy(&value, member, sizeof(value));
+        return cbor_encode_float(value, CBOR_FLOAT_PRECISION_SINGLE, target);
+    }
+    case CBOR_FIELD_BYTES:
+    case CBOR_FIELD_TEXT: {
+        slice_t string;
+        memcpy(&string, member, sizeof(string));
+        return cbor_encode_string(string, field->kind == CBOR_FIELD_BYTES ? CBOR_TYPE_BYTE_STRING : CBOR_TYPE_TEXT_STRING, target);
+    }
+    case CBOR_FIELD_ITEM: {
+        slice_t item;
+        memcpy(&item, member, sizeof(item));
+        if (item.len == 0 || item.ptr == NULL) {
+            return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT);
+        }
+        if (target.len < item.len) {
+            return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_BUFFER_OVERFLOW);
+        }
+        memcpy(target.ptr, item.ptr, item.len);
+        target.len = item.len;
+        return OK(cbor_encode_result_t, target);
+    }
+    case CBOR_FIELD_MAP:
+        return cbor_encode_struct_at(field->nested.schema, member, CBOR_STRUCT_ALL_FIELDS, target, 1, depth + 1);
+    case CBOR_FIELD_KEY_BITMAP:
+        return cbor_encode_key_bitmap(cbor_field_load_unsigned(member, field->size), field->nested.keys.name, target);
+    default:
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT);
+    }
+}
+/*--------------------------------------------------------------------------*/
+static cbor_encode_result_t cbor_encode_struct_at(const cbor_struct_schema_t* schema, const uint8_t* obj, uint64_t field_mask, slice_t target, int with_header, size_t depth) {
+    if (schema == NULL || obj == NULL || target.ptr == NULL) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_NULL_PTR_ERROR);
+    }
+    if (schema->count > CBOR_STRUCT_MAX_FIELDS || depth >= CBOR_MAX_DEPTH) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT);
+    }
+    if (schema->count < CBOR_STRUCT_MAX_FIELDS) {
+        field_mask &= ((uint64_t)1 << schema->count) - 1;
+    }
+
+    slice_t current = target;
+    if (with_header) {
+        size_t count = 0;
+        for (uint64_t bits = field_mask; bits != 0; bits &= bits - 1) {
+            count++;
+        }
+        // At most 64 pairs, so the header takes one or two bytes
+        if (current.len < (count <= 23 ? 1u : 2u)) {
+            return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_BUFFER_OVERFLOW);
+        }
+        uint8_t header_size = cbor_write_len_header(count, CBOR_MAJOR_TYPE_MAP, current);
+        current.ptr += header_size;
+        current.len -= header_size;
+    }
+
+    for (uint64_t bits = field_mask; bits != 0; bits &= bits - 1) {
+        const cbor_field_t* field = &schema->fields[__builtin_ctzll(bits)];
+
+        slice_t key = {.len = field->key_len, .ptr = (uint8_t*)field->key};
+        cbor_encode_result_t encoded = cbor_encode_string(key, CBOR_TYPE_TEXT_STRING, current);
+        if (encoded.is_error) {
+            return encoded;
+        }
+        current.ptr += encoded.ok.len;
+        current.len -= encoded.ok.len;
+
+        encoded = cbor_encode_field(field, obj, current, depth);
+        if (encoded.is_error) {
+            return encoded;
+        }
+        current.ptr += encoded.ok.len;
+        current.len -= encoded.ok.len;
+    }
+
+    return OK(cbor_encode_result_t, ((slice_t) {.len = (size_t)(current.ptr - target.ptr), .ptr = target.ptr}));
+}
+/*--------------------------------------------------------------------------*/
+cbor_encode_result_t cbor_encode_struct(const cbor_struct_schema_t* schema, const void* obj, uint64_t field_mask, slice_t target) {
+    return cbor_encode_struct_at(schema, obj, field_mask, target, 1, 0);
+}
+/*--------------------------------------------------------------------------*/
+cbor_encode_result_t cbor_encode_struct_pairs(const cbor_struct_schema_t* schema, const void* obj, uint64_t field_mask, slice_t target) {
+    return cbor_encode_struct_at(schema, obj, field_mask, target, 0, 0);
+}
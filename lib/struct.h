@@ -0,0 +1,126 @@
+#ifndef CBOR_STRUCT_H
+#define CBOR_STRUCT_H
+
+#include <stddef.h>
+#include "cbor.h"
+#include "keys.h"
+
+/*--------------------------------------------------------------------------*/
+/* Struct Decoding */
+/*--------------------------------------------------------------------------*/
+
+/**
+ * Maps are decoded into C structs by a table of field descriptors instead of
+ * a hand written processor per message. Each descriptor names the key, where
+ * the member is and what it holds. Integer members may be 1, 2, 4 or 8 bytes
+ * wide, values that do not fit are rejected with OUT_OF_RANGE_ERROR.
+ */
+typedef enum {
+    CBOR_FIELD_INT,         // Signed integer member
+    CBOR_FIELD_UINT,        // Unsigned integer member, negative values are out of range
+    CBOR_FIELD_BOOL,        // bool/uint8_t member
+    CBOR_FIELD_FLOAT,       // float or double member
+    CBOR_FIELD_BYTES,       // slice_t member pointing into the document
+    CBOR_FIELD_TEXT,        // slice_t member pointing into the document
+    CBOR_FIELD_ITEM,        // slice_t member holding the encoded item
+    CBOR_FIELD_MAP,         // Nested map, decoded with nested.schema
+    CBOR_FIELD_KEY_BITMAP,  // Array of text strings, see cbor_decode_key_bitmap and cbor_encode_key_bitmap
+} cbor_field_kind_t;
+
+#define CBOR_FIELD_REQUIRED 0x01
+
+#define CBOR_STRUCT_MAX_FIELDS 64
+
+typedef struct cbor_struct_schema_s cbor_struct_schema_t;
+
+typedef struct {
+    const char* key;
+    size_t offset;
+    uint8_t key_len;
+    uint8_t size;       // Member size
+    uint8_t kind;       // cbor_field_kind_t
+    uint8_t flags;      // CBOR_FIELD_*
+    union {
+        const cbor_struct_schema_t* schema;
+        struct {
+            cbor_key_lookup_function lookup;
+            cbor_key_name_function name;    // NULL for fields that are only decoded
+        } keys;
+    } nested;
+} cbor_field_t;
+
+struct cbor_struct_schema_s {
+    const cbor_field_t* fields;
+    size_t count;
+};
+
+#define CBOR_MEMBER_SIZE(type, member) sizeof(((type*)0)->member)
+
+// Field stored under the key str in member
+#define CBOR_FIELD_KEY(str, type, member, field_kind, field_flags) { \
+    .key = (str), .offset = offsetof(type, member), .key_len = sizeof(str) - 1, \
+    .size = CBOR_MEMBER_SIZE(type, member), .kind = (field_kind), .flags = (field_flags) \
+}
+
+// Field whose key is the member name
+#define CBOR_FIELD(type, member, field_kind, field_flags) CBOR_FIELD_KEY(#member, type, member, field_kind, field_flags)
+
+#define CBOR_FIELD_MAP(str, type, member, nested_schema, field_flags) { \
+    .key = (str), .offset = offsetof(type, member), .key_len = sizeof(str) - 1, \
+    .size = CBOR_MEMBER_SIZE(type, member), .kind = CBOR_FIELD_MAP, .flags = (field_flags), \
+    .nested.schema = &(nested_schema) \
+}
+
+// Nested map whose fields are members of the enclosing struct
+#define CBOR_FIELD_INLINE_MAP(str, nested_schema, field_flags) { \
+    .key = (str), .offset = 0, .key_len = sizeof(str) - 1, \
+    .size = 0, .kind = CBOR_FIELD_MAP, .flags = (field_flags), \
+    .nested.schema = &(nested_schema) \
+}
+
+#define CBOR_FIELD_KEY_BITMAP(str, type, member, lookup_function, name_function, field_flags) { \
+    .key = (str), .offset = offsetof(type, member), .key_len = sizeof(str) - 1, \
+    .size = CBOR_MEMBER_SIZE(type, member), .kind = CBOR_FIELD_KEY_BITMAP, .flags = (field_flags), \
+    .nested.keys = {.lookup = (lookup_function), .name = (name_function)} \
+}
+
+#define CBOR_STRUCT_SCHEMA(field_array) { \
+    .fields = (field_array), .count = sizeof(field_array) / sizeof((field_array)[0]) \
+}
+
+/**
+ * Decodes map into out in one pass over the table. Unknown keys, non string
+ * keys and null values are skipped and leave the member untouched. Keys are
+ * looked up starting after the previous match, so documents written in
+ * table order cost one compare per key.
+ *
+ * Required fields that are absent are reported in missing (bit i for
+ * schema->fields[i]); a nested map missing any of its required fields counts
+ * as absent. missing may be NULL. Returns the end of the map,
+ * TYPE_MISMATCH_ERROR or OUT_OF_RANGE_ERROR for values that do not fit
+ * their member, CAPACITY_ERROR for schemas over CBOR_STRUCT_MAX_FIELDS.
+ */
+cbor_process_result_t cbor_decode_struct(cbor_map_t map, const cbor_struct_schema_t* schema, void* out, uint64_t* missing);
+
+/*--------------------------------------------------------------------------*/
+/* Struct Encoding */
+/*--------------------------------------------------------------------------*/
+
+#define CBOR_STRUCT_ALL_FIELDS UINT64_MAX
+
+/**
+ * Encodes the fields of obj selected by field_mask (bit i for
+ * schema->fields[i]) as a map, in table order. Keys and values are written
+ * straight into target, nested maps are encoded with all their fields.
+ * CBOR_FIELD_KEY_BITMAP fields are encoded as arrays of names, those without
+ * a name function give CBOR_ENCODER_NULL_PTR_ERROR.
+ */
+cbor_encode_result_t cbor_encode_struct(const cbor_struct_schema_t* schema, const void* obj, uint64_t field_mask, slice_t target);
+
+/**
+ * Same as cbor_encode_struct without the map header, for callers that append
+ * their own pairs to the map.
+ */
+cbor_encode_result_t cbor_encode_struct_pairs(const cbor_struct_schema_t* schema, const void* obj, uint64_t field_mask, slice_t target);
+
+#endif /* CBOR_STRUCT_H */
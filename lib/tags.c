@@ -0,0 +1,389 @@
+#include "tags.h"
+
+/*--------------------------------------------------------------------------*/
+cbor_tag_registry_init_result_t cbor_tag_registry_init(cbor_tag_registry_t* registry, const cbor_tag_handler_t* handlers, size_t count) {
+    if (registry == NULL || (handlers == NULL && count > 0)) {
+        return ERR(cbor_tag_registry_init_result_t, NULL_PTR_ERROR);
+    }
+    if (count > UINT8_MAX) {
+        return ERR(cbor_tag_registry_init_result_t, CAPACITY_ERROR);
+    }
+
+    memset(registry->direct, 0, sizeof(registry->direct));
+    registry->handlers = handlers;
+    registry->count = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (cbor_tag_find(registry, handlers[i].number) != NULL) {
+            return ERR(cbor_tag_registry_init_result_t, MALFORMED_INPUT_ERROR);
+        }
+        if (handlers[i].number < CBOR_TAG_DIRECT_LIMIT) {
+            registry->direct[handlers[i].number] = (uint8_t)(i + 1);
+        }
+        registry->count = (uint8_t)(i + 1);
+    }
+    return OK(cbor_tag_registry_init_result_t, count);
+}
+/*--------------------------------------------------------------------------*/
+const cbor_tag_handler_t* cbor_tag_find(const cbor_tag_registry_t* registry, uint64_t number) {
+    if (number < CBOR_TAG_DIRECT_LIMIT) {
+        uint8_t slot = registry->direct[number];
+        return slot ? &registry->handlers[slot - 1] : NULL;
+    }
+    for (uint8_t i = 0; i < registry->count; i++) {
+        if (registry->handlers[i].number == number) {
+            return &registry->handlers[i];
+        }
+    }
+    return NULL;
+}
+/*--------------------------------------------------------------------------*/
+cbor_process_result_t cbor_tag_decode(const cbor_tag_registry_t* registry, const cbor_value_t* tag, void* decode_arg) {
+    if (registry == NULL || tag == NULL) {
+        return ERR(cbor_process_result_t, NULL_PTR_ERROR);
+    }
+    if (tag->type != CBOR_TYPE_TAG) {
+        return ERR(cbor_process_result_t, TYPE_MISMATCH_ERROR);
+    }
+
+    const cbor_tag_handler_t* handler = cbor_tag_find(registry, tag->value.tag.number);
+    if (handler == NULL || handler->decode == NULL) {
+        return ERR(cbor_process_result_t, KEY_NOT_FOUND_ERROR);
+    }
+
+    cbor_parse_result_t item = cbor_parse(tag->value.tag.content);
+    if (item.is_error) {
+        return ERR(cbor_process_result_t, item.err);
+    }
+    if (handler->decode(tag->value.tag.number, &item.ok, decode_arg).is_error) {
+        return ERR(cbor_process_result_t, PROCESSOR_ERROR);
+    }
+    return OK(cbor_process_result_t, tag->next);
+}
+/*--------------------------------------------------------------------------*/
+cbor_encode_result_t cbor_tag_encode(const cbor_tag_registry_t* registry, uint64_t number, void* object, slice_t target) {
+    if (registry == NULL || target.ptr == NULL) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_NULL_PTR_ERROR);
+    }
+
+    const cbor_tag_handler_t* handler = cbor_tag_find(registry, number);
+    if (handler == NULL || handler->encode == NULL) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT);
+    }
+
+    cbor_encode_result_t header = cbor_encode_tag(number, target);
+    if (header.is_error) {
+        return header;
+    }
+    custom_encoder_result_t item = handler->encode((slice_t) {
+        .len = target.len - header.ok.len,
+        .ptr = target.ptr + header.ok.len,
+    }, object);
+    if (item.is_error) {
+        return item;
+    }
+
+    target.len = header.ok.len + item.ok.len;
+    return OK(cbor_encode_result_t, target);
+}
+/*--------------------------------------------------------------------------*/
+#define NS_PER_SECOND 1000000000
+
+// Seconds to nanoseconds, OUT_OF_RANGE_ERROR past int64_t
+static cbor_epoch_to_ns_result_t cbor_seconds_to_ns(int64_t seconds, uint32_t fraction_ns) {
+    if (seconds > INT64_MAX / NS_PER_SECOND || seconds < INT64_MIN / NS_PER_SECOND) {
+        return ERR(cbor_epoch_to_ns_result_t, OUT_OF_RANGE_ERROR);
+    }
+    int64_t ns = seconds * NS_PER_SECOND;
+    if (ns > INT64_MAX - (int64_t)fraction_ns) {
+        return ERR(cbor_epoch_to_ns_result_t, OUT_OF_RANGE_ERROR);
+    }
+    return OK(cbor_epoch_to_ns_result_t, ns + (int64_t)fraction_ns);
+}
+/*--------------------------------------------------------------------------*/
+// mantissa * 2^exponent seconds in nanoseconds, truncated toward zero
+static cbor_epoch_to_ns_result_t cbor_binary_to_ns(uint64_t mantissa, int exponent, int negative) {
+    // 53 bit mantissa times 10^9 needs up to 83 bits, kept as hi:lo
+    const uint64_t low_part = (mantissa & 0xFFFFFFFF) * NS_PER_SECOND;
+    const uint64_t high_part = (mantissa >> 32) * NS_PER_SECOND;
+    const uint64_t lo = low_part + (high_part << 32);
+    const uint64_t hi = (high_part >> 32) + (lo < low_part);
+
+    uint64_t ns;
+    if (exponent >= 0) {
+        if (hi != 0 || exponent >= 63 || lo > ((uint64_t)INT64_MAX >> exponent)) {
+            return ERR(cbor_epoch_to_ns_result_t, OUT_OF_RANGE_ERROR);
+        }
+        ns = lo << exponent;
+    }
+    else {
+        const unsigned shift = (unsigned)-exponent;
+        if (shift >= 128) {
+            ns = 0;
+        }
+        else if (shift >= 64) {
+            ns = hi >> (shift - 64);
+        }
+        else {
+            if (hi >> shift) {
+                return ERR(cbor_epoch_to_ns_result_t, OUT_OF_RANGE_ERROR);
+            }
+            ns = (lo >> shift) | (hi << (64 - shift));
+        }
+        if (ns > INT64_MAX) {
+            return ERR(cbor_epoch_to_ns_result_t, OUT_OF_RANGE_ERROR);
+        }
+    }
+    return OK(cbor_epoch_to_ns_result_t, negative ? -(int64_t)ns : (int64_t)ns);
+}
+/*--------------------------------------------------------------------------*/
+// Arguments past INT64_MAX wrap in value.integer for either sign
+static int cbor_integer_fits(const cbor_value_t* item) {
+    return cbor_argument_to_fixed(item->argument) <= INT64_MAX;
+}
+/*--------------------------------------------------------------------------*/
+cbor_epoch_to_ns_result_t cbor_epoch_to_ns(const cbor_value_t* item) {
+    if (item == NULL) {
+        return ERR(cbor_epoch_to_ns_result_t, NULL_PTR_ERROR);
+    }
+    if (item->type == CBOR_TYPE_INTEGER) {
+        if (!cbor_integer_fits(item)) {
+            return ERR(cbor_epoch_to_ns_result_t, OUT_OF_RANGE_ERROR);
+        }
+        return cbor_seconds_to_ns(item->value.integer, 0);
+    }
+    if (item->type != CBOR_TYPE_FLOAT) {
+        return ERR(cbor_epoch_to_ns_result_t, TYPE_MISMATCH_ERROR);
+    }
+
+    // Taken apart bit by bit, there is no FPU on the embedded target
+    if (cbor_value_float_precision(item) == CBOR_FLOAT_PRECISION_DOUBLE) {
+        uint64_t bits;
+        memcpy(&bits, &item->value.float64, sizeof(bits));
+        const int biased = (int)((bits >> 52) & 0x7FF);
+        const uint64_t fraction = bits & 0x000FFFFFFFFFFFFFULL;
+        if (biased == 0x7FF) {
+            return ERR(cbor_epoch_to_ns_result_t, OUT_OF_RANGE_ERROR);
+        }
+        return biased == 0 ? cbor_binary_to_ns(fraction, -1074, (int)(bits >> 63))
+            : cbor_binary_to_ns(fraction | (1ULL << 52), biased - 1075, (int)(bits >> 63));
+    }
+
+    // f16 is stored widened to f32
+    uint32_t bits;
+    memcpy(&bits, &item->value.floating, sizeof(bits));
+    const int biased = (int)((bits >> 23) & 0xFF);
+    const uint32_t fraction = bits & 0x007FFFFF;
+    if (biased == 0xFF) {
+        return ERR(cbor_epoch_to_ns_result_t, OUT_OF_RANGE_ERROR);
+    }
+    return biased == 0 ? cbor_binary_to_ns(fraction, -149, (int)(bits >> 31))
+        : cbor_binary_to_ns(fraction | (1UL << 23), biased - 150, (int)(bits >> 31));
+}
+/*--------------------------------------------------------------------------*/
+// Reads exactly count decimal digits
+static int cbor_read_digits(const uint8_t* text, size_t count, uint32_t* value) {
+    uint32_t result = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (text[i] < '0' || text[i] > '9') {
+            return 0;
+        }
+        result = result * 10 + (uint32_t)(text[i] - '0');
+    }
+    *value = result;
+    return 1;
+}
+/*--------------------------------------------------------------------------*/
+// Days since 1970-01-01 in the proleptic Gregorian calendar
+static int64_t cbor_days_from_civil(int64_t year, uint32_t month, uint32_t day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const uint32_t year_of_era = (uint32_t)(year - era * 400);
+    const uint32_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const uint32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + (int64_t)day_of_era - 719468;
+}
+/*--------------------------------------------------------------------------*/
+cbor_rfc3339_to_ns_result_t cbor_rfc3339_to_ns(slice_t text) {
+    if (text.ptr == NULL) {
+        return ERR(cbor_rfc3339_to_ns_result_t, NULL_PTR_ERROR);
+    }
+
+    // YYYY-MM-DDTHH:MM:SS is fixed, a fraction and the offset follow
+    const uint8_t* t = text.ptr;
+    uint32_t year, month, day, hour, minute, second;
+    if (text.len < 20 || t[4] != '-' || t[7] != '-' || (t[10] != 'T' && t[10] != 't') || t[13] != ':' || t[16] != ':' ||
+        !cbor_read_digits(t, 4, &year) || !cbor_read_digits(t + 5, 2, &month) || !cbor_read_digits(t + 8, 2, &day) ||
+        !cbor_read_digits(t + 11, 2, &hour) || !cbor_read_digits(t + 14, 2, &minute) || !cbor_read_digits(t + 17, 2, &second)) {
+        return ERR(cbor_rfc3339_to_ns_result_t, MALFORMED_INPUT_ERROR);
+    }
+
+    static const uint8_t days_in_month[12] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const int leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    // Second 60 is a leap second and counts as the first second of the next minute
+    if (month < 1 || month > 12 || day < 1 || day > days_in_month[month - 1] || (month == 2 && day == 29 && !leap) ||
+        hour > 23 || minute > 59 || second > 60) {
+        return ERR(cbor_rfc3339_to_ns_result_t, MALFORMED_INPUT_ERROR);
+    }
+
+    size_t pos = 19;
+    uint32_t fraction_ns = 0;
+    if (pos < text.len && t[pos] == '.') {
+        size_t digits = 0;
+        for (pos++; pos < text.len && t[pos] >= '0' && t[pos] <= '9'; pos++, digits++) {
+            if (digits < 9) {
+                fraction_ns = fraction_ns * 10 + (uint32_t)(t[pos] - '0');
+            }
+        }
+        if (digits == 0) {
+            return ERR(cbor_rfc3339_to_ns_result_t, MALFORMED_INPUT_ERROR);
+        }
+        for (; digits < 9; digits++) {
+            fraction_ns *= 10;
+        }
+    }
+
+    int32_t offset = 0;
+    if (pos + 1 == text.len && (t[pos] == 'Z' || t[pos] == 'z')) {
+        pos++;
+    }
+    else if (pos + 6 == text.len && (t[pos] == '+' || t[pos] == '-') && t[pos + 3] == ':') {
+        uint32_t offset_hour, offset_minute;
+        if (!cbor_read_digits(t + pos + 1, 2, &offset_hour) || !cbor_read_digits(t + pos + 4, 2, &offset_minute) ||
+            offset_hour > 23 || offset_minute > 59) {
+            return ERR(cbor_rfc3339_to_ns_result_t, MALFORMED_INPUT_ERROR);
+        }
+        offset = (int32_t)(offset_hour * 3600 + offset_minute * 60);
+        offset = t[pos] == '-' ? -offset : offset;
+    }
+    else {
+        return ERR(cbor_rfc3339_to_ns_result_t, MALFORMED_INPUT_ERROR);
+    }
+
+    const int64_t seconds = cbor_days_from_civil(year, month, day) * 86400 +
+        (int64_t)(hour * 3600 + minute * 60 + second) - offset;
+    return cbor_seconds_to_ns(seconds, fraction_ns);
+}
+/*--------------------------------------------------------------------------*/
+// Integer or a bignum of up to 8 significant bytes
+static cbor_decimal_to_fixed_result_t cbor_mantissa(const cbor_value_t* item) {
+    if (item->type == CBOR_TYPE_INTEGER) {
+        if (!cbor_integer_fits(item)) {
+            return ERR(cbor_decimal_to_fixed_result_t, OUT_OF_RANGE_ERROR);
+        }
+        return OK(cbor_decimal_to_fixed_result_t, item->value.integer);
+    }
+    if (item->type != CBOR_TYPE_TAG ||
+        (item->value.tag.number != CBOR_TAG_POSITIVE_BIGNUM && item->value.tag.number != CBOR_TAG_NEGATIVE_BIGNUM)) {
+        return ERR(cbor_decimal_to_fixed_result_t, TYPE_MISMATCH_ERROR);
+    }
+
+    cbor_parse_result_t bytes = cbor_parse(item->value.tag.content);
+    if (bytes.is_error) {
+        return ERR(cbor_decimal_to_fixed_result_t, bytes.err);
+    }
+    // Indefinite length bignums have no single slice to read
+    if (bytes.ok.type != CBOR_TYPE_BYTE_STRING || bytes.ok.next == NULL) {
+        return ERR(cbor_decimal_to_fixed_result_t, TYPE_MISMATCH_ERROR);
+    }
+    uint64_t n = 0;
+    for (size_t i = 0; i < bytes.ok.value.bytes.len; i++) {
+        if (n >> 56) {
+            return ERR(cbor_decimal_to_fixed_result_t, OUT_OF_RANGE_ERROR);
+        }
+        n = (n << 8) | bytes.ok.value.bytes.ptr[i];
+    }
+    if (n > INT64_MAX) {
+        return ERR(cbor_decimal_to_fixed_result_t, OUT_OF_RANGE_ERROR);
+    }
+    // Tag 3 holds -1 - n
+    return OK(cbor_decimal_to_fixed_result_t, item->value.tag.number == CBOR_TAG_POSITIVE_BIGNUM ? (int64_t)n : -1 - (int64_t)n);
+}
+/*--------------------------------------------------------------------------*/
+cbor_decimal_to_fixed_result_t cbor_decimal_to_fixed(const cbor_value_t* item, uint8_t scale) {
+    if (item == NULL) {
+        return ERR(cbor_decimal_to_fixed_result_t, NULL_PTR_ERROR);
+    }
+    if (item->type != CBOR_TYPE_ARRAY || item->value.array.length != 2) {
+        return ERR(cbor_decimal_to_fixed_result_t, TYPE_MISMATCH_ERROR);
+    }
+
+    cbor_parse_result_t parts[2];
+    for (size_t i = 0; i < 2; i++) {
+        cbor_array_get_result_t element = cbor_array_get(item->value.array, i);
+        if (element.is_error) {
+            return ERR(cbor_decimal_to_fixed_result_t, element.err);
+        }
+        parts[i] = cbor_parse(element.ok);
+        if (parts[i].is_error) {
+            return ERR(cbor_decimal_to_fixed_result_t, parts[i].err);
+        }
+    }
+    if (parts[0].ok.type != CBOR_TYPE_INTEGER) {
+        return ERR(cbor_decimal_to_fixed_result_t, TYPE_MISMATCH_ERROR);
+    }
+    if (!cbor_integer_fits(&parts[0].ok)) {
+        return ERR(cbor_decimal_to_fixed_result_t, OUT_OF_RANGE_ERROR);
+    }
+    cbor_decimal_to_fixed_result_t mantissa = cbor_mantissa(&parts[1].ok);
+    if (mantissa.is_error || mantissa.ok == 0) {
+        return mantissa;
+    }
+
+    static const int64_t powers_of_ten[19] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+        10000000000, 100000000000, 1000000000000, 10000000000000, 100000000000000,
+        1000000000000000, 10000000000000000, 100000000000000000, 1000000000000000000,
+    };
+
+    const int64_t exponent = parts[0].ok.value.integer;
+    const int64_t m = mantissa.ok;
+    if (exponent > 18 - (int64_t)scale) {
+        return ERR(cbor_decimal_to_fixed_result_t, OUT_OF_RANGE_ERROR);
+    }
+    // |m| is below 10^19, so every digit is dropped
+    if (exponent < -18 - (int64_t)scale) {
+        return OK(cbor_decimal_to_fixed_result_t, 0);
+    }
+
+    const int64_t shift = exponent + scale;
+    if (shift < 0) {
+        return OK(cbor_decimal_to_fixed_result_t, m / powers_of_ten[-shift]);
+    }
+    const int64_t factor = powers_of_ten[shift];
+    if (m > INT64_MAX / factor || m < INT64_MIN / factor) {
+        return ERR(cbor_decimal_to_fixed_result_t, OUT_OF_RANGE_ERROR);
+    }
+    return OK(cbor_decimal_to_fixed_result_t, m * factor);
+}
+/*--------------------------------------------------------------------------*/
+cbor_custom_processor_result_t cbor_tag_decode_time(uint64_t number, const cbor_value_t* item, void* decode_arg) {
+    cbor_epoch_to_ns_result_t ns;
+    if (number == CBOR_TAG_DATETIME_STRING) {
+        if (item->type != CBOR_TYPE_TEXT_STRING || item->next == NULL) {
+            return CUSTOM_PROCESSOR_ERR(CBOR_CUSTOM_PROCESSOR_ERROR_PARSER);
+        }
+        ns = cbor_rfc3339_to_ns(item->value.bytes);
+    }
+    else {
+        ns = cbor_epoch_to_ns(item);
+    }
+    if (ns.is_error || decode_arg == NULL) {
+        return CUSTOM_PROCESSOR_ERR(CBOR_CUSTOM_PROCESSOR_ERROR_PARSER);
+    }
+    *(int64_t*)decode_arg = ns.ok;
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
+/*--------------------------------------------------------------------------*/
+cbor_custom_processor_result_t cbor_tag_decode_decimal(uint64_t number, const cbor_value_t* item, void* decode_arg) {
+    (void)number;
+    cbor_fixed_t* fixed = decode_arg;
+    if (fixed == NULL) {
+        return CUSTOM_PROCESSOR_ERR(CBOR_CUSTOM_PROCESSOR_ERROR_PARSER);
+    }
+    cbor_decimal_to_fixed_result_t value = cbor_decimal_to_fixed(item, fixed->scale);
+    if (value.is_error) {
+        return CUSTOM_PROCESSOR_ERR(CBOR_CUSTOM_PROCESSOR_ERROR_PARSER);
+    }
+    fixed->value = value.ok;
+    return CBOR_CUSTOM_PROCESSOR_OK();
+}
@@ -0,0 +1,130 @@
+#ifndef CBOR_TAGS_H
+#define CBOR_TAGS_H
+
+#include "cbor.h"
+
+/*--------------------------------------------------------------------------*/
+/* Tags */
+/*--------------------------------------------------------------------------*/
+
+// Well-known tag numbers, typed arrays (64 to 87) are in typed.h
+enum {
+    CBOR_TAG_DATETIME_STRING    = 0,    // RFC 3339 text string
+    CBOR_TAG_EPOCH_DATETIME     = 1,    // Seconds since 1970-01-01T00:00Z
+    CBOR_TAG_POSITIVE_BIGNUM    = 2,
+    CBOR_TAG_NEGATIVE_BIGNUM    = 3,
+    CBOR_TAG_DECIMAL_FRACTION   = 4,    // [exponent, mantissa], base 10
+    CBOR_TAG_BIGFLOAT           = 5,    // [exponent, mantissa], base 2
+    CBOR_TAG_EXPECT_BASE64URL   = 21,
+    CBOR_TAG_EXPECT_BASE64      = 22,
+    CBOR_TAG_EXPECT_BASE16      = 23,
+    CBOR_TAG_ENCODED_CBOR       = 24,
+    CBOR_TAG_URI                = 32,
+    CBOR_TAG_BASE64URL          = 33,
+    CBOR_TAG_BASE64             = 34,
+    CBOR_TAG_MIME_MESSAGE       = 36,
+    CBOR_TAG_SELF_DESCRIBED     = 55799
+};
+
+// Tags below this are looked up with a single table load
+#ifndef CBOR_TAG_DIRECT_LIMIT
+#define CBOR_TAG_DIRECT_LIMIT 64
+#endif
+
+/* Called with the parsed item enclosed by the tag */
+typedef cbor_custom_processor_result_t (*tag_decoder_function)(uint64_t number, const cbor_value_t* item, void* decode_arg);
+
+/**
+ * Hooks for one tag number. encode writes the enclosed item for the object
+ * passed to cbor_tag_encode, the tag header is written before it is called.
+ * Either hook may be NULL.
+ */
+typedef struct {
+    uint64_t number;
+    tag_decoder_function decode;
+    custom_encoder_function_t encode;
+} cbor_tag_handler_t;
+
+/**
+ * Lookup table over a caller provided array of handlers, which has to
+ * outlive the registry. Numbers of CBOR_TAG_DIRECT_LIMIT and above, such
+ * as CBOR_TAG_SELF_DESCRIBED, are found by scanning the handlers.
+ */
+typedef struct {
+    const cbor_tag_handler_t* handlers;
+    uint8_t count;
+    uint8_t direct[CBOR_TAG_DIRECT_LIMIT];  // 1 + index into handlers, 0 if none
+} cbor_tag_registry_t;
+
+/**
+ * Indexes count handlers, returns count. Returns CAPACITY_ERROR for more
+ * than 255 handlers and MALFORMED_INPUT_ERROR if a number appears twice.
+ */
+FN_RESULT(size_t, cbor_parser_error_t,
+cbor_tag_registry_init, cbor_tag_registry_t* registry, const cbor_tag_handler_t* handlers, size_t count);
+
+/* Handler for a tag number, NULL if none is registered */
+const cbor_tag_handler_t* cbor_tag_find(const cbor_tag_registry_t* registry, uint64_t number);
+
+/**
+ * Calls the decoder registered for a parsed tag with its enclosed item.
+ * Returns the end of the tagged item, KEY_NOT_FOUND_ERROR if no decoder is
+ * registered for the number and PROCESSOR_ERROR if the decoder fails.
+ */
+cbor_process_result_t cbor_tag_decode(const cbor_tag_registry_t* registry, const cbor_value_t* tag, void* decode_arg);
+
+/**
+ * Writes the tag header and lets the registered encoder write the item.
+ * Returns CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT if no encoder is
+ * registered for the number.
+ */
+cbor_encode_result_t cbor_tag_encode(const cbor_tag_registry_t* registry, uint64_t number, void* object, slice_t target);
+
+/*--------------------------------------------------------------------------*/
+/* Time and Decimal Tags */
+/*--------------------------------------------------------------------------*/
+
+DEFINE_RESULT_TYPE(int64_t, cbor_parser_error_t);
+
+/**
+ * Content of tag 1 (integer or float seconds) as nanoseconds since
+ * 1970-01-01T00:00Z. Floats are converted from their bits with integer
+ * arithmetic and truncated to whole nanoseconds. Returns
+ * OUT_OF_RANGE_ERROR outside of the years 1677 to 2262 and for NaN and
+ * infinities, TYPE_MISMATCH_ERROR for other types.
+ */
+FN_RESULT(int64_t, cbor_parser_error_t,
+cbor_epoch_to_ns, const cbor_value_t* item);
+
+/**
+ * RFC 3339 date-time (content of tag 0) such as "2013-03-21T20:04:00Z" or
+ * "2013-03-21T22:04:00.5+02:00" as nanoseconds since 1970-01-01T00:00Z.
+ * Fractions beyond nanoseconds are truncated. Returns MALFORMED_INPUT_ERROR
+ * if the text does not follow the format.
+ */
+FN_RESULT(int64_t, cbor_parser_error_t,
+cbor_rfc3339_to_ns, slice_t text);
+
+/**
+ * Content of tag 4, [exponent, mantissa], as a fixed-point integer with
+ * scale decimal places: mantissa * 10^(exponent + scale). The mantissa may
+ * be an integer or a definite length bignum (tags 2 and 3) that fits in
+ * 64 bits. Digits
+ * beyond the scale are truncated toward zero, no floating point is used.
+ * Returns OUT_OF_RANGE_ERROR if the result does not fit in int64_t.
+ */
+FN_RESULT(int64_t, cbor_parser_error_t,
+cbor_decimal_to_fixed, const cbor_value_t* item, uint8_t scale);
+
+typedef struct {
+    int64_t value;      // Decoded value times 10^scale
+    uint8_t scale;      // Decimal places, set by the caller
+} cbor_fixed_t;
+
+/* Decoders for the registry. decode_arg is an int64_t* for nanoseconds */
+cbor_custom_processor_result_t cbor_tag_decode_time(uint64_t number, const cbor_value_t* item, void* decode_arg);
+
+/* decode_arg is a cbor_fixed_t* with its scale set */
+cbor_custom_processor_result_t cbor_tag_decode_decimal(uint64_t number, const cbor_value_t* item, void* decode_arg);
+
+#endif /* CBOR_TAGS_H */
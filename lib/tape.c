@@ -0,0 +1,175 @@
+#include "tape.h"
+
+/*--------------------------------------------------------------------------*/
+cbor_process_result_t cbor_index_build(slice_t buf, cbor_tape_t* tape) {
+    if (buf.ptr == NULL || tape == NULL || tape->entries == NULL) {
+        return ERR(cbor_process_result_t, NULL_PTR_ERROR);
+    }
+    if (buf.len == 0) {
+        return ERR(cbor_process_result_t, EMPTY_BUFFER_ERROR);
+    }
+    if (buf.len > UINT32_MAX) {
+        return ERR(cbor_process_result_t, CAPACITY_ERROR);
+    }
+
+    tape->doc = buf;
+    tape->count = 0;
+
+    // Items left and tape index of each open container, SIZE_MAX for indefinite length ones.
+    // Indefinite maps track whether a value is still missing in odd.
+    struct {
+        size_t remaining;
+        uint32_t index;
+        uint8_t odd;
+    } stack[CBOR_MAX_DEPTH];
+    size_t depth = 0;
+
+    uint8_t* current = buf.ptr;
+    uint8_t* const end = buf.ptr + buf.len;
+
+    for (;;) {
+        if (current >= end) {
+            return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+
+        const cbor_initial_byte_t ib = cbor_initial_byte_table[*current];
+
+        if (ib.flags & CBOR_IB_BREAK) {
+            if (depth == 0 || stack[depth - 1].remaining != SIZE_MAX || stack[depth - 1].odd) {
+                return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+            }
+            current++;
+            depth--;
+            tape->entries[stack[depth].index].next = tape->count;
+        }
+        else {
+            if (ib.flags & CBOR_IB_RESERVED) {
+                return ERR(cbor_process_result_t, MALFORMED_INPUT_ERROR);
+            }
+            size_t available = (size_t)(end - current);
+            if (ib.size >= available) {
+                return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+            }
+            if (tape->count == tape->capacity) {
+                return ERR(cbor_process_result_t, CAPACITY_ERROR);
+            }
+
+            uint32_t index = tape->count++;
+            cbor_tape_entry_t* entry = &tape->entries[index];
+            entry->offset = (uint32_t)(current - buf.ptr);
+            entry->next = index + 1;
+            entry->argument = (ib.flags & CBOR_IB_INDEFINITE)
+                ? UINT64_MAX
+                : cbor_argument_to_fixed(cbor_read_argument(ib, current));
+
+            int opens = 0;
+            switch (ib.major) {
+            case CBOR_MAJOR_TYPE_BYTE_STRING:
+            case CBOR_MAJOR_TYPE_TEXT_STRING:
+                if (ib.flags & CBOR_IB_INDEFINITE) {
+                    // The chunks are not indexed, the string is a single entry
+                    cbor_process_result_t string_end = cbor_skip((slice_t) {.len = available, .ptr = current});
+                    if (string_end.is_error) {
+                        return string_end;
+                    }
+                    current = string_end.ok;
+                    break;
+                }
+                if (entry->argument > available - 1 - ib.size) {
+                    return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                }
+                current += 1 + ib.size + entry->argument;
+                break;
+            case CBOR_MAJOR_TYPE_ARRAY:
+            case CBOR_MAJOR_TYPE_MAP:
+                current += 1 + ib.size;
+                opens = entry->argument != 0;
+                break;
+            case CBOR_MAJOR_TYPE_TAG:
+                current += 1 + ib.size;
+                opens = 1;
+                break;
+            default:
+                current += 1 + ib.size;
+                break;
+            }
+
+            if (opens) {
+                if (depth == CBOR_MAX_DEPTH) {
+                    return ERR(cbor_process_result_t, DEPTH_LIMIT_ERROR);
+                }
+                size_t remaining = SIZE_MAX;
+                if (ib.major == CBOR_MAJOR_TYPE_TAG) {
+                    remaining = 1;
+                }
+                else if (!(ib.flags & CBOR_IB_INDEFINITE)) {
+                    // Every item takes at least one byte, so larger counts cannot fit
+                    size_t left = (size_t)(end - current);
+                    if (entry->argument > left || (ib.major == CBOR_MAJOR_TYPE_MAP && entry->argument > left / 2)) {
+                        return ERR(cbor_process_result_t, BUFFER_OVERFLOW_ERROR);
+                    }
+                    remaining = ib.major == CBOR_MAJOR_TYPE_MAP ? (size_t)entry->argument * 2 : (size_t)entry->argument;
+                }
+                stack[depth].remaining = remaining;
+                stack[depth].index = index;
+                stack[depth].odd = 0;
+                depth++;
+                continue;
+            }
+        }
+
+        // An item just ended, close every definite container it completes
+        while (depth > 0 && stack[depth - 1].remaining != SIZE_MAX) {
+            if (--stack[depth - 1].remaining > 0) {
+                break;
+            }
+            depth--;
+            tape->entries[stack[depth].index].next = tape->count;
+        }
+        if (depth > 0 && stack[depth - 1].remaining == SIZE_MAX &&
+            cbor_tape_major(tape, stack[depth - 1].index) == CBOR_MAJOR_TYPE_MAP) {
+            stack[depth - 1].odd ^= 1;
+        }
+
+        if (depth == 0) {
+            return OK(cbor_process_result_t, current);
+        }
+    }
+}
+/*--------------------------------------------------------------------------*/
+uint32_t cbor_tape_array_get(const cbor_tape_t* tape, uint32_t index, uint64_t i) {
+    if (index >= tape->count || cbor_tape_major(tape, index) != CBOR_MAJOR_TYPE_ARRAY) {
+        return CBOR_TAPE_NONE;
+    }
+
+    uint32_t end = tape->entries[index].next;
+    uint32_t element = index + 1;
+    for (; element < end && i > 0; i--) {
+        element = tape->entries[element].next;
+    }
+    return element < end ? element : CBOR_TAPE_NONE;
+}
+/*--------------------------------------------------------------------------*/
+uint32_t cbor_tape_map_get(const cbor_tape_t* tape, uint32_t index, slice_t key) {
+    if (index >= tape->count || cbor_tape_major(tape, index) != CBOR_MAJOR_TYPE_MAP) {
+        return CBOR_TAPE_NONE;
+    }
+
+    uint32_t end = tape->entries[index].next;
+    uint32_t k = index + 1;
+    while (k < end) {
+        const cbor_tape_entry_t* entry = &tape->entries[k];
+        uint32_t value = entry->next;
+        if (value >= end) {
+            break;
+        }
+
+        const uint8_t* header = tape->doc.ptr + entry->offset;
+        if (cbor_get_major_type(header) == CBOR_MAJOR_TYPE_TEXT_STRING && entry->argument == key.len &&
+            memcmp(header + 1 + cbor_initial_byte_table[*header].size, key.ptr, key.len) == 0) {
+            return value;
+        }
+        k = tape->entries[value].next;
+    }
+    return CBOR_TAPE_NONE;
+}
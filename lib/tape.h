@@ -0,0 +1,89 @@
+#ifndef CBOR_TAPE_H
+#define CBOR_TAPE_H
+
+#include "cbor.h"
+
+/*--------------------------------------------------------------------------*/
+/* Structural Index */
+/*--------------------------------------------------------------------------*/
+
+#define CBOR_TAPE_NONE UINT32_MAX
+
+/**
+ * One item of an indexed document, in document order.
+ * Children of arrays, maps and tags directly follow their parent, so the
+ * first child of entry i is entry i + 1 and its next sibling is
+ * entries[i].next. Indefinite length strings are a single entry.
+ *
+ * The item type is not duplicated here, it is the initial byte at offset.
+ *
+ * Size: 16 bytes
+ */
+typedef struct {
+    uint64_t argument;  // Integer value, string length or container item count
+    uint32_t offset;    // Byte offset of the initial byte in the document
+    uint32_t next;      // Index of the entry following this item and its children
+} cbor_tape_entry_t;
+
+typedef struct {
+    slice_t doc;
+    cbor_tape_entry_t* entries;
+    uint32_t capacity;
+    uint32_t count;
+} cbor_tape_t;
+
+#define CBOR_TAPE(storage) \
+    ((cbor_tape_t) { \
+        .entries = (storage), \
+        .capacity = sizeof(storage) / sizeof((storage)[0]) \
+    })
+
+/**
+ * Indexes the item at the start of buf into the tape in a single pass.
+ * Returns the end of the indexed item, or CAPACITY_ERROR if the tape
+ * storage is too small.
+ */
+cbor_process_result_t cbor_index_build(slice_t buf, cbor_tape_t* tape);
+
+/* Index of the i-th element of the array at entry index, CBOR_TAPE_NONE if out of range */
+uint32_t cbor_tape_array_get(const cbor_tape_t* tape, uint32_t index, uint64_t i);
+
+/* Index of the value stored under the text key in the map at entry index, CBOR_TAPE_NONE if missing */
+uint32_t cbor_tape_map_get(const cbor_tape_t* tape, uint32_t index, slice_t key);
+
+/* Accessors, an index past the tape (such as CBOR_TAPE_NONE) gives CBOR_MAJOR_TYPE_ERROR or CBOR_TAPE_NONE */
+static inline cbor_major_type_t cbor_tape_major(const cbor_tape_t* tape, uint32_t index) {
+    if (index >= tape->count) {
+        return CBOR_MAJOR_TYPE_ERROR;
+    }
+    return cbor_get_major_type(tape->doc.ptr + tape->entries[index].offset);
+}
+
+static inline uint32_t cbor_tape_next(const cbor_tape_t* tape, uint32_t index) {
+    return index < tape->count ? tape->entries[index].next : CBOR_TAPE_NONE;
+}
+
+static inline uint32_t cbor_tape_child(const cbor_tape_t* tape, uint32_t index) {
+    return index < tape->count && tape->entries[index].next > index + 1 ? index + 1 : CBOR_TAPE_NONE;
+}
+
+/**
+ * Parses the item at entry index, without re-walking anything before it.
+ * Returns KEY_NOT_FOUND_ERROR for an index past the tape, so the result of
+ * a failed cbor_tape_map_get can be passed in directly.
+ */
+static inline cbor_parse_result_t cbor_tape_value(const cbor_tape_t* tape, uint32_t index) {
+    if (tape == NULL || tape->doc.ptr == NULL) {
+        return ERR(cbor_parse_result_t, NULL_PTR_ERROR);
+    }
+    if (index >= tape->count) {
+        return ERR(cbor_parse_result_t, KEY_NOT_FOUND_ERROR);
+    }
+    uint32_t offset = tape->entries[index].offset;
+    return cbor_parse((slice_t) {
+        .len = tape->doc.len - offset,
+        .ptr = tape->doc.ptr + offset,
+    });
+}
+
+#endif /* CBOR_TAPE_H */
@@ -0,0 +1,306 @@
+#include "typed.h"
+#include "compat/float.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*--------------------------------------------------------------------------*/
+cbor_typed_array_parse_result_t cbor_typed_array_parse(slice_t buf) {
+    if (buf.ptr == NULL) {
+        return ERR(cbor_typed_array_parse_result_t, NULL_PTR_ERROR);
+    }
+    if (buf.len == 0) {
+        return ERR(cbor_typed_array_parse_result_t, EMPTY_BUFFER_ERROR);
+    }
+
+    const cbor_initial_byte_t ib = cbor_initial_byte_table[buf.ptr[0]];
+    if (ib.major != CBOR_MAJOR_TYPE_TAG) {
+        return ERR(cbor_typed_array_parse_result_t, TYPE_MISMATCH_ERROR);
+    }
+    if ((ib.flags & CBOR_IB_RESERVED) || ib.size >= buf.len) {
+        return ERR(cbor_typed_array_parse_result_t, MALFORMED_INPUT_ERROR);
+    }
+    const uint64_t tag = cbor_argument_to_fixed(cbor_read_argument(ib, buf.ptr));
+    const uint8_t element_size = cbor_typed_tag_element_size(tag);
+    if (element_size == 0) {
+        return ERR(cbor_typed_array_parse_result_t, TYPE_MISMATCH_ERROR);
+    }
+
+    size_t offset = 1 + ib.size;
+    if (offset >= buf.len) {
+        return ERR(cbor_typed_array_parse_result_t, BUFFER_OVERFLOW_ERROR);
+    }
+    const cbor_initial_byte_t content = cbor_initial_byte_table[buf.ptr[offset]];
+    if (content.major != CBOR_MAJOR_TYPE_BYTE_STRING) {
+        return ERR(cbor_typed_array_parse_result_t, TYPE_MISMATCH_ERROR);
+    }
+    if (content.flags & CBOR_IB_RESERVED) {
+        return ERR(cbor_typed_array_parse_result_t, MALFORMED_INPUT_ERROR);
+    }
+    cbor_typed_array_t array = {
+        .tag = (uint8_t)tag,
+        .element_size = element_size,
+    };
+    uint64_t len = 0;
+    if (content.flags & CBOR_IB_INDEFINITE) {
+        // The chunks are joined when copying, there is no single view to return
+        cbor_process_result_t end = cbor_skip((slice_t) {.len = buf.len - offset, .ptr = buf.ptr + offset});
+        if (end.is_error) {
+            return ERR(cbor_typed_array_parse_result_t, end.err);
+        }
+        array.chunks = buf.ptr + offset + 1;
+        for (uint8_t* chunk = array.chunks; chunk < end.ok - 1; ) {
+            const cbor_initial_byte_t chunk_ib = cbor_initial_byte_table[*chunk];
+            const uint64_t chunk_len = cbor_argument_to_fixed(cbor_read_argument(chunk_ib, chunk));
+            len += chunk_len;
+            chunk += 1 + chunk_ib.size + chunk_len;
+        }
+        array.data.len = (size_t)len;
+        array.next = end.ok;
+    }
+    else {
+        if (content.size >= buf.len - offset) {
+            return ERR(cbor_typed_array_parse_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+        len = cbor_argument_to_fixed(cbor_read_argument(content, buf.ptr + offset));
+        offset += 1 + content.size;
+        if (len > buf.len - offset) {
+            return ERR(cbor_typed_array_parse_result_t, BUFFER_OVERFLOW_ERROR);
+        }
+        array.data = (slice_t) {.len = (size_t)len, .ptr = buf.ptr + offset};
+        array.next = buf.ptr + offset + len;
+    }
+    if (tag & CBOR_TYPED_TAG_FLOAT) {
+        array.kind = CBOR_TYPED_FLOAT;
+    }
+    else {
+        array.kind = (tag & CBOR_TYPED_TAG_SIGNED) ? CBOR_TYPED_SINT : CBOR_TYPED_UINT;
+    }
+    if (array.element_size == 1) {
+        array.clamped = (tag & CBOR_TYPED_TAG_LITTLE_ENDIAN) != 0;
+    }
+    else {
+        array.little_endian = (tag & CBOR_TYPED_TAG_LITTLE_ENDIAN) != 0;
+    }
+
+    if (len % array.element_size != 0) {
+        return ERR(cbor_typed_array_parse_result_t, MALFORMED_INPUT_ERROR);
+    }
+    array.count = (size_t)len / array.element_size;
+    return OK(cbor_typed_array_parse_result_t, array);
+}
+/*--------------------------------------------------------------------------*/
+// Copies count elements of size bytes, reversing the bytes of each one
+static void cbor_swap_copy(uint8_t* out, const uint8_t* in, size_t count, uint8_t size) {
+    size_t i = 0;
+#if defined(__SSSE3__)
+    // 16 bytes per shuffle, whatever the element size
+    const __m128i reverse = size == 2 ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+        : size == 4 ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+        : _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const size_t step = 16 / size;
+    for (; i + step <= count; i += step) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(in + i * size));
+        _mm_storeu_si128((__m128i*)(void*)(out + i * size), _mm_shuffle_epi8(v, reverse));
+    }
+#elif defined(__SSE2__)
+    // Without a byte shuffle only 16 bit swaps vectorize well
+    if (size == 2) {
+        for (; i + 8 <= count; i += 8) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(in + i * 2));
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            _mm_storeu_si128((__m128i*)(void*)(out + i * 2), v);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        const uint8_t* src = in + i * size;
+        uint8_t* dst = out + i * size;
+        switch (size) {
+        case 2: {
+            uint16_t v;
+            memcpy(&v, src, sizeof(v));
+            v = __builtin_bswap16(v);
+            memcpy(dst, &v, sizeof(v));
+            break;
+        }
+        case 4: {
+            uint32_t v;
+            memcpy(&v, src, sizeof(v));
+            v = __builtin_bswap32(v);
+            memcpy(dst, &v, sizeof(v));
+            break;
+        }
+        default: {
+            uint64_t v;
+            memcpy(&v, src, sizeof(v));
+            v = __builtin_bswap64(v);
+            memcpy(dst, &v, sizeof(v));
+            break;
+        }
+        }
+    }
+}
+/*--------------------------------------------------------------------------*/
+// Hands out an indefinite length payload a chunk at a time, as parts that
+// hold whole elements. An element split between chunks is gathered into
+// scratch and handed out alone.
+typedef struct {
+    uint8_t* current;       // Next payload byte
+    size_t left;            // Bytes of the current chunk from there
+    uint8_t scratch[16];
+} cbor_typed_parts_t;
+
+// Moves to the next chunk with data, only called while elements remain
+static void cbor_typed_parts_fill(cbor_typed_parts_t* parts) {
+    while (parts->left == 0) {
+        const cbor_initial_byte_t ib = cbor_initial_byte_table[*parts->current];
+        parts->left = (size_t)cbor_argument_to_fixed(cbor_read_argument(ib, parts->current));
+        parts->current += 1 + ib.size;
+    }
+}
+
+static void cbor_typed_parts_next(cbor_typed_parts_t* parts, const cbor_typed_array_t* array, cbor_typed_array_t* part) {
+    const uint8_t size = array->element_size;
+    *part = *array;
+    part->chunks = NULL;
+
+    cbor_typed_parts_fill(parts);
+    if (parts->left >= size) {
+        part->count = parts->left / size;
+        part->data = (slice_t) {.len = part->count * size, .ptr = parts->current};
+        parts->current += part->data.len;
+        parts->left -= part->data.len;
+        return;
+    }
+
+    for (uint8_t i = 0; i < size; i++) {
+        cbor_typed_parts_fill(parts);
+        parts->scratch[i] = *parts->current++;
+        parts->left--;
+    }
+    part->count = 1;
+    part->data = (slice_t) {.len = size, .ptr = parts->scratch};
+}
+/*--------------------------------------------------------------------------*/
+cbor_typed_array_copy_result_t cbor_typed_array_copy(const cbor_typed_array_t* array, void* out, size_t capacity) {
+    if (array == NULL || (out == NULL && array->count > 0)) {
+        return ERR(cbor_typed_array_copy_result_t, NULL_PTR_ERROR);
+    }
+    if (array->element_size > 8) {
+        return ERR(cbor_typed_array_copy_result_t, TYPE_MISMATCH_ERROR);
+    }
+    if (array->count > capacity) {
+        return ERR(cbor_typed_array_copy_result_t, CAPACITY_ERROR);
+    }
+
+    if (array->chunks != NULL) {
+        cbor_typed_parts_t parts = {.current = array->chunks};
+        for (size_t done = 0; done < array->count; ) {
+            cbor_typed_array_t part;
+            cbor_typed_parts_next(&parts, array, &part);
+            cbor_typed_array_copy(&part, (uint8_t*)out + done * array->element_size, part.count);
+            done += part.count;
+        }
+        return OK(cbor_typed_array_copy_result_t, array->count);
+    }
+
+    if (cbor_typed_array_is_native(array)) {
+        if (array->data.len > 0) {
+            memcpy(out, array->data.ptr, array->data.len);
+        }
+    }
+    else {
+        cbor_swap_copy(out, array->data.ptr, array->count, array->element_size);
+    }
+    return OK(cbor_typed_array_copy_result_t, array->count);
+}
+/*--------------------------------------------------------------------------*/
+cbor_typed_array_to_float_result_t cbor_typed_array_to_float(const cbor_typed_array_t* array, float* out, size_t capacity) {
+    if (array == NULL || (out == NULL && array->count > 0)) {
+        return ERR(cbor_typed_array_to_float_result_t, NULL_PTR_ERROR);
+    }
+    if (array->kind != CBOR_TYPED_FLOAT || array->element_size > 8) {
+        return ERR(cbor_typed_array_to_float_result_t, TYPE_MISMATCH_ERROR);
+    }
+    if (array->count > capacity) {
+        return ERR(cbor_typed_array_to_float_result_t, CAPACITY_ERROR);
+    }
+
+    if (array->chunks != NULL) {
+        cbor_typed_parts_t parts = {.current = array->chunks};
+        for (size_t done = 0; done < array->count; ) {
+            cbor_typed_array_t part;
+            cbor_typed_parts_next(&parts, array, &part);
+            cbor_typed_array_to_float(&part, out + done, part.count);
+            done += part.count;
+        }
+        return OK(cbor_typed_array_to_float_result_t, array->count);
+    }
+
+    const uint8_t* in = array->data.ptr;
+    switch (array->element_size) {
+    case 2:
+        if (!array->little_endian) {
+            half_be_to_float_n(out, in, array->count);
+        }
+        else {
+            for (size_t i = 0; i < array->count; i++) {
+                out[i] = half_to_float((uint16_t)(in[2 * i] | ((uint16_t)in[2 * i + 1] << 8)));
+            }
+        }
+        break;
+    case 4:
+        cbor_typed_array_copy(array, out, capacity);
+        break;
+    default:
+        for (size_t i = 0; i < array->count; i++) {
+            uint64_t bits;
+            double d;
+            memcpy(&bits, in + 8 * i, sizeof(bits));
+            bits = array->little_endian ? le64toh(bits) : be64toh(bits);
+            memcpy(&d, &bits, sizeof(d));
+            out[i] = (float)d;
+        }
+        break;
+    }
+    return OK(cbor_typed_array_to_float_result_t, array->count);
+}
+/*--------------------------------------------------------------------------*/
+cbor_encode_result_t cbor_encode_typed_array(uint8_t tag, const void* elements, size_t count, slice_t target) {
+    if (target.ptr == NULL || (elements == NULL && count > 0)) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_NULL_PTR_ERROR);
+    }
+    const uint8_t element_size = cbor_typed_tag_element_size(tag);
+    if (element_size == 0 || element_size > 8) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT);
+    }
+    if (count > SIZE_MAX / element_size) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_BUFFER_OVERFLOW);
+    }
+    const size_t len = count * element_size;
+
+    uint8_t header[2 + 9] = {0xD8, tag};
+    const size_t header_size = 2 + cbor_write_len_header(len, CBOR_MAJOR_TYPE_BYTE_STRING, (slice_t){.len = sizeof(header) - 2, .ptr = header + 2});
+    if (target.len < header_size || target.len - header_size < len) {
+        return ERR(cbor_encode_result_t, CBOR_ENCODER_ERROR_BUFFER_OVERFLOW);
+    }
+
+    memcpy(target.ptr, header, header_size);
+    if (len == 0) {
+        // Nothing to copy, elements may be NULL
+    }
+    else if (cbor_typed_tag_is_native(tag)) {
+        memcpy(target.ptr + header_size, elements, len);
+    }
+    else {
+        cbor_swap_copy(target.ptr + header_size, elements, count, element_size);
+    }
+
+    target.len = header_size + len;
+    return OK(cbor_encode_result_t, target);
+}
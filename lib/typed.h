@@ -0,0 +1,153 @@
+#ifndef CBOR_TYPED_H
+#define CBOR_TYPED_H
+
+#include "cbor.h"
+
+/*--------------------------------------------------------------------------*/
+/* Typed Arrays (RFC 8746) */
+/*--------------------------------------------------------------------------*/
+
+#define CBOR_TAG_TYPED_ARRAY_FIRST 64
+#define CBOR_TAG_TYPED_ARRAY_LAST  87
+
+// Tag number bits 0b010fsell, the element size is given by ll
+#define CBOR_TYPED_TAG_FLOAT         0x10
+#define CBOR_TYPED_TAG_SIGNED        0x08
+#define CBOR_TYPED_TAG_LITTLE_ENDIAN 0x04 // Clamped for uint8
+#define CBOR_TYPED_TAG_SIZE          0x03
+
+enum {
+    CBOR_TAG_UINT8 = 64,
+    CBOR_TAG_UINT16_BE,
+    CBOR_TAG_UINT32_BE,
+    CBOR_TAG_UINT64_BE,
+    CBOR_TAG_UINT8_CLAMPED,
+    CBOR_TAG_UINT16_LE,
+    CBOR_TAG_UINT32_LE,
+    CBOR_TAG_UINT64_LE,
+    CBOR_TAG_SINT8,
+    CBOR_TAG_SINT16_BE,
+    CBOR_TAG_SINT32_BE,
+    CBOR_TAG_SINT64_BE,
+    CBOR_TAG_SINT16_LE = 77, // 76 is reserved
+    CBOR_TAG_SINT32_LE,
+    CBOR_TAG_SINT64_LE,
+    CBOR_TAG_FLOAT16_BE,
+    CBOR_TAG_FLOAT32_BE,
+    CBOR_TAG_FLOAT64_BE,
+    CBOR_TAG_FLOAT128_BE,
+    CBOR_TAG_FLOAT16_LE,
+    CBOR_TAG_FLOAT32_LE,
+    CBOR_TAG_FLOAT64_LE,
+    CBOR_TAG_FLOAT128_LE
+};
+
+typedef enum {
+    CBOR_TYPED_UINT,
+    CBOR_TYPED_SINT,
+    CBOR_TYPED_FLOAT
+} cbor_typed_kind_t;
+
+/**
+ * A tagged byte string holding count packed elements. data points into the
+ * parsed buffer, nothing is copied until cbor_typed_array_copy. For an
+ * indefinite length byte string data.ptr is NULL, data.len is the total of
+ * its chunks and chunks points at the first one; the copy functions join
+ * them.
+ */
+typedef struct {
+    slice_t data;
+    size_t count;
+    uint8_t* next;          // First byte after the tagged item
+    uint8_t* chunks;        // First chunk of an indefinite length payload, NULL otherwise
+    uint8_t tag;            // 64 to 87
+    uint8_t kind;           // cbor_typed_kind_t
+    uint8_t element_size;   // 1, 2, 4, 8, or 16 for f128
+    uint8_t little_endian;
+    uint8_t clamped;        // Tag 68, Uint8ClampedArray
+} cbor_typed_array_t;
+
+// Bytes per element for a typed array tag, 0 for any other tag
+static inline uint8_t cbor_typed_tag_element_size(uint64_t tag) {
+    if (tag < CBOR_TAG_TYPED_ARRAY_FIRST || tag > CBOR_TAG_TYPED_ARRAY_LAST || tag == 76) {
+        return 0;
+    }
+    const uint8_t ll = tag & CBOR_TYPED_TAG_SIZE;
+    return (uint8_t)((tag & CBOR_TYPED_TAG_FLOAT) ? 2 << ll : 1 << ll);
+}
+
+// True if elements of this tag are stored in host byte order
+static inline int cbor_typed_tag_is_native(uint8_t tag) {
+    return cbor_typed_tag_element_size(tag) == 1 ||
+        ((tag & CBOR_TYPED_TAG_LITTLE_ENDIAN) != 0) == (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__);
+}
+
+DEFINE_RESULT_TYPE(cbor_typed_array_t, cbor_parser_error_t);
+
+/**
+ * Parses a typed array tag and its byte string. Returns TYPE_MISMATCH_ERROR
+ * if buf does not start with a typed array tag or the tag content is not a
+ * byte string and MALFORMED_INPUT_ERROR if the length is not a multiple of
+ * the element size. Indefinite length byte strings are accepted with the
+ * same checks as cbor_skip, their elements may span chunks.
+ */
+FN_RESULT(cbor_typed_array_t, cbor_parser_error_t,
+cbor_typed_array_parse, slice_t buf);
+
+static inline int cbor_typed_array_is_native(const cbor_typed_array_t* array) {
+    return cbor_typed_tag_is_native(array->tag);
+}
+
+/**
+ * The payload as a native array without copying, NULL if it is stored in
+ * the other byte order, not aligned for its element type or in chunks.
+ */
+static inline const void* cbor_typed_array_view(const cbor_typed_array_t* array) {
+    if (array->chunks != NULL || !cbor_typed_array_is_native(array) || (uintptr_t)array->data.ptr % array->element_size != 0) {
+        return NULL;
+    }
+    return array->data.ptr;
+}
+
+/**
+ * Copies the elements into out in host byte order, swapping bytes if
+ * needed. out holds capacity elements of element_size bytes: uint8_t to
+ * uint64_t, int8_t to int64_t, uint16_t bit patterns for f16, float or
+ * double. Returns the number of elements, CAPACITY_ERROR if they do not
+ * fit and TYPE_MISMATCH_ERROR for f128.
+ */
+FN_RESULT(size_t, cbor_parser_error_t,
+cbor_typed_array_copy, const cbor_typed_array_t* array, void* out, size_t capacity);
+
+/**
+ * Converts an f16, f32 or f64 array to float, f64 elements are rounded.
+ * Returns the number of elements, CAPACITY_ERROR if they do not fit and
+ * TYPE_MISMATCH_ERROR for integer arrays and f128.
+ */
+FN_RESULT(size_t, cbor_parser_error_t,
+cbor_typed_array_to_float, const cbor_typed_array_t* array, float* out, size_t capacity);
+
+/*--------------------------------------------------------------------------*/
+/* Typed Array Encoding */
+/*--------------------------------------------------------------------------*/
+
+/**
+ * Value for cbor_encode that writes count native elements (int16_t for
+ * CBOR_TAG_SINT16_LE and so on, uint16_t bit patterns for f16) as a typed
+ * array, e.g. CBOR_TYPED_ARRAY(CBOR_TAG_SINT16_LE, samples, 1024).
+ */
+#define CBOR_TYPED_ARRAY(tag_number, elements, element_count) \
+    ((cbor_value_t) { \
+        .type = CBOR_ENCODE_TYPE_TYPED_ARRAY, \
+        .value.typed_array = {.ptr = (elements), .count = (element_count), .tag = (tag_number)} \
+    })
+
+/**
+ * Writes the tag, a byte string header and the elements, copied unchanged
+ * if the tag byte order is the host one and byte swapped otherwise.
+ * Returns CBOR_ENCODER_ERROR_CUSTOM_INVALID_ARGUMENT for tags that are not
+ * typed arrays and for f128.
+ */
+cbor_encode_result_t cbor_encode_typed_array(uint8_t tag, const void* elements, size_t count, slice_t target);
+
+#endif /* CBOR_TYPED_H */
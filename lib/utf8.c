@@ -0,0 +1,288 @@
+#include "utf8.h"
+#include <string.h>
+
+#if !defined(TARGET_EMBEDDED) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define CBOR_UTF8_SSSE3
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define CBOR_UTF8_NEON
+#include <arm_neon.h>
+#endif
+
+// Strings shorter than one vector are not worth the setup
+#define CBOR_UTF8_SIMD_MIN 16
+
+/*--------------------------------------------------------------------------*/
+int cbor_utf8_validate_scalar(const uint8_t* data, size_t len) {
+    size_t i = 0;
+    while (i < len) {
+        // ASCII runs are checked a word at a time
+        if (len - i >= 8) {
+            uint64_t word;
+            memcpy(&word, data + i, sizeof(word));
+            if ((word & 0x8080808080808080ULL) == 0) {
+                i += 8;
+                continue;
+            }
+        }
+
+        uint8_t lead = data[i];
+        if (lead < 0x80) {
+            i++;
+            continue;
+        }
+
+        size_t continuations;
+        uint8_t min = 0x80, max = 0xBF;  // Allowed range of the first continuation byte
+        if (lead < 0xC2) {
+            return 0;  // Stray continuation or overlong two byte form
+        }
+        else if (lead < 0xE0) {
+            continuations = 1;
+        }
+        else if (lead < 0xF0) {
+            continuations = 2;
+            if (lead == 0xE0) min = 0xA0;       // Overlong
+            else if (lead == 0xED) max = 0x9F;  // Surrogates
+        }
+        else if (lead < 0xF5) {
+            continuations = 3;
+            if (lead == 0xF0) min = 0x90;       // Overlong
+            else if (lead == 0xF4) max = 0x8F;  // Above U+10FFFF
+        }
+        else {
+            return 0;
+        }
+
+        if (len - i <= continuations) {
+            return 0;
+        }
+        if (data[i + 1] < min || data[i + 1] > max) {
+            return 0;
+        }
+        for (size_t k = 2; k <= continuations; k++) {
+            if ((data[i + k] & 0xC0) != 0x80) {
+                return 0;
+            }
+        }
+        i += continuations + 1;
+    }
+    return 1;
+}
+
+/*
+ * Vectorized validation after Keiser and Lemire, "Validating UTF-8 In Less
+ * Than One Instruction Per Byte". Three 16 entry tables, indexed by the high
+ * and low nibble of the previous byte and the high nibble of the current one,
+ * each give the set of errors that nibble allows. A byte pair is malformed
+ * when all three agree. Three and four byte sequences are then checked by
+ * requiring continuations exactly where the leads two and three bytes back
+ * ask for them.
+ */
+#define UTF8_TOO_SHORT      (1 << 0)  // Lead byte not followed by a continuation
+#define UTF8_TOO_LONG       (1 << 1)  // Continuation after an ASCII byte
+#define UTF8_OVERLONG_3     (1 << 2)
+#define UTF8_TOO_LARGE      (1 << 3)
+#define UTF8_SURROGATE      (1 << 4)
+#define UTF8_OVERLONG_2     (1 << 5)
+#define UTF8_TOO_LARGE_1000 (1 << 6)
+#define UTF8_OVERLONG_4     (1 << 6)
+#define UTF8_TWO_CONTS      (1 << 7)  // Continuation after a continuation
+#define UTF8_CARRY          (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+#if defined(CBOR_UTF8_SSSE3) || defined(CBOR_UTF8_NEON)
+static const uint8_t utf8_byte_1_high[16] = {
+    // 0_______ ASCII
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    // 10______ continuation
+    UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+    // 1100____ two byte lead
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+    // 1101____ two byte lead
+    UTF8_TOO_SHORT,
+    // 1110____ three byte lead
+    UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+    // 1111____ four byte lead
+    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+};
+
+static const uint8_t utf8_byte_1_low[16] = {
+    UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,  // ____0000
+    UTF8_CARRY | UTF8_OVERLONG_2,                                      // ____0001
+    UTF8_CARRY,
+    UTF8_CARRY,
+    UTF8_CARRY | UTF8_TOO_LARGE,                                       // ____0100
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE, // ____1101
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+};
+
+static const uint8_t utf8_byte_2_high[16] = {
+    // ________ 0_______ ASCII
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    // ________ 1000____
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+    // ________ 1001____
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+    // ________ 101_____
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    // ________ 11______ lead
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+};
+
+// Bytes above these, in the last three positions, start a sequence that continues in the next block
+static const uint8_t utf8_incomplete_max[16] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+#endif
+
+#ifdef CBOR_UTF8_SSSE3
+/*--------------------------------------------------------------------------*/
+__attribute__((target("ssse3")))
+static int cbor_utf8_validate_ssse3(const uint8_t* data, size_t len) {
+    const __m128i byte_1_high = _mm_loadu_si128((const __m128i*)utf8_byte_1_high);
+    const __m128i byte_1_low = _mm_loadu_si128((const __m128i*)utf8_byte_1_low);
+    const __m128i byte_2_high = _mm_loadu_si128((const __m128i*)utf8_byte_2_high);
+    const __m128i incomplete_max = _mm_loadu_si128((const __m128i*)utf8_incomplete_max);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    __m128i error = _mm_setzero_si128();
+    __m128i prev_input = _mm_setzero_si128();
+    __m128i prev_incomplete = _mm_setzero_si128();
+
+    size_t i = 0;
+    uint8_t tail[16];
+    for (;;) {
+        __m128i input;
+        int last = len - i < 16;
+        if (last) {
+            // Zero padding is ASCII, so a truncated sequence shows up as TOO_SHORT
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, data + i, len - i);
+            input = _mm_loadu_si128((const __m128i*)tail);
+        }
+        else {
+            input = _mm_loadu_si128((const __m128i*)(data + i));
+        }
+
+        if (_mm_movemask_epi8(input) == 0) {
+            error = _mm_or_si128(error, prev_incomplete);
+            prev_incomplete = _mm_setzero_si128();
+        }
+        else {
+            __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+            __m128i special_cases = _mm_and_si128(
+                _mm_and_si128(
+                    _mm_shuffle_epi8(byte_1_high, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+                    _mm_shuffle_epi8(byte_1_low, _mm_and_si128(prev1, nibble))),
+                _mm_shuffle_epi8(byte_2_high, _mm_and_si128(_mm_srli_epi16(input, 4), nibble)));
+
+            __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+            __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+            __m128i is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80)));
+            __m128i is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80)));
+            __m128i must_be_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8((char)0x80));
+
+            error = _mm_or_si128(error, _mm_xor_si128(must_be_continuation, special_cases));
+            prev_incomplete = _mm_subs_epu8(input, incomplete_max);
+        }
+        prev_input = input;
+
+        if (last) {
+            break;
+        }
+        i += 16;
+    }
+
+    error = _mm_or_si128(error, prev_incomplete);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) == 0xFFFF;
+}
+#endif
+
+#ifdef CBOR_UTF8_NEON
+/*--------------------------------------------------------------------------*/
+static int cbor_utf8_validate_neon(const uint8_t* data, size_t len) {
+    const uint8x16_t byte_1_high = vld1q_u8(utf8_byte_1_high);
+    const uint8x16_t byte_1_low = vld1q_u8(utf8_byte_1_low);
+    const uint8x16_t byte_2_high = vld1q_u8(utf8_byte_2_high);
+    const uint8x16_t incomplete_max = vld1q_u8(utf8_incomplete_max);
+    const uint8x16_t nibble = vdupq_n_u8(0x0F);
+
+    uint8x16_t error = vdupq_n_u8(0);
+    uint8x16_t prev_input = vdupq_n_u8(0);
+    uint8x16_t prev_incomplete = vdupq_n_u8(0);
+
+    size_t i = 0;
+    uint8_t tail[16];
+    for (;;) {
+        uint8x16_t input;
+        int last = len - i < 16;
+        if (last) {
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, data + i, len - i);
+            input = vld1q_u8(tail);
+        }
+        else {
+            input = vld1q_u8(data + i);
+        }
+
+        if (vmaxvq_u8(input) < 0x80) {
+            error = vorrq_u8(error, prev_incomplete);
+            prev_incomplete = vdupq_n_u8(0);
+        }
+        else {
+            uint8x16_t prev1 = vextq_u8(prev_input, input, 15);
+            uint8x16_t special_cases = vandq_u8(
+                vandq_u8(
+                    vqtbl1q_u8(byte_1_high, vshrq_n_u8(prev1, 4)),
+                    vqtbl1q_u8(byte_1_low, vandq_u8(prev1, nibble))),
+                vqtbl1q_u8(byte_2_high, vshrq_n_u8(input, 4)));
+
+            uint8x16_t prev2 = vextq_u8(prev_input, input, 14);
+            uint8x16_t prev3 = vextq_u8(prev_input, input, 13);
+            uint8x16_t is_third_byte = vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80));
+            uint8x16_t is_fourth_byte = vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80));
+            uint8x16_t must_be_continuation = vandq_u8(vorrq_u8(is_third_byte, is_fourth_byte), vdupq_n_u8(0x80));
+
+            error = vorrq_u8(error, veorq_u8(must_be_continuation, special_cases));
+            prev_incomplete = vqsubq_u8(input, incomplete_max);
+        }
+        prev_input = input;
+
+        if (last) {
+            break;
+        }
+        i += 16;
+    }
+
+    error = vorrq_u8(error, prev_incomplete);
+    return vmaxvq_u8(error) == 0;
+}
+#endif
+
+/*--------------------------------------------------------------------------*/
+int cbor_utf8_validate(const uint8_t* data, size_t len) {
+    if (len < CBOR_UTF8_SIMD_MIN) {
+        return cbor_utf8_validate_scalar(data, len);
+    }
+#if defined(CBOR_UTF8_SSSE3)
+    if (__builtin_cpu_supports("ssse3")) {
+        return cbor_utf8_validate_ssse3(data, len);
+    }
+#elif defined(CBOR_UTF8_NEON)
+    return cbor_utf8_validate_neon(data, len);
+#endif
+    return cbor_utf8_validate_scalar(data, len);
+}
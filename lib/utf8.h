@@ -0,0 +1,21 @@
+#ifndef CBOR_UTF8_H
+#define CBOR_UTF8_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*--------------------------------------------------------------------------*/
+/* UTF-8 Validation */
+/*--------------------------------------------------------------------------*/
+
+/**
+ * Returns 1 if data is well formed UTF-8 (RFC 3629: no overlong forms,
+ * no surrogates, nothing above U+10FFFF), 0 otherwise.
+ * Uses a vectorized validator where the CPU has one, the scalar one otherwise.
+ */
+int cbor_utf8_validate(const uint8_t* data, size_t len);
+
+/* Portable byte at a time validator, used for short strings and on targets without SIMD */
+int cbor_utf8_validate_scalar(const uint8_t* data, size_t len);
+
+#endif /* CBOR_UTF8_H */
@@ -116,6 +116,18 @@ run_native_tests() {
         "test-encode" 
         "test-indefinite"
         "test-stress"
+        "test-tape"
+        "test-utf8"
+        "test-utf8-strict"
+        "test-reader"
+        "test-stream"
+        "test-path"
+        "test-struct"
+        "test-seq"
+        "test-parallel"
+        "test-half"
+        "test-typed"
+        "test-tags"
         "identify-parse"
         "identify-encode"
     )
@@ -164,6 +176,17 @@ run_embedded_tests() {
         "test-parse.elf"
         "test-encode.elf"
         "test-indefinite.elf"
+        "test-tape.elf"
+        "test-utf8.elf"
+        "test-utf8-strict.elf"
+        "test-reader.elf"
+        "test-stream.elf"
+        "test-path.elf"
+        "test-struct.elf"
+        "test-seq.elf"
+        "test-half.elf"
+        "test-typed.elf"
+        "test-tags.elf"
         "identify-parse.elf"
         "identify-encode.elf"
     )